@@ -45,7 +45,8 @@
     m(int64_type, int64_t) \
     m(uint32_type, uint32_t) \
     m(uint64_type, uint64_t) \
-    m(fp8e4m3fnuz_type, migraphx::fp8::fp8e4m3fnuz)
+    m(fp8e4m3fnuz_type, migraphx::fp8::fp8e4m3fnuz) \
+    m(bf16_type, migraphx::bf16)
 // clang-format on
 
 #ifdef __cplusplus
@@ -71,6 +72,32 @@ typedef enum
 } migraphx_shape_datatype_t;
 #undef MIGRAPHX_SHAPE_GENERATE_ENUM_TYPES
 
+/// Allocate host memory for an argument, the memory does not need to be initialized
+typedef void* (*migraphx_host_allocate)(void* ctx, size_t bytes);
+/// Free host memory returned by migraphx_host_allocate
+typedef void (*migraphx_host_deallocate)(void* ctx, void* ptr, size_t bytes);
+
+typedef struct
+{
+    size_t allocations;
+    size_t reused;
+    size_t system_allocations;
+    size_t bytes_in_use;
+    size_t peak_bytes_in_use;
+    size_t bytes_cached;
+} migraphx_host_allocation_stats;
+
+/// Set the allocator used for host argument buffers, passing null functions restores the default
+MIGRAPHX_C_EXPORT migraphx_status migraphx_set_host_allocator(void* ctx,
+                                                              migraphx_host_allocate allocate,
+                                                              migraphx_host_deallocate deallocate);
+
+MIGRAPHX_C_EXPORT migraphx_status
+migraphx_get_host_allocation_stats(migraphx_host_allocation_stats* stats);
+
+/// Return the host buffers cached by the default allocator to the system
+MIGRAPHX_C_EXPORT migraphx_status migraphx_release_host_buffers(void);
+
 typedef struct migraphx_optimals* migraphx_optimals_t;
 typedef const struct migraphx_optimals* const_migraphx_optimals_t;
 
@@ -557,6 +584,14 @@ MIGRAPHX_C_EXPORT migraphx_status migraphx_parse_onnx_buffer(migraphx_program_t*
                                                              size_t size,
                                                              migraphx_onnx_options_t options);
 
+MIGRAPHX_C_EXPORT migraphx_status migraphx_compile_onnx(migraphx_program_t* out,
+                                                        const char* name,
+                                                        migraphx_target_t target,
+                                                        migraphx_compile_options_t coptions,
+                                                        migraphx_onnx_options_t options,
+                                                        const char* cache_dir,
+                                                        size_t cache_max_size);
+
 MIGRAPHX_C_EXPORT migraphx_status migraphx_tf_options_destroy(migraphx_tf_options_t tf_options);
 
 MIGRAPHX_C_EXPORT migraphx_status migraphx_tf_options_assign_to(migraphx_tf_options_t output,
@@ -1381,6 +1381,42 @@ inline program parse_onnx_buffer(const std::string& buffer)
         own{});
 }
 
+/// Parse and compile an onnx file, or load the program compiled earlier from the cache at
+/// MIGRAPHX_PROGRAM_CACHE_DIR
+inline program compile_onnx(const char* filename,
+                            const target& t,
+                            const compile_options& coptions = compile_options{},
+                            const onnx_options& options = onnx_options{})
+{
+    return program(make<migraphx_program>(&migraphx_compile_onnx,
+                                          filename,
+                                          t.get_handle_ptr(),
+                                          coptions.get_handle_ptr(),
+                                          options.get_handle_ptr(),
+                                          nullptr,
+                                          0),
+                   own{});
+}
+
+/// Parse and compile an onnx file, or load the program compiled earlier from the cache in
+/// cache_dir, which is kept under cache_max_size bytes when it is not 0
+inline program compile_onnx(const char* filename,
+                            const target& t,
+                            const compile_options& coptions,
+                            const onnx_options& options,
+                            const char* cache_dir,
+                            size_t cache_max_size = 0)
+{
+    return program(make<migraphx_program>(&migraphx_compile_onnx,
+                                          filename,
+                                          t.get_handle_ptr(),
+                                          coptions.get_handle_ptr(),
+                                          options.get_handle_ptr(),
+                                          cache_dir,
+                                          cache_max_size),
+                   own{});
+}
+
 /// Options for parsing tf options
 struct tf_options : MIGRAPHX_HANDLE_BASE(tf_options)
 {
@@ -1491,6 +1527,32 @@ quantize_int8(const program& prog, const target& ptarget, const quantize_int8_op
          options.get_handle_ptr());
 }
 
+/// Statistics for the host buffers allocated for arguments
+using host_allocation_stats = migraphx_host_allocation_stats;
+
+/// Set the allocator used for host argument buffers, `ctx` is passed to both functions
+inline void
+set_host_allocator(void* ctx, migraphx_host_allocate allocate, migraphx_host_deallocate deallocate)
+{
+    call(&migraphx_set_host_allocator, ctx, allocate, deallocate);
+}
+
+/// Restore the default pooling host allocator
+inline void reset_host_allocator()
+{
+    call(&migraphx_set_host_allocator, nullptr, nullptr, nullptr);
+}
+
+inline host_allocation_stats get_host_allocation_stats()
+{
+    host_allocation_stats stats{};
+    call(&migraphx_get_host_allocation_stats, &stats);
+    return stats;
+}
+
+/// Return the host buffers cached by the default allocator to the system
+inline void release_host_buffers() { call(&migraphx_release_host_buffers); }
+
 struct experimental_custom_op_base
 {
     experimental_custom_op_base()                                   = default;
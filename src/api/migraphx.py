@@ -391,6 +391,16 @@ api.add_function('migraphx_parse_onnx_buffer',
                  fname='migraphx::parse_onnx_buffer',
                  returns='migraphx::program')
 
+api.add_function('migraphx_compile_onnx',
+                 api.params(name='const char*',
+                            target='migraphx::target',
+                            coptions='migraphx::compile_options',
+                            options='migraphx::onnx_options',
+                            cache_dir='const char*',
+                            cache_max_size='size_t'),
+                 fname='migraphx::compile_onnx_wrap',
+                 returns='migraphx::program')
+
 
 @auto_handle()
 def tf_options(h):
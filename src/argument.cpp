@@ -23,6 +23,8 @@
  */
 #include <migraphx/argument.hpp>
 #include <migraphx/functional.hpp>
+#include <migraphx/host_allocator.hpp>
+#include <cstring>
 #include <unordered_map>
 
 namespace migraphx {
@@ -30,25 +32,24 @@ inline namespace MIGRAPHX_INLINE_NS {
 
 argument::argument(const shape& s) : m_shape(s)
 {
-    auto buffer = make_shared_array<char>(s.bytes());
-    assign_buffer({[=]() mutable { return buffer.get(); }});
+    // Pooled buffers are not cleared by the allocator, but this constructor returns zeros
+    auto buffer = allocate_host_buffer(s.bytes());
+    auto* p     = buffer.get();
+    std::memset(p, 0, s.bytes());
+    assign_buffer(p, std::move(buffer));
 }
 
 argument::argument(shape s, std::nullptr_t)
-    : m_shape(std::move(s)), m_data({[] { return nullptr; }})
+    : m_shape(std::move(s)), m_data({nullptr, nullptr, [] { return nullptr; }})
 {
 }
 
 argument::argument(const shape& s, const argument::data_t& d) : m_shape(s), m_data(d) {}
 
-void argument::assign_buffer(std::function<char*()> d)
+// The elements of a tuple are stored in one buffer sorted by type size
+argument::data_t
+argument::make_tuple_data(const shape& s, const std::function<data_t(std::size_t)>& make_element)
 {
-    const shape& s = m_shape;
-    if(s.type() != shape::tuple_type)
-    {
-        m_data = {std::move(d)};
-        return;
-    }
     // Collect all shapes
     std::unordered_map<std::size_t, shape> shapes;
     {
@@ -83,25 +84,54 @@ void argument::assign_buffer(std::function<char*()> d)
     assert(offset == s.bytes());
 
     std::size_t i = 0;
-    m_data        = fix<data_t>([&](auto self, auto ss) {
-        data_t result;
+    return fix<data_t>([&](auto self, auto ss) {
         if(ss.sub_shapes().empty())
         {
-            auto n = offsets[i];
-            result = {[d, n]() mutable { return d() + n; }};
+            auto result = make_element(offsets[i]);
             i++;
             return result;
         }
-        std::vector<data_t> subs;
+        data_t result;
         std::transform(ss.sub_shapes().begin(),
                        ss.sub_shapes().end(),
-                       std::back_inserter(subs),
+                       std::back_inserter(result.sub),
                        [&](auto child) { return self(child); });
-        result.sub = subs;
         return result;
     })(s);
 }
 
+void argument::assign_buffer(char* p, std::shared_ptr<void> owner)
+{
+    if(m_shape.type() != shape::tuple_type)
+    {
+        m_data.ptr     = p;
+        m_data.owner   = std::move(owner);
+        m_data.has_ptr = true;
+        return;
+    }
+    m_data = make_tuple_data(m_shape, [&](std::size_t n) {
+        data_t result;
+        result.ptr     = p + n;
+        result.owner   = owner;
+        result.has_ptr = true;
+        return result;
+    });
+}
+
+void argument::assign_buffer(std::function<char*()> d)
+{
+    if(m_shape.type() != shape::tuple_type)
+    {
+        m_data = {nullptr, nullptr, std::move(d)};
+        return;
+    }
+    m_data = make_tuple_data(m_shape, [&](std::size_t n) {
+        data_t result;
+        result.get = [d, n]() mutable { return d() + n; };
+        return result;
+    });
+}
+
 std::vector<shape> to_shapes(const std::vector<argument>& args)
 {
     std::vector<shape> shapes;
@@ -116,15 +146,11 @@ argument::argument(const std::vector<argument>& args)
 {
 }
 
-char* argument::data() const
+bool argument::empty() const
 {
-    assert(m_shape.type() != shape::tuple_type);
-    assert(not this->empty());
-    return m_data.get();
+    return not m_data.has_ptr and not m_data.get and m_data.sub.empty();
 }
 
-bool argument::empty() const { return not m_data.get and m_data.sub.empty(); }
-
 const shape& argument::get_shape() const { return this->m_shape; }
 
 argument argument::reshape(const shape& s) const
@@ -135,6 +161,9 @@ argument argument::reshape(const shape& s) const
 
 argument::data_t argument::data_t::share() const
 {
+    // A pointer is already shared by copies
+    if(this->has_ptr)
+        return *this;
     data_t result;
     if(this->get)
     {
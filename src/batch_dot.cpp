@@ -0,0 +1,136 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/batch_dot.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/stringutils.hpp>
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+static bool is_batchable(instruction_ref ins)
+{
+    if(ins->name() != "dot" or ins->inputs().size() != 2)
+        return false;
+    return none_of(ins->inputs(), [](auto input) {
+        const auto& s = input->get_shape();
+        return s.dynamic() or s.lens().size() < 2;
+    });
+}
+
+static std::string batch_key(instruction_ref ins)
+{
+    // The strides are part of the key so that one GEMM kernel can run every group
+    std::string key;
+    for(auto input : ins->inputs())
+        key += to_string(input->get_shape()) + ";";
+    return key;
+}
+
+// Run the dots as one grouped dot, which reads each input where it is, and slice the results
+// back out
+static void replace_with_grouped_dot(module& m, const std::vector<instruction_ref>& dots)
+{
+    std::vector<instruction_ref> inputs;
+    std::transform(dots.begin(), dots.end(), std::back_inserter(inputs), [](auto dot) {
+        return dot->inputs()[0];
+    });
+    std::transform(dots.begin(), dots.end(), std::back_inserter(inputs), [](auto dot) {
+        return dot->inputs()[1];
+    });
+    auto pos     = dots.front();
+    auto grouped = m.insert_instruction(pos, make_op("grouped_dot"), inputs);
+    for(std::size_t i = 0; i < dots.size(); i++)
+    {
+        auto slice = m.insert_instruction(
+            pos,
+            make_op("slice", {{"axes", {0}}, {"starts", {i}}, {"ends", {i + 1}}}),
+            grouped);
+        auto result = m.insert_instruction(pos, make_op("squeeze", {{"axes", {0}}}), slice);
+        m.replace_instruction(dots[i], result);
+    }
+}
+
+// The grouped dot needs the inputs of all of the dots, so the dots, and whatever uses them before
+// the last of those inputs, are moved after it. None of them can be an input to one of the dots
+// since the dots are at the same dependency level.
+static void move_after_inputs(module& m, const std::vector<instruction_ref>& dots)
+{
+    std::unordered_set<instruction_ref> inputs;
+    for(auto dot : dots)
+        inputs.insert(dot->inputs().begin(), dot->inputs().end());
+    std::unordered_set<instruction_ref> users;
+    std::vector<instruction_ref> to_move;
+    bool started = false;
+    auto it      = m.begin();
+    for(; it != m.end() and not inputs.empty(); ++it)
+    {
+        inputs.erase(it);
+        started = started or it == dots.front();
+        if(not started)
+            continue;
+        if(contains(dots, it) or
+           any_of(it->inputs(), [&](auto input) { return contains(users, input); }))
+        {
+            users.insert(it);
+            to_move.push_back(it);
+        }
+    }
+    for(auto ins : to_move)
+        m.move_instruction(ins, it);
+}
+
+void batch_dot::apply(module& m) const
+{
+    // Dots at the same dependency level can't depend on each other
+    std::unordered_map<instruction_ref, std::size_t> levels;
+    std::map<std::pair<std::size_t, std::string>, std::vector<instruction_ref>> groups;
+    for(auto ins : iterator_for(m))
+    {
+        std::size_t level = 0;
+        for(auto input : ins->inputs())
+            level = std::max(level, levels[input] + 1);
+        levels[ins] = level;
+        if(is_batchable(ins))
+            groups[{level, batch_key(ins)}].push_back(ins);
+    }
+    for(const auto& [key, dots] : groups)
+    {
+        if(dots.size() < 2)
+            continue;
+        move_after_inputs(m, dots);
+        replace_with_grouped_dot(m, dots);
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
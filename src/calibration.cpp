@@ -0,0 +1,265 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/calibration.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/file_buffer.hpp>
+#include <migraphx/float_equal.hpp>
+#include <migraphx/json.hpp>
+#include <migraphx/value.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+std::string to_string(calibration_method method)
+{
+    switch(method)
+    {
+    case calibration_method::max_abs: return "max_abs";
+    case calibration_method::moving_average: return "moving_average";
+    case calibration_method::percentile: return "percentile";
+    case calibration_method::entropy: return "entropy";
+    }
+    MIGRAPHX_THROW("Unknown calibration method");
+}
+
+calibration_method to_calibration_method(const std::string& name)
+{
+    for(auto method : {calibration_method::max_abs,
+                       calibration_method::moving_average,
+                       calibration_method::percentile,
+                       calibration_method::entropy})
+    {
+        if(to_string(method) == name)
+            return method;
+    }
+    MIGRAPHX_THROW("Unknown calibration method: " + name);
+}
+
+std::ostream& operator<<(std::ostream& os, calibration_method method)
+{
+    return os << to_string(method);
+}
+
+static bool uses_histogram(calibration_method method)
+{
+    return method == calibration_method::percentile or method == calibration_method::entropy;
+}
+
+calibration_observer::calibration_observer(const calibration_options& options) : opts(options)
+{
+}
+
+void calibration_observer::observe(const argument& arg)
+{
+    if(arg.empty())
+        return;
+    arg.visit([&](auto data) {
+        if(data.empty())
+            return;
+        float batch_min = std::numeric_limits<float>::max();
+        float batch_max = std::numeric_limits<float>::lowest();
+        for(auto x : data)
+        {
+            auto v    = static_cast<float>(x);
+            batch_min = std::min(batch_min, v);
+            batch_max = std::max(batch_max, v);
+        }
+        auto batch_abs = std::max(std::fabs(batch_min), std::fabs(batch_max));
+        max_abs_val    = std::max(max_abs_val, batch_abs);
+        if(initialized)
+        {
+            avg_min += opts.averaging_constant * (batch_min - avg_min);
+            avg_max += opts.averaging_constant * (batch_max - avg_max);
+        }
+        else
+        {
+            avg_min = batch_min;
+            avg_max = batch_max;
+        }
+        initialized = true;
+
+        if(not uses_histogram(opts.method))
+            return;
+        grow_histogram(batch_abs);
+        // Until a non-zero value is seen there is no range yet, but all the
+        // values are zero and belong in the first bin whatever the range is
+        if(float_equal(hist_range, 0.0f))
+        {
+            hist.front() += data.size();
+            return;
+        }
+        auto width = hist_range / hist.size();
+        for(auto x : data)
+        {
+            auto bin = static_cast<std::size_t>(std::fabs(static_cast<float>(x)) / width);
+            hist[std::min(bin, hist.size() - 1)] += 1;
+        }
+    });
+}
+
+// The histogram covers [0, hist_range]. The range is seeded by the first batch
+// with a non-zero value. When a batch goes past the range, the range is
+// doubled and adjacent bins are merged so earlier batches are kept.
+void calibration_observer::grow_histogram(float batch_max)
+{
+    if(hist.empty())
+        hist.resize(std::max<std::size_t>(2, opts.bins + opts.bins % 2));
+    if(batch_max <= hist_range)
+        return;
+    if(float_equal(hist_range, 0.0f))
+    {
+        hist_range = batch_max;
+        return;
+    }
+    auto half = hist.size() / 2;
+    while(hist_range < batch_max)
+    {
+        for(std::size_t i = 0; i < half; i++)
+            hist[i] = hist[2 * i] + hist[2 * i + 1];
+        std::fill(hist.begin() + half, hist.end(), 0.0);
+        hist_range *= 2;
+    }
+}
+
+float calibration_observer::percentile_threshold() const
+{
+    auto total = std::accumulate(hist.begin(), hist.end(), 0.0);
+    if(total <= 0.0)
+        return max_abs_val;
+    auto width        = hist_range / hist.size();
+    auto target       = total * std::min(opts.percentile, 100.0f) / 100.0;
+    double cumulative = 0.0;
+    for(std::size_t i = 0; i < hist.size(); i++)
+    {
+        cumulative += hist[i];
+        if(cumulative >= target)
+            return std::min(max_abs_val, static_cast<float>((i + 1) * width));
+    }
+    return max_abs_val;
+}
+
+// Pick the clipping threshold that minimizes the KL divergence between the
+// clipped histogram and its quantized version
+float calibration_observer::entropy_threshold(float quantized_range) const
+{
+    auto nbins = hist.size();
+    auto total = std::accumulate(hist.begin(), hist.end(), 0.0);
+    if(total <= 0.0)
+        return max_abs_val;
+    auto levels = std::min<std::size_t>(static_cast<std::size_t>(quantized_range) + 1, nbins);
+
+    std::vector<double> outliers(nbins + 1, 0.0);
+    std::partial_sum(hist.rbegin(), hist.rend(), outliers.rbegin() + 1);
+
+    const double eps = 1e-10;
+    double best_kl   = std::numeric_limits<double>::max();
+    std::size_t best = nbins;
+    std::vector<double> p;
+    std::vector<double> q;
+    for(std::size_t i = levels; i <= nbins; i++)
+    {
+        p.assign(hist.begin(), hist.begin() + i);
+        p.back() += outliers[i];
+        q.assign(i, 0.0);
+        for(std::size_t j = 0; j < levels; j++)
+        {
+            auto start = j * i / levels;
+            auto stop  = (j + 1) * i / levels;
+            auto sum   = std::accumulate(hist.begin() + start, hist.begin() + stop, 0.0);
+            auto nonzero = std::count_if(
+                hist.begin() + start, hist.begin() + stop, [](auto x) { return x > 0; });
+            if(nonzero == 0)
+                continue;
+            for(auto k = start; k < stop; k++)
+            {
+                if(hist[k] > 0)
+                    q[k] = sum / nonzero;
+            }
+        }
+        auto psum = std::accumulate(p.begin(), p.end(), 0.0);
+        auto qsum = std::accumulate(q.begin(), q.end(), 0.0);
+        if(qsum <= 0.0)
+            continue;
+        double kl = 0.0;
+        for(std::size_t k = 0; k < i; k++)
+        {
+            if(p[k] <= 0.0)
+                continue;
+            auto pk = p[k] / psum;
+            auto qk = std::max(q[k] / qsum, eps);
+            kl += pk * std::log(pk / qk);
+        }
+        if(kl < best_kl)
+        {
+            best_kl = kl;
+            best    = i;
+        }
+    }
+    return std::min(max_abs_val, static_cast<float>(best * (hist_range / nbins)));
+}
+
+float calibration_observer::threshold(float quantized_range) const
+{
+    switch(opts.method)
+    {
+    case calibration_method::max_abs: return max_abs_val;
+    case calibration_method::moving_average:
+        return std::max(std::fabs(avg_min), std::fabs(avg_max));
+    case calibration_method::percentile: return percentile_threshold();
+    case calibration_method::entropy: return entropy_threshold(quantized_range);
+    }
+    MIGRAPHX_THROW("Unknown calibration method");
+}
+
+void save_calibration_table(const std::string& filename,
+                            shape::type_t precision,
+                            const std::vector<std::pair<float, float>>& params)
+{
+    value entries = value::array{};
+    for(const auto& param : params)
+        entries.push_back({{"scale", param.first}, {"shift", param.second}});
+    value v = {{"precision", shape{precision}.type_string()}, {"params", entries}};
+    auto s  = to_pretty_json_string(v);
+    write_buffer(filename, s.data(), s.size());
+}
+
+std::vector<std::pair<float, float>> load_calibration_table(const std::string& filename,
+                                                            shape::type_t precision)
+{
+    auto v = from_json_string(read_string(filename));
+    if(v.at("precision").to<std::string>() != shape{precision}.type_string())
+        MIGRAPHX_THROW("Calibration table " + filename + " was computed for " +
+                       v.at("precision").to<std::string>());
+    std::vector<std::pair<float, float>> params;
+    for(const auto& entry : v.at("params"))
+        params.emplace_back(entry.at("scale").to<float>(), entry.at("shift").to<float>());
+    return params;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,148 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/cost_model.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/env.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/stringutils.hpp>
+#include <numeric>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_PEAK_GFLOPS)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_PEAK_GBPS)
+
+// The name and the value of the operator without the target prefix, so dnnl::convolution and
+// gpu::convolution are both modeled as convolution
+static std::pair<std::string, value> get_base_operator(const operation& op)
+{
+    auto name = op.name();
+    auto v    = op.to_value();
+    // The ref target wraps the operator
+    if(name == "ref::op")
+        return {v.at("name").to<std::string>(), v.at("operator")};
+    auto pos = name.rfind("::");
+    if(pos != std::string::npos)
+        name = name.substr(pos + 2);
+    return {name, v};
+}
+
+// Number of instructions that compute something in a fused module
+static std::size_t count_ops(const module& m)
+{
+    return std::count_if(m.begin(), m.end(), [](const instruction& ins) {
+        return not starts_with(ins.name(), "@");
+    });
+}
+
+static double compute_flops(instruction_ref ins,
+                            const std::string& name,
+                            const value& v,
+                            const std::vector<shape>& inputs)
+{
+    double out = ins->get_shape().elements();
+    if(contains({"dot", "quant_dot", "gemm", "quant_gemm"}, name))
+    {
+        // Multiply and add for each element of the reduced dimension
+        return 2.0 * out * inputs.at(0).lens().back();
+    }
+    if(contains({"convolution", "quant_convolution"}, name))
+    {
+        // Each output is a dot product over the input channels of its group and the kernel
+        const auto& w = inputs.at(1);
+        return 2.0 * out * w.elements() / w.lens().front();
+    }
+    if(name == "convolution_backwards")
+    {
+        const auto& w = inputs.at(1);
+        return 2.0 * inputs.at(0).elements() * w.elements() / w.lens().front();
+    }
+    if(name == "pooling" and v.contains("lengths"))
+    {
+        auto lengths = v.at("lengths").to_vector<std::size_t>();
+        return out * std::accumulate(
+                         lengths.begin(), lengths.end(), std::size_t{1}, std::multiplies<>{});
+    }
+    if(starts_with(name, "reduce") or name == "reduction" or contains({"argmax", "argmin"}, name))
+        return inputs.at(0).elements();
+    if(not ins->module_inputs().empty() and contains(name, "pointwise"))
+        return out * count_ops(*ins->module_inputs().front());
+    if(not ins->module_inputs().empty() and contains(name, "reduce"))
+        return inputs.at(0).elements() * count_ops(*ins->module_inputs().front());
+    if(ins->get_operator().attributes().get("pointwise", false) or
+       contains({"eltwise", "binary"}, name))
+        return out;
+    return 0;
+}
+
+op_cost estimate_cost(instruction_ref ins)
+{
+    op_cost result;
+    if(starts_with(ins->name(), "@") or ins->get_shape().dynamic())
+        return result;
+    auto inputs = to_shapes(ins->inputs());
+    auto alias  = ins->get_operator().output_alias(inputs);
+    // Views only change the shape of their input
+    if(alias == 0)
+        return result;
+    auto [name, v] = get_base_operator(ins->get_operator());
+    result.flops   = compute_flops(ins, name, v, inputs);
+    result.bytes   = ins->get_shape().bytes();
+    for(std::size_t i = 0; i < inputs.size(); i++)
+    {
+        // The output buffer is already counted
+        if(alias >= 0 and i == static_cast<std::size_t>(alias))
+            continue;
+        result.bytes += inputs[i].bytes();
+    }
+    return result;
+}
+
+double roofline::ridge_point() const
+{
+    // A typical balance for a modern cpu or gpu when the peaks are not known
+    if(peak_gflops <= 0 or peak_gbps <= 0)
+        return 10;
+    return peak_gflops / peak_gbps;
+}
+
+std::string roofline::classify(const op_cost& cost) const
+{
+    if(cost.arithmetic_intensity() >= ridge_point())
+        return "compute";
+    return "memory";
+}
+
+roofline roofline::host()
+{
+    roofline result;
+    result.peak_gflops = value_of(MIGRAPHX_PEAK_GFLOPS{});
+    result.peak_gbps   = value_of(MIGRAPHX_PEAK_GBPS{});
+    return result;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -47,15 +47,20 @@
 #include <migraphx/eliminate_identity.hpp>
 #include <migraphx/eliminate_pad.hpp>
 #include <migraphx/generate.hpp>
+#include <migraphx/host_allocator.hpp>
+#include <migraphx/numa.hpp>
 #include <migraphx/pass_manager.hpp>
+#include <migraphx/program_cache.hpp>
 #include <migraphx/propagate_constant.hpp>
 #include <migraphx/quantization.hpp>
 #include <migraphx/register_op.hpp>
 #include <migraphx/simplify_algebra.hpp>
 #include <migraphx/simplify_reshapes.hpp>
 #include <migraphx/register_target.hpp>
+#include <migraphx/time.hpp>
 
 #include <fstream>
+#include <thread>
 
 namespace migraphx {
 namespace driver {
@@ -78,6 +83,7 @@ struct loader
     unsigned trim               = 0;
     bool optimize               = false;
     bool skip_unknown_operators = false;
+    bool lazy_initializers      = false;
     bool brief                  = false;
     std::string output_type;
     std::string output;
@@ -111,6 +117,10 @@ struct loader
            {"--skip-unknown-operators"},
            ap.help("Skip unknown operators when parsing and continue to parse."),
            ap.set_value(true));
+        ap(lazy_initializers,
+           {"--lazy-initializers"},
+           ap.help("Defer reading onnx initializers until their data is used."),
+           ap.set_value(true));
         ap(is_nhwc, {"--nchw"}, ap.help("Treat tensorflow format as nchw"), ap.set_value(false));
         ap(trim, {"--trim", "-t"}, ap.help("Trim instructions from the end"));
         ap(param_dims,
@@ -288,6 +298,7 @@ struct loader
             options.default_dyn_dim_value = from_value<migraphx::shape::dynamic_dimension>(v);
         }
         options.skip_unknown_operators = skip_unknown_operators;
+        options.lazy_initializers      = lazy_initializers;
         options.print_program_on_error = true;
         options.map_input_dims         = map_input_dims;
         options.map_dyn_input_dims     = map_dyn_input_dims;
@@ -484,9 +495,16 @@ struct compiler
     program_params parameters;
     compiler_target ct;
     compile_options co;
-    bool to_fp16 = false;
-    bool to_fp8  = false;
-    bool to_int8 = false;
+    bool to_fp16        = false;
+    bool to_bf16        = false;
+    bool to_fp8         = false;
+    bool to_int8        = false;
+    bool profile_passes = false;
+    std::string profile_passes_json;
+    calibration_options calibration;
+    std::string calibration_method = "max_abs";
+    program_cache cache            = program_cache::from_env();
+    std::size_t cache_max_size     = 0;
 
     std::vector<std::string> fill0;
     std::vector<std::string> fill1;
@@ -507,9 +525,48 @@ struct compiler
            {"--exhaustive-tune"},
            ap.help("Exhastively search for best tuning parameters for kernels"),
            ap.set_value(true));
+        ap(co.num_threads,
+           {"--num-threads"},
+           ap.help("Number of threads used to run the program on the cpu"));
+        ap(co.pin_threads,
+           {"--pin-threads"},
+           ap.help("Pin each cpu thread to one core"),
+           ap.set_value(true));
+        ap(co.numa_node,
+           {"--numa-node"},
+           ap.help("Run the program and allocate its buffers on a NUMA node on the cpu"));
         ap(to_fp16, {"--fp16"}, ap.help("Quantize for fp16"), ap.set_value(true));
+        ap(to_bf16, {"--bf16"}, ap.help("Quantize for bf16"), ap.set_value(true));
         ap(to_int8, {"--int8"}, ap.help("Quantize for int8"), ap.set_value(true));
         ap(to_fp8, {"--fp8"}, ap.help("Quantize for fp8e4m3fnuz type"), ap.set_value(true));
+        ap(calibration_method,
+           {"--calibration-method"},
+           ap.help("Calibration method for int8/fp8: max_abs, moving_average, percentile or "
+                   "entropy"));
+        ap(calibration.per_channel,
+           {"--per-channel"},
+           ap.help("Use per-channel scales for int8/fp8 convolution and dot weights"),
+           ap.set_value(true));
+        ap(calibration.save_table,
+           {"--save-calibration"},
+           ap.help("Save the int8/fp8 calibration table to a file"));
+        ap(calibration.load_table,
+           {"--load-calibration"},
+           ap.help("Load the int8/fp8 calibration table from a file instead of calibrating"));
+        ap(profile_passes,
+           {"--profile-passes"},
+           ap.help("Print the time, instruction counts and matcher hits of each compile pass"),
+           ap.set_value(true));
+        ap(profile_passes_json,
+           {"--profile-passes-json"},
+           ap.help("Write the per-pass compile profile to a JSON file"));
+        ap(cache.dir,
+           {"--cache-dir"},
+           ap.help("Load the compiled program from this directory, or compile and store it there"));
+        ap(cache_max_size,
+           {"--cache-max-size"},
+           ap.help("Remove the least recently used programs once the cache grows past this "
+                   "size in MB"));
     }
 
     auto params(const program& p)
@@ -522,8 +579,94 @@ struct compiler
         return parameters.generate(p, ct.get_target(), true, l.batch);
     }
 
+    void quantize(program& p, const target& t)
+    {
+        if(to_fp16)
+        {
+            quantize_fp16(p);
+        }
+        if(to_bf16)
+        {
+            quantize_bf16(p);
+        }
+        calibration.method = to_calibration_method(calibration_method);
+        if(to_int8)
+        {
+            quantize_int8(p, t, {host_params(p)}, {"dot", "convolution"}, calibration);
+        }
+        if(to_fp8)
+        {
+            quantize_fp8(p, t, {host_params(p)}, calibration);
+        }
+    }
+
+    // Programs are cached when they are read from a model, and compiling has no other output
+    bool use_cache() const
+    {
+        if(not cache.enabled() or profile_passes or not profile_passes_json.empty() or
+           not calibration.save_table.empty())
+            return false;
+        if(not l.model.empty())
+            return true;
+        auto file_type = l.file_type.empty() ? loader::get_file_type(l.file) : l.file_type;
+        return contains({"onnx", "tf"}, file_type);
+    }
+
+    // The options that change the program before it is compiled
+    value cache_model() const
+    {
+        value result;
+        auto file_type = l.file_type.empty() ? loader::get_file_type(l.file) : l.file_type;
+        if(l.model.empty() and file_type == "onnx")
+            result["file"] = hash_onnx_file(l.file);
+        else if(l.model.empty())
+            result["file"] = hash_file(l.file);
+        else
+            result["model"] = l.model;
+        result["file_type"]              = l.file_type;
+        result["batch"]                  = l.batch;
+        result["is_nhwc"]                = l.is_nhwc;
+        result["trim"]                   = l.trim;
+        result["optimize"]               = l.optimize;
+        result["skip_unknown_operators"] = l.skip_unknown_operators;
+        result["default_dyn_dim"]        = l.default_dyn_dim;
+        result["param_dims"]             = migraphx::to_value(l.param_dims);
+        result["dim_params"]             = migraphx::to_value(l.dim_params);
+        result["dyn_param_dims"]         = migraphx::to_value(l.dyn_param_dims);
+        result["output_names"]           = migraphx::to_value(l.output_names);
+        result["passes"]                 = migraphx::to_value(l.passes);
+        result["fill0"]                  = migraphx::to_value(parameters.fill0);
+        result["fill1"]                  = migraphx::to_value(parameters.fill1);
+        result["fp16"]                   = to_fp16;
+        result["bf16"]                   = to_bf16;
+        result["int8"]                   = to_int8;
+        result["fp8"]                    = to_fp8;
+        result["calibration_method"]     = calibration_method;
+        result["per_channel"]            = calibration.per_channel;
+        if(not calibration.load_table.empty())
+            result["calibration_table"] = hash_file(calibration.load_table);
+        return result;
+    }
+
     program compile()
     {
+        if(cache_max_size > 0)
+            cache.max_size = cache_max_size * 1024 * 1024;
+        if(use_cache())
+        {
+            auto t = ct.get_target();
+            auto p = cache.compile(
+                cache_model(),
+                [&] {
+                    auto lp = l.load();
+                    quantize(lp, t);
+                    return lp;
+                },
+                t,
+                co);
+            l.save(p);
+            return p;
+        }
         auto p = l.load();
         // Dont compile if its already been compiled
 
@@ -552,19 +695,17 @@ struct compiler
             return p;
         }
         auto t = ct.get_target();
-        if(to_fp16)
-        {
-            quantize_fp16(p);
-        }
-        if(to_int8)
-        {
-            quantize_int8(p, t, {host_params(p)});
-        }
-        if(to_fp8)
+        quantize(p, t);
+        if(profile_passes or not profile_passes_json.empty())
+            co.profiler = pass_profiler::create();
+        p.compile(t, co);
+        if(profile_passes)
+            co.profiler.print(std::cout);
+        if(not profile_passes_json.empty())
         {
-            quantize_fp8(p, t, {host_params(p)});
+            std::ofstream os(profile_passes_json);
+            os << to_pretty_json_string(co.profiler.to_value()) << std::endl;
         }
-        p.compile(t, co);
         l.save(p);
         return p;
     }
@@ -634,6 +775,10 @@ struct verify : command<verify>
         {
             vo.quantize = precision::fp16;
         }
+        if(c.to_bf16)
+        {
+            vo.quantize = precision::bf16;
+        }
         if(c.to_int8)
         {
             vo.quantize = precision::int8;
@@ -690,21 +835,69 @@ struct run_cmd : command<run_cmd>
 struct perf : command<perf>
 {
     compiler c;
-    unsigned n = 100;
+    unsigned n         = 100;
+    unsigned instances = 1;
     void parse(argument_parser& ap)
     {
         c.parse(ap);
         ap(n, {"--iterations", "-n"}, ap.help("Number of iterations to run for perf report"));
+        ap(instances,
+           {"--instances"},
+           ap.help("Run several instances of the program concurrently, each one on its own NUMA "
+                   "node when there is more than one"));
+    }
+
+    void run_instances()
+    {
+        using milliseconds = std::chrono::duration<double, std::milli>;
+        auto nodes         = get_numa_node_count();
+        std::vector<program> programs;
+        std::vector<parameter_map> params;
+        for(unsigned i = 0; i < instances; i++)
+        {
+            std::cout << "Compiling instance " << i << " ... " << std::endl;
+            if(nodes > 1)
+                c.co.numa_node = i % nodes;
+            programs.push_back(c.compile());
+            params.push_back(c.params(programs.back()));
+            // Warm up
+            programs.back().eval(params.back());
+        }
+        std::cout << "Running " << instances << " instances ... " << std::endl;
+        auto total = time<milliseconds>([&] {
+            std::vector<std::thread> threads;
+            for(unsigned i = 0; i < instances; i++)
+            {
+                threads.emplace_back([&, i] {
+                    for(unsigned j = 0; j < n; j++)
+                        programs[i].eval(params[i]);
+                });
+            }
+            for(auto& t : threads)
+                t.join();
+        });
+        auto runs = instances * n;
+        std::cout << "Total time: " << total << "ms" << std::endl;
+        std::cout << "Rate: " << runs * c.l.batch * 1000.0 / total << " inferences/sec"
+                  << std::endl;
+        std::cout << "Average time per instance run: " << total * instances / runs << "ms"
+                  << std::endl;
     }
 
     void run()
     {
+        if(instances > 1)
+            return run_instances();
         std::cout << "Compiling ... " << std::endl;
         auto p = c.compile();
         std::cout << "Allocating params ... " << std::endl;
         auto m = c.params(p);
         std::cout << "Running performance report ... " << std::endl;
         p.perf_report(std::cout, n, m, c.l.batch);
+        auto stats = get_host_allocation_stats();
+        std::cout << "Host allocations: " << stats.allocations << " (" << stats.reused
+                  << " reused), peak host memory: " << stats.peak_bytes_in_use / (1024 * 1024)
+                  << "MB" << std::endl;
     }
 };
 
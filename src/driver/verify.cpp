@@ -40,7 +40,7 @@ inline namespace MIGRAPHX_INLINE_NS {
 /**
  * Gives tolerances based on user input (`rms_tol`, `atol`, `rtol` parameters) and defaults.
  * Sets to fp16 tolerances if `quantize` input is fp16 or any fp16 instruction in found in the
- * model.
+ * model, and to the looser bf16 tolerances for bf16.
  */
 verify::tolerance get_tolerances(const program& p,
                                  verify_options vo,
@@ -58,6 +58,15 @@ verify::tolerance get_tolerances(const program& p,
         result.atol    = 4e-2;
         result.rtol    = 4e-2;
     }
+    bool has_bf16 = any_of(p.get_modules(), [](auto&& m) {
+        return any_of(*m, [](auto&& ins) { return (ins.get_shape().type() == shape::bf16_type); });
+    });
+    if(has_bf16 or vo.quantize == precision::bf16)
+    {
+        result.rms_tol = 1.6e-1;
+        result.atol    = 8e-2;
+        result.rtol    = 8e-2;
+    }
     if(rms_tol)
     {
         result.rms_tol = *rms_tol;
@@ -98,6 +107,10 @@ std::vector<argument> run_target(program p,
     {
         quantize_fp16(p);
     }
+    if(vo.quantize == precision::bf16)
+    {
+        quantize_bf16(p);
+    }
     p.compile(t, options);
 
     parameter_map m;
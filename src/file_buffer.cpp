@@ -24,6 +24,7 @@
 #include <migraphx/file_buffer.hpp>
 #include <migraphx/errors.hpp>
 #include <migraphx/fileutils.hpp>
+#include <migraphx/tmp_dir.hpp>
 #include <fstream>
 #include <iostream>
 
@@ -76,5 +77,35 @@ void write_buffer(const fs::path& filename, const std::vector<char>& buffer)
     write_buffer(filename, buffer.data(), buffer.size());
 }
 
+bool try_write_file(const fs::path& filename, const std::function<void(const fs::path&)>& write)
+{
+    // The temporary name is unique across the threads and processes that share the directory
+    auto tmp = filename;
+    tmp += "." + unique_string("tmp");
+    std::error_code ec;
+    try
+    {
+        write(tmp);
+        fs::rename(tmp, filename);
+        return true;
+    }
+    catch(const std::exception&)
+    {
+        fs::remove(tmp, ec);
+        return false;
+    }
+}
+
+bool try_write_buffer(const fs::path& filename, const char* buffer, std::size_t size)
+{
+    return try_write_file(filename, [&](const fs::path& tmp) {
+        std::ofstream os(tmp, std::ios::out | std::ios::binary);
+        os.write(buffer, size);
+        os.close();
+        if(not os)
+            MIGRAPHX_THROW("Error writing file: " + tmp.string());
+    });
+}
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
@@ -32,6 +32,7 @@
 #include <migraphx/check_shapes.hpp>
 #include <migraphx/matcher.hpp>
 #include <migraphx/register_op.hpp>
+#include <migraphx/par_for.hpp>
 #include <iterator>
 #include <map>
 
@@ -78,6 +79,145 @@ struct fused_reduce
             sm->get_output_shapes().front().type(), lens, find_permutation(inputs));
     }
 
+    // Set the dimensions that are not reduced to 1, which gives the lens of one reduction row
+    std::vector<std::size_t> row_lens(std::vector<std::size_t> lens) const
+    {
+        for(std::size_t i = 0; i < lens.size(); i++)
+        {
+            if(not contains(axes, std::int64_t(i)))
+                lens[i] = 1;
+        }
+        return lens;
+    }
+
+    // The submodule can be evaluated one row at a time when every input has the output's
+    // dimensions outside of the reduction axes and the only op that depends on the lens is
+    // multibroadcast
+    bool is_rowwise(const module& sm, const shape& output, const std::vector<argument>& args) const
+    {
+        const auto& out_lens = output.lens();
+        if(not all_of(args, [&](const argument& arg) {
+               const auto& lens = arg.get_shape().lens();
+               for(std::size_t i = 0; i < lens.size(); i++)
+               {
+                   if(not contains(axes, std::int64_t(i)) and lens[i] != out_lens[i])
+                       return false;
+               }
+               return true;
+           }))
+            return false;
+        return all_of(sm, [](const instruction& ins) {
+            if(ins.name() == "@literal")
+                return ins.get_shape().elements() == 1;
+            return contains({"@param", "@return", "contiguous", "multibroadcast", "pointwise"},
+                           ins.name()) or
+                   ins.get_operator().attributes().get("reduce", false);
+        });
+    }
+
+    struct step
+    {
+        operation op;
+        std::vector<std::size_t> inputs;
+        std::vector<module_ref> mods;
+        shape output;
+        std::size_t result = 0;
+    };
+
+    // Each reduction row is evaluated through the whole submodule before moving to the next one,
+    // so the pointwise ops before and after the reductions read the row while it is in cache
+    argument compute(const shape& output_shape,
+                     const std::vector<argument>& args,
+                     const std::vector<module_ref>& mods,
+                     const std::function<std::vector<argument>(
+                         module_ref&, const std::unordered_map<std::string, argument>&)>& run) const
+    {
+        const auto* sm = mods.front();
+        auto names     = sm->get_parameter_names();
+        std::sort(names.begin(), names.end());
+        bool rowwise = is_rowwise(*sm, output_shape, args);
+        auto view    = [&](const shape& s) {
+            if(not rowwise)
+                return s;
+            return shape{s.type(), row_lens(s.lens()), s.strides()};
+        };
+
+        std::unordered_map<instruction_ref, std::size_t> regs;
+        std::vector<shape> shapes;
+        for(const auto& name : names)
+        {
+            regs[sm->get_parameter(name)] = shapes.size();
+            shapes.push_back(view(args[shapes.size()].get_shape()));
+        }
+        std::vector<argument> init(shapes.size());
+        std::vector<step> steps;
+        for(auto ins : iterator_for(*sm))
+        {
+            if(ins->name() == "@param")
+                continue;
+            if(ins->name() == "@return")
+                break;
+            auto r    = shapes.size();
+            regs[ins] = r;
+            if(ins->name() == "@literal")
+            {
+                init.push_back(ins->get_literal().get_argument());
+                shapes.push_back(ins->get_shape());
+                continue;
+            }
+            step s;
+            s.op = ins->normalized_operator();
+            if(rowwise and ins->name() == "multibroadcast")
+                s.op = make_op("multibroadcast", {{"out_lens", view(ins->get_shape()).lens()}});
+            s.mods = ins->module_inputs();
+            std::vector<shape> input_shapes;
+            for(auto input : ins->inputs())
+            {
+                s.inputs.push_back(regs.at(input));
+                input_shapes.push_back(shapes.at(s.inputs.back()));
+            }
+            s.output = s.op.compute_shape(input_shapes, s.mods);
+            s.result = r;
+            init.emplace_back();
+            shapes.push_back(s.output);
+            steps.push_back(s);
+        }
+        auto output = regs.at(sm->get_returns().front());
+
+        argument result{output_shape};
+        // Index space of the rows, with the reduction axes set to 1
+        shape rows = output_shape;
+        if(rowwise)
+        {
+            auto lens = output_shape.lens();
+            for(auto axis : axes)
+                lens[axis] = 1;
+            rows = shape{output_shape.type(), lens};
+        }
+        par_for(rowwise ? rows.elements() : 1, [&](auto i) {
+            auto idx    = rows.multi(i);
+            auto offset = [&](const shape& s) {
+                return rowwise ? s.index(idx) * s.type_size() : 0;
+            };
+            auto values = init;
+            for(std::size_t k = 0; k < args.size(); k++)
+                values[k] = {shapes[k], args[k].data() + offset(args[k].get_shape())};
+            for(const auto& s : steps)
+            {
+                std::vector<argument> inputs;
+                std::transform(s.inputs.begin(),
+                               s.inputs.end(),
+                               std::back_inserter(inputs),
+                               [&](auto r) { return values[r]; });
+                values[s.result] = s.op.compute(s.output, inputs, s.mods, run);
+            }
+            argument out{view(output_shape), result.data() + offset(output_shape)};
+            visit_all(out, values[output])(
+                [&](auto y, auto x) { std::copy(x.begin(), x.end(), y.begin()); });
+        });
+        return result;
+    }
+
     std::string name() const { return "fused_reduce"; }
 };
 MIGRAPHX_REGISTER_OP(fused_reduce);
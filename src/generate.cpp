@@ -22,6 +22,7 @@
  * THE SOFTWARE.
  */
 #include <migraphx/generate.hpp>
+#include <migraphx/host_allocator.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -41,11 +42,10 @@ argument fill_argument(shape s, double value)
     }
     else
     {
-        s.visit_type([&](auto as) {
-            using type = typename decltype(as)::type;
-            auto v     = fill_tensor_data<type>(s, value);
-            result     = {s, v};
-        });
+        // Allocate through the host allocator so the buffers are pooled, the fill writes every
+        // element so the buffer is not cleared first
+        result = argument{s, allocate_host_buffer(s.bytes())};
+        result.visit([&](auto v) { std::fill(v.begin(), v.end(), value); });
     }
     return result;
 }
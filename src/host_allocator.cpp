@@ -0,0 +1,360 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/host_allocator.hpp>
+#include <migraphx/env.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/numa.hpp>
+#include <atomic>
+#include <cassert>
+#include <map>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_HOST_POOL)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_HOST_HUGE_PAGES)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_HOST_NUMA_LOCAL)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_HOST_POOL_MAX_BYTES)
+
+static constexpr std::size_t min_size_class = 64;
+static constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+static constexpr std::align_val_t host_alignment{64};
+
+// Round up to one of four size classes between consecutive powers of two
+static std::size_t size_class(std::size_t n)
+{
+    if(n <= min_size_class)
+        return min_size_class;
+    std::size_t p = min_size_class;
+    while(p < n)
+        p *= 2;
+    std::size_t step = p / 8;
+    return (n + step - 1) / step * step;
+}
+
+struct host_arena_impl
+{
+    host_arena_options options;
+    std::mutex m;
+    std::map<std::pair<int, std::size_t>, std::vector<char*>> free_lists;
+    // Node of each buffer, only tracked for NUMA-local pools
+    std::unordered_map<char*, int> nodes;
+    std::size_t bytes_cached = 0;
+    std::atomic<std::size_t> reused{0};
+    std::atomic<std::size_t> system_allocations{0};
+
+    explicit host_arena_impl(host_arena_options o) : options(o) {}
+
+    host_arena_impl(const host_arena_impl&) = delete;
+    host_arena_impl& operator=(const host_arena_impl&) = delete;
+
+    ~host_arena_impl() { release(); }
+
+    bool use_mmap(std::size_t n) const
+    {
+        return (options.huge_pages or options.numa_local) and n >= huge_page_size;
+    }
+
+    char* system_allocate(std::size_t n, int node)
+    {
+        system_allocations++;
+#ifdef __linux__
+        if(use_mmap(n))
+        {
+            void* p = mmap(nullptr, n, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if(p == MAP_FAILED) // NOLINT
+                MIGRAPHX_THROW("Failed to map " + std::to_string(n) + " bytes of host memory");
+            if(options.huge_pages)
+                madvise(p, n, MADV_HUGEPAGE);
+            if(options.numa_local)
+                bind_memory_to_numa_node(p, n, node);
+            return static_cast<char*>(p);
+        }
+#else
+        (void)node;
+#endif
+        return static_cast<char*>(::operator new(n, host_alignment));
+    }
+
+    void system_deallocate(char* p, std::size_t n) const
+    {
+#ifdef __linux__
+        if(use_mmap(n))
+        {
+            munmap(p, n);
+            return;
+        }
+#endif
+        ::operator delete(p, host_alignment);
+    }
+
+    char* allocate(std::size_t bytes)
+    {
+        return allocate(bytes, options.numa_local ? get_current_numa_node() : 0);
+    }
+
+    char* allocate(std::size_t bytes, int node)
+    {
+        auto n = size_class(bytes);
+        {
+            std::lock_guard<std::mutex> lock(m);
+            auto it = free_lists.find({node, n});
+            if(it != free_lists.end() and not it->second.empty())
+            {
+                auto* p = it->second.back();
+                it->second.pop_back();
+                bytes_cached -= n;
+                reused++;
+                return p;
+            }
+        }
+        auto* p = system_allocate(n, node);
+        if(options.numa_local)
+        {
+            std::lock_guard<std::mutex> lock(m);
+            nodes[p] = node;
+        }
+        return p;
+    }
+
+    void deallocate(char* p, std::size_t bytes)
+    {
+        auto n = size_class(bytes);
+        {
+            std::lock_guard<std::mutex> lock(m);
+            if(bytes_cached + n <= options.max_cached_bytes)
+            {
+                int node = options.numa_local ? nodes.at(p) : 0;
+                free_lists[{node, n}].push_back(p);
+                bytes_cached += n;
+                return;
+            }
+            nodes.erase(p);
+        }
+        system_deallocate(p, n);
+    }
+
+    void release()
+    {
+        decltype(free_lists) buffers;
+        {
+            std::lock_guard<std::mutex> lock(m);
+            std::swap(buffers, free_lists);
+            for(auto&& [key, ps] : buffers)
+            {
+                for(auto* p : ps)
+                    nodes.erase(p);
+            }
+            bytes_cached = 0;
+        }
+        for(auto&& [key, ps] : buffers)
+        {
+            for(auto* p : ps)
+                system_deallocate(p, key.second);
+        }
+    }
+
+    host_allocation_stats stats()
+    {
+        host_allocation_stats result;
+        result.reused             = reused;
+        result.system_allocations = system_allocations;
+        std::lock_guard<std::mutex> lock(m);
+        result.bytes_cached = bytes_cached;
+        return result;
+    }
+};
+
+host_arena::host_arena() : host_arena(host_arena_options{}) {}
+
+host_arena::host_arena(host_arena_options options)
+    : impl(std::make_shared<host_arena_impl>(options))
+{
+}
+
+char* host_arena::allocate(std::size_t bytes) const { return impl->allocate(bytes); }
+
+char* host_arena::allocate(std::size_t bytes, int node) const
+{
+    assert(impl->options.numa_local);
+    return impl->allocate(bytes, node);
+}
+
+void host_arena::deallocate(char* p, std::size_t bytes) const { impl->deallocate(p, bytes); }
+
+void host_arena::release() const { impl->release(); }
+
+host_allocation_stats host_arena::stats() const { return impl->stats(); }
+
+host_allocator host_arena::get_allocator() const
+{
+    auto a = impl;
+    return {[=](std::size_t bytes) { return a->allocate(bytes); },
+            [=](char* p, std::size_t bytes) { a->deallocate(p, bytes); },
+            [=] { a->release(); },
+            [=] { return a->stats(); }};
+}
+
+static host_arena_options default_arena_options()
+{
+    host_arena_options options;
+    options.huge_pages = enabled(MIGRAPHX_HOST_HUGE_PAGES{});
+    options.numa_local = enabled(MIGRAPHX_HOST_NUMA_LOCAL{});
+    options.max_cached_bytes =
+        value_of(MIGRAPHX_HOST_POOL_MAX_BYTES{}, options.max_cached_bytes);
+    return options;
+}
+
+static host_allocator default_host_allocator()
+{
+    if(enabled(MIGRAPHX_DISABLE_HOST_POOL{}))
+        return {[](std::size_t bytes) { return new char[bytes]; }, // NOLINT
+                [](char* p, std::size_t) { delete[] p; }};          // NOLINT
+    return host_arena{default_arena_options()}.get_allocator();
+}
+
+// The buffers placed on a NUMA node have their own pool, since a replaced allocator cannot
+// place its memory
+static const host_arena& get_numa_arena()
+{
+    static const host_arena arena = [] {
+        auto options       = default_arena_options();
+        options.numa_local = true;
+        if(enabled(MIGRAPHX_DISABLE_HOST_POOL{}))
+            options.max_cached_bytes = 0;
+        return host_arena{options};
+    }();
+    return arena;
+}
+
+struct host_allocator_state
+{
+    std::mutex m;
+    std::shared_ptr<const host_allocator> current =
+        std::make_shared<const host_allocator>(default_host_allocator());
+    std::atomic<std::size_t> allocations{0};
+    std::atomic<std::size_t> bytes_in_use{0};
+    std::atomic<std::size_t> peak_bytes_in_use{0};
+
+    std::shared_ptr<const host_allocator> get()
+    {
+        std::lock_guard<std::mutex> lock(m);
+        return current;
+    }
+
+    void set(host_allocator a)
+    {
+        auto p = std::make_shared<const host_allocator>(std::move(a));
+        std::lock_guard<std::mutex> lock(m);
+        current = p;
+    }
+
+    void add_bytes(std::size_t bytes)
+    {
+        allocations++;
+        auto n    = bytes_in_use += bytes;
+        auto peak = peak_bytes_in_use.load();
+        while(n > peak and not peak_bytes_in_use.compare_exchange_weak(peak, n))
+            ;
+    }
+};
+
+static host_allocator_state& get_host_allocator_state()
+{
+    static host_allocator_state state;
+    return state;
+}
+
+void set_host_allocator(host_allocator a)
+{
+    if(not a.allocate or not a.deallocate)
+        MIGRAPHX_THROW("Host allocator must provide allocate and deallocate");
+    get_host_allocator_state().set(std::move(a));
+}
+
+void reset_host_allocator() { get_host_allocator_state().set(default_host_allocator()); }
+
+std::shared_ptr<char> allocate_host_buffer(std::size_t bytes)
+{
+    auto& state = get_host_allocator_state();
+    auto a      = state.get();
+    auto* p     = a->allocate(bytes);
+    if(p == nullptr)
+        MIGRAPHX_THROW("Failed to allocate " + std::to_string(bytes) + " bytes of host memory");
+    state.add_bytes(bytes);
+    // The deleter keeps the allocator alive after it is replaced
+    return {p, [a, bytes](char* x) {
+                get_host_allocator_state().bytes_in_use -= bytes;
+                a->deallocate(x, bytes);
+            }};
+}
+
+std::shared_ptr<char> allocate_host_buffer(std::size_t bytes, int node)
+{
+    if(node < 0)
+        return allocate_host_buffer(bytes);
+    auto arena = get_numa_arena();
+    auto* p    = arena.allocate(bytes, node);
+    get_host_allocator_state().add_bytes(bytes);
+    return {p, [arena, bytes](char* x) {
+                get_host_allocator_state().bytes_in_use -= bytes;
+                arena.deallocate(x, bytes);
+            }};
+}
+
+host_allocation_stats get_host_allocation_stats()
+{
+    auto& state = get_host_allocator_state();
+    auto a      = state.get();
+    host_allocation_stats result;
+    if(a->stats)
+        result = a->stats();
+    auto numa = get_numa_arena().stats();
+    result.reused += numa.reused;
+    result.system_allocations += numa.system_allocations;
+    result.bytes_cached += numa.bytes_cached;
+    result.allocations       = state.allocations;
+    result.bytes_in_use      = state.bytes_in_use;
+    result.peak_bytes_in_use = state.peak_bytes_in_use;
+    return result;
+}
+
+void release_host_buffers()
+{
+    auto a = get_host_allocator_state().get();
+    if(a->release)
+        a->release();
+    get_numa_arena().release();
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
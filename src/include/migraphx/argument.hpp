@@ -59,14 +59,15 @@ struct MIGRAPHX_EXPORT argument : raw_data<argument>
     argument(shape s, T* d)
         : m_shape(std::move(s))
     {
-        assign_buffer([d] { return reinterpret_cast<char*>(d); });
+        assign_buffer(reinterpret_cast<char*>(d), nullptr);
     }
 
     template <class T>
     argument(shape s, std::shared_ptr<T> d)
         : m_shape(std::move(s))
     {
-        assign_buffer([d] { return reinterpret_cast<char*>(d.get()); });
+        auto* p = reinterpret_cast<char*>(d.get());
+        assign_buffer(p, std::move(d));
     }
 
     argument(shape s, std::nullptr_t);
@@ -74,7 +75,12 @@ struct MIGRAPHX_EXPORT argument : raw_data<argument>
     argument(const std::vector<argument>& args);
 
     /// Provides a raw pointer to the data
-    char* data() const;
+    char* data() const
+    {
+        assert(m_shape.type() != shape::tuple_type);
+        assert(not this->empty());
+        return m_data.data();
+    }
 
     /// Whether data is available
     bool empty() const;
@@ -104,15 +110,24 @@ struct MIGRAPHX_EXPORT argument : raw_data<argument>
     }
 
     private:
+    void assign_buffer(char* p, std::shared_ptr<void> owner);
     void assign_buffer(std::function<char*()> d);
     struct data_t
     {
+        // Most buffers are a pointer kept alive by the owner, and `get` is only used for
+        // buffers that are computed by a function
+        char* ptr = nullptr;
+        std::shared_ptr<void> owner = nullptr;
         std::function<char*()> get = nullptr;
         std::vector<data_t> sub = {};
+        bool has_ptr = false;
+        char* data() const { return get ? get() : ptr; }
         data_t share() const;
         static data_t from_args(const std::vector<argument>& args);
     };
     argument(const shape& s, const data_t& d);
+    static data_t make_tuple_data(const shape& s,
+                                  const std::function<data_t(std::size_t)>& make_element);
     shape m_shape;
     data_t m_data{};
 };
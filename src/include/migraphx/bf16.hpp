@@ -0,0 +1,194 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MIGRAPHX_GUARD_RTGLIB_BF16_HPP
+#define MIGRAPHX_GUARD_RTGLIB_BF16_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <limits>
+#include <iostream>
+#include <type_traits>
+#include <migraphx/config.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+// bfloat16 stores the upper 16 bits of a float: s1e8m7. It has the same range as float, so
+// converting from float only needs rounding of the mantissa.
+struct bf16
+{
+    uint16_t data = 0x0000;
+    // default constructor
+    constexpr bf16() = default;
+    // default copy constructor
+    constexpr bf16(const bf16& y) = default;
+    struct from_bits_t
+    {
+    };
+    static constexpr from_bits_t from_bits() { return from_bits_t(); }
+
+    explicit constexpr bf16(uint16_t bits, from_bits_t) : data(bits) {}
+
+    explicit bf16(float v) : data(float_to_bits(v)) {}
+
+    inline operator float() const
+    {
+        uint32_t bits = static_cast<uint32_t>(data) << 16u;
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+
+    inline constexpr bool is_zero() const { return (data & 0x7FFFu) == 0; }
+
+    inline constexpr bool is_nan() const
+    {
+        return (data & 0x7F80u) == 0x7F80u and (data & 0x007Fu) != 0;
+    }
+
+    inline constexpr bool is_inf() const { return (data & 0x7FFFu) == 0x7F80u; }
+
+// NOLINTNEXTLINE
+#define MIGRAPHX_BF16_UNARY_OP(unary_op, binary_op)                                   \
+    bf16& operator unary_op(const bf16& rhs)                                          \
+    {                                                                                 \
+        const auto tmp = static_cast<float>(*this) binary_op static_cast<float>(rhs); \
+        *this          = static_cast<bf16>(tmp);                                      \
+        return *this;                                                                 \
+    }                                                                                 \
+    bf16& operator unary_op(const float& rhs)                                         \
+    {                                                                                 \
+        const auto tmp = static_cast<float>(*this) binary_op static_cast<float>(rhs); \
+        *this          = static_cast<bf16>(tmp);                                      \
+        return *this;                                                                 \
+    }
+
+    MIGRAPHX_BF16_UNARY_OP(*=, *)
+    MIGRAPHX_BF16_UNARY_OP(-=, -)
+    MIGRAPHX_BF16_UNARY_OP(+=, +)
+    MIGRAPHX_BF16_UNARY_OP(/=, /)
+
+    inline constexpr bf16& operator=(const bf16& rhs)     = default;
+    inline constexpr bf16& operator=(bf16&& rhs) noexcept = default;
+
+    inline bf16& operator=(float rhs)
+    {
+        *this = static_cast<bf16>(rhs);
+        return *this;
+    }
+
+    inline bool operator==(const bf16& rhs) const
+    {
+        if(rhs.is_nan() or this->is_nan())
+            return false;
+        return (rhs.is_zero() and this->is_zero()) or (this->data == rhs.data);
+    }
+
+    inline bool operator<(const bf16& rhs) const
+    {
+        return static_cast<float>(*this) < static_cast<float>(rhs);
+    }
+
+    inline bool operator>(const bf16& rhs) const
+    {
+        return static_cast<float>(*this) > static_cast<float>(rhs);
+    }
+
+    private:
+    // Round to nearest even, while keeping nans quiet
+    static uint16_t float_to_bits(float v)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        if(std::isnan(v))
+            return static_cast<uint16_t>((bits >> 16u) | 0x0040u);
+        uint32_t rounding = 0x7FFFu + ((bits >> 16u) & 1u);
+        return static_cast<uint16_t>((bits + rounding) >> 16u);
+    }
+};
+
+// Special operator overloading
+inline std::ostream& operator<<(std::ostream& os, const bf16& rhs)
+{
+    return os << static_cast<float>(rhs);
+}
+
+inline bf16 fabs(bf16 v)
+{
+    v.data = v.data & 0x7FFF; // NOLINT
+    return v;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+// =================================================================================================
+// define numeric limits for the new data type
+// NOLINTBEGIN
+namespace std {
+inline bool isfinite(migraphx::bf16 x) { return not x.is_inf() and not x.is_nan(); }
+inline bool isnan(migraphx::bf16 x) { return x.is_nan(); }
+
+template <>
+class numeric_limits<migraphx::bf16>
+{
+    using bf16 = migraphx::bf16;
+
+    public:
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed      = true;
+    static constexpr bool has_infinity   = true;
+    static constexpr int digits          = 8;
+    static constexpr bf16 epsilon() { return bf16(0x3C00, bf16::from_bits()); }
+    static constexpr bf16 quiet_NaN() { return bf16(0x7FC0, bf16::from_bits()); }
+    static constexpr bf16 infinity() { return bf16(0x7F80, bf16::from_bits()); }
+    static constexpr bf16 max() { return bf16(0x7F7F, bf16::from_bits()); }
+    // this is min value that is not DeNorm
+    static constexpr bf16 min() { return bf16(0x0080, bf16::from_bits()); }
+    static constexpr bf16 denorm_min() { return bf16(0x0001, bf16::from_bits()); }
+    static constexpr bf16 lowest() { return bf16(0xFF7F, bf16::from_bits()); }
+};
+
+template <class U>
+struct common_type<migraphx::bf16, U> : std::common_type<float, U>
+{
+};
+
+template <class U>
+struct common_type<U, migraphx::bf16> : std::common_type<float, U>
+{
+};
+
+template <>
+struct common_type<migraphx::bf16, migraphx::bf16>
+{
+    using type = migraphx::bf16;
+};
+} // namespace std
+// NOLINTEND
+// =================================================================================================
+#endif // MIGRAPHX_GUARD_RTGLIB_BF16_HPP
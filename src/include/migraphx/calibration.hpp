@@ -0,0 +1,116 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_CALIBRATION_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_CALIBRATION_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/shape.hpp>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/**
+ * How the clipping threshold of a captured tensor is chosen from the calibration data
+ */
+enum class calibration_method
+{
+    max_abs,
+    moving_average,
+    percentile,
+    entropy
+};
+
+MIGRAPHX_EXPORT std::string to_string(calibration_method method);
+MIGRAPHX_EXPORT calibration_method to_calibration_method(const std::string& name);
+MIGRAPHX_EXPORT std::ostream& operator<<(std::ostream& os, calibration_method method);
+
+struct calibration_options
+{
+    calibration_method method = calibration_method::max_abs;
+    // Percentile of the absolute values kept when using the percentile method
+    float percentile = 99.99f;
+    // Weight of each new batch for the moving_average method
+    float averaging_constant = 0.01f;
+    // Number of histogram bins for the percentile and entropy methods
+    std::size_t bins = 2048;
+    // Use one scale per output channel for constant weights of convolution and dot
+    bool per_channel = false;
+    // Read the quantization parameters from this file instead of running the calibration data
+    std::string load_table = "";
+    // Write the computed quantization parameters to this file
+    std::string save_table = "";
+};
+
+/**
+ * Accumulates statistics of a captured tensor across calibration runs. The
+ * argument is visited in place so no copy of the data is made on host targets.
+ */
+struct MIGRAPHX_EXPORT calibration_observer
+{
+    calibration_observer() = default;
+    calibration_observer(const calibration_options& options);
+
+    void observe(const argument& arg);
+
+    /// Absolute value that maps to the edge of the quantized range
+    float threshold(float quantized_range) const;
+
+    /// True until a tensor has been observed
+    bool empty() const { return not initialized; }
+    float max_abs() const { return max_abs_val; }
+    const std::vector<double>& histogram() const { return hist; }
+    float histogram_range() const { return hist_range; }
+
+    private:
+    void grow_histogram(float batch_max);
+    float percentile_threshold() const;
+    float entropy_threshold(float quantized_range) const;
+
+    calibration_options opts = {};
+    bool initialized         = false;
+    float max_abs_val        = 0.0f;
+    float avg_min            = 0.0f;
+    float avg_max            = 0.0f;
+    float hist_range         = 0.0f;
+    std::vector<double> hist = {};
+};
+
+/// Save the scale and shift of each captured tensor
+MIGRAPHX_EXPORT void save_calibration_table(const std::string& filename,
+                                            shape::type_t precision,
+                                            const std::vector<std::pair<float, float>>& params);
+
+/// Load the parameters written by save_calibration_table
+MIGRAPHX_EXPORT std::vector<std::pair<float, float>>
+load_calibration_table(const std::string& filename, shape::type_t precision);
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -26,6 +26,7 @@
 
 #include <migraphx/config.hpp>
 #include <migraphx/tracer.hpp>
+#include <migraphx/pass_profiler.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -41,7 +42,20 @@ struct compile_options
     bool fast_math       = true;
     bool exhaustive_tune = false;
 
+    /// Number of threads used by targets that run on the host, 0 uses the default
+    std::size_t num_threads = 0;
+    /// Bind each host thread to one core
+    bool pin_threads        = false;
+    /// Run the host threads and place the literals on this NUMA node, -1 uses every node
+    int numa_node           = -1;
+
     tracer trace{};
+
+    /**
+     * Record the time, instruction counts, matcher hits and inserted
+     * instructions of every pass. Use `pass_profiler::create()` to enable it.
+     */
+    pass_profiler profiler{};
 };
 
 } // namespace MIGRAPHX_INLINE_NS
@@ -0,0 +1,73 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_COST_MODEL_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_COST_MODEL_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/instruction_ref.hpp>
+#include <string>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/// Estimated work of one instruction
+struct op_cost
+{
+    double flops = 0;
+    /// Bytes read from the inputs and written to the output
+    double bytes = 0;
+
+    /// FLOPs per byte moved
+    double arithmetic_intensity() const { return bytes == 0 ? 0 : flops / bytes; }
+};
+
+/**
+ * Estimate the FLOPs and bytes moved by an instruction from its operator and shapes. It knows
+ * about dot, convolution, pooling, reductions and pointwise ops, including the target versions
+ * such as dnnl::convolution or gpu::gemm. Any other instruction is counted as data movement, and
+ * views such as transpose or reshape cost nothing.
+ */
+MIGRAPHX_EXPORT op_cost estimate_cost(instruction_ref ins);
+
+/// Peak throughput of a device, used to tell whether an instruction is compute or memory bound
+struct roofline
+{
+    double peak_gflops = 0;
+    double peak_gbps   = 0;
+
+    /// The arithmetic intensity where the roofline changes from memory to compute bound
+    double ridge_point() const;
+
+    /// Returns "compute" or "memory"
+    std::string classify(const op_cost& cost) const;
+
+    /// The roofline for the host, the peaks can be set with MIGRAPHX_PEAK_GFLOPS and
+    /// MIGRAPHX_PEAK_GBPS
+    static roofline host();
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif // MIGRAPHX_GUARD_MIGRAPHX_COST_MODEL_HPP
@@ -26,6 +26,7 @@
 
 #include <migraphx/config.hpp>
 #include <migraphx/filesystem.hpp>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -39,6 +40,17 @@ MIGRAPHX_EXPORT std::string read_string(const fs::path& filename);
 MIGRAPHX_EXPORT void write_buffer(const fs::path& filename, const char* buffer, std::size_t size);
 MIGRAPHX_EXPORT void write_buffer(const fs::path& filename, const std::vector<char>& buffer);
 
+/**
+ * Write a file for a cache: write is called with a temporary path next to the file, which is
+ * then renamed to the file, so other threads and processes never read a partial file. Returns
+ * false, leaving no temporary file behind, when writing fails, since the cache is only an
+ * optimization.
+ */
+MIGRAPHX_EXPORT bool try_write_file(const fs::path& filename,
+                                    const std::function<void(const fs::path&)>& write);
+MIGRAPHX_EXPORT bool
+try_write_buffer(const fs::path& filename, const char* buffer, std::size_t size);
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
 
@@ -28,6 +28,7 @@
 #include <half/half.hpp>
 #include <migraphx/config.hpp>
 #include <migraphx/float8.hpp>
+#include <migraphx/bf16.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -80,6 +81,30 @@ struct common_type<migraphx::half, migraphx::fp8::fp8e4m3fnuz>
     using type = float;
 };
 
+template <>
+struct common_type<migraphx::bf16, migraphx::half>
+{
+    using type = float;
+};
+
+template <>
+struct common_type<migraphx::half, migraphx::bf16>
+{
+    using type = float;
+};
+
+template <>
+struct common_type<migraphx::fp8::fp8e4m3fnuz, migraphx::bf16>
+{
+    using type = float;
+};
+
+template <>
+struct common_type<migraphx::bf16, migraphx::fp8::fp8e4m3fnuz>
+{
+    using type = float;
+};
+
 template <>
 struct common_type<migraphx::half, migraphx::half>
 {
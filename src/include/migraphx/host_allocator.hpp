@@ -0,0 +1,136 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_HOST_ALLOCATOR_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_HOST_ALLOCATOR_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/functional.hpp>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/// Statistics for the host buffers allocated for arguments
+struct host_allocation_stats
+{
+    /// Number of buffers requested
+    std::size_t allocations = 0;
+    /// Number of requests served from the pool instead of the system
+    std::size_t reused = 0;
+    /// Number of buffers allocated from the system
+    std::size_t system_allocations = 0;
+    std::size_t bytes_in_use       = 0;
+    std::size_t peak_bytes_in_use  = 0;
+    /// Bytes held by the pool that are not in use
+    std::size_t bytes_cached = 0;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.allocations, "allocations"),
+                    f(self.reused, "reused"),
+                    f(self.system_allocations, "system_allocations"),
+                    f(self.bytes_in_use, "bytes_in_use"),
+                    f(self.peak_bytes_in_use, "peak_bytes_in_use"),
+                    f(self.bytes_cached, "bytes_cached"));
+    }
+};
+
+/**
+ * Allocator used for the host buffers of arguments. The memory returned by
+ * `allocate` does not need to be initialized. `release` and `stats` are
+ * optional, and are used to free cached memory and to report the pool
+ * statistics.
+ */
+struct host_allocator
+{
+    std::function<char*(std::size_t)> allocate;
+    std::function<void(char*, std::size_t)> deallocate;
+    std::function<void()> release                = nullptr;
+    std::function<host_allocation_stats()> stats = nullptr;
+};
+
+struct host_arena_options
+{
+    /// Back allocations of 2MB or more with transparent huge pages
+    bool huge_pages = false;
+    /// Keep separate pools for each NUMA node and bind new memory to the calling thread's node
+    bool numa_local = false;
+    /// Buffers freed beyond this many cached bytes are returned to the system
+    std::size_t max_cached_bytes = std::size_t{1} << 30;
+};
+
+struct host_arena_impl;
+
+/**
+ * Pooling allocator that rounds requests up to a size class (four classes
+ * for each power of two) and keeps freed buffers to be reused by later
+ * requests, so the buffers of one `program::eval` are recycled by the next.
+ */
+struct MIGRAPHX_EXPORT host_arena
+{
+    host_arena();
+    explicit host_arena(host_arena_options options);
+
+    char* allocate(std::size_t bytes) const;
+    /// Allocate from the pool of a NUMA node, only used when `numa_local` is set
+    char* allocate(std::size_t bytes, int node) const;
+    void deallocate(char* p, std::size_t bytes) const;
+
+    /// Return all cached buffers to the system
+    void release() const;
+
+    host_allocation_stats stats() const;
+
+    /// An allocator that shares this arena
+    host_allocator get_allocator() const;
+
+    private:
+    std::shared_ptr<host_arena_impl> impl;
+};
+
+/// Replace the allocator used for argument buffers
+MIGRAPHX_EXPORT void set_host_allocator(host_allocator a);
+
+/// Restore the default pooling allocator
+MIGRAPHX_EXPORT void reset_host_allocator();
+
+/// Allocate an uninitialized buffer from the current host allocator
+MIGRAPHX_EXPORT std::shared_ptr<char> allocate_host_buffer(std::size_t bytes);
+
+/// Allocate an uninitialized buffer that is placed on the NUMA node, from a pool shared by all
+/// NUMA placed buffers. A negative node uses the current host allocator.
+MIGRAPHX_EXPORT std::shared_ptr<char> allocate_host_buffer(std::size_t bytes, int node);
+
+MIGRAPHX_EXPORT host_allocation_stats get_host_allocation_stats();
+
+/// Return the buffers cached by the current host allocator to the system
+MIGRAPHX_EXPORT void release_host_buffers();
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif // MIGRAPHX_GUARD_MIGRAPHX_HOST_ALLOCATOR_HPP
@@ -100,6 +100,7 @@ struct MIGRAPHX_EXPORT instruction
     void remove_output(const T& ins)
     {
         migraphx::erase(output, ins);
+        touch();
     }
 
     static void replace_refs(instruction_ref ins,
@@ -142,6 +143,13 @@ struct MIGRAPHX_EXPORT instruction
 
     void set_target_id(std::size_t tid);
 
+    /// Stamp that is renewed whenever the instruction is created or copied, or
+    /// its operator, shape, inputs or outputs change
+    std::size_t get_version() const;
+
+    /// The stamp the next created or changed instruction will get
+    static std::size_t next_version();
+
     void debug_print() const;
 
     static void print(std::ostream& os,
@@ -172,6 +180,17 @@ struct MIGRAPHX_EXPORT instruction
 
     void replace(const shape& r);
 
+    void touch();
+
+    // A copy gets a new stamp rather than the one it was copied from
+    struct version_stamp
+    {
+        version_stamp();
+        version_stamp(const version_stamp&);
+        version_stamp& operator=(const version_stamp&);
+        std::size_t value;
+    };
+
     operation op;
     shape result{};
     std::vector<instruction_ref> output;
@@ -180,6 +199,7 @@ struct MIGRAPHX_EXPORT instruction
     literal lit;
     bool normalized       = false;
     std::size_t target_id = 0;
+    version_stamp version{};
 };
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
@@ -32,7 +32,9 @@
 #include <migraphx/make_shared_array.hpp>
 #include <migraphx/config.hpp>
 
+#include <functional>
 #include <memory>
+#include <mutex>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -87,11 +89,24 @@ struct literal : raw_data<literal>
         std::copy(x, x + s.bytes(), buffer.get());
     }
 
+    /// Literal that is loaded by f when its data is first read, so the data of a literal that is
+    /// never used is not loaded. The literal and its copies share the loaded data.
+    template <class F, MIGRAPHX_REQUIRES(std::is_invocable<F, char*>{})>
+    literal(const shape& s, F f) : lazy(std::make_shared<lazy_data>()), m_shape(s)
+    {
+        lazy->load = std::move(f);
+    }
+
     /// Whether data is available
-    bool empty() const { return this->buffer == nullptr; }
+    bool empty() const { return this->buffer == nullptr and this->lazy == nullptr; }
 
     /// Provides a raw pointer to the data
-    const char* data() const { return this->buffer.get(); }
+    const char* data() const
+    {
+        if(this->lazy != nullptr)
+            return this->lazy->get(m_shape.bytes());
+        return this->buffer.get();
+    }
 
     const shape& get_shape() const { return this->m_shape; }
 
@@ -100,12 +115,31 @@ struct literal : raw_data<literal>
     /// Convert the data to an argument
     argument get_argument() const
     {
-        auto b = make_shared_array<char>(buffer.get(), buffer.get() + m_shape.bytes());
+        auto b = make_shared_array<char>(data(), data() + m_shape.bytes());
         return {m_shape, [b]() { return b.get(); }};
     }
 
     private:
+    struct lazy_data
+    {
+        std::once_flag flag;
+        std::function<void(char*)> load;
+        std::shared_ptr<char> buffer;
+
+        const char* get(std::size_t bytes)
+        {
+            std::call_once(flag, [&] {
+                buffer = make_shared_array<char>(bytes);
+                load(buffer.get());
+                // Release what the loader holds on to
+                load = nullptr;
+            });
+            return buffer.get();
+        }
+    };
+
     std::shared_ptr<char> buffer;
+    std::shared_ptr<lazy_data> lazy;
     shape m_shape;
 
     // Keeps the same data ordering as the given container
@@ -30,11 +30,15 @@
 #include <migraphx/instruction.hpp>
 #include <migraphx/module.hpp>
 #include <migraphx/optional.hpp>
+#include <migraphx/pass_profiler.hpp>
 #include <migraphx/iterator_for.hpp>
 #include <migraphx/type_name.hpp>
 #include <migraphx/source_location.hpp>
 #include <migraphx/config.hpp>
+#include <migraphx/rank.hpp>
+#include <migraphx/env.hpp>
 #include <array>
+#include <functional>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -133,6 +137,48 @@ function_matcher<F> make_function_matcher(F f)
     return {f};
 }
 
+/// The op names the root instruction must have for a matcher to match, or
+/// nullopt when the matcher can match an instruction with any name.
+using root_name_set = optional<std::unordered_set<std::string>>;
+
+template <class M>
+auto get_root_names_impl(rank<1>, const M& m) -> decltype(m.root_names())
+{
+    return m.root_names();
+}
+
+template <class M>
+root_name_set get_root_names_impl(rank<0>, const M&)
+{
+    return nullopt;
+}
+
+/// Get the op names of the root instruction that a matcher can match
+template <class M>
+root_name_set get_root_names(const M& m)
+{
+    return get_root_names_impl(rank<1>{}, m);
+}
+
+/// Attach the op names of the root instruction to a matcher
+template <class M>
+struct root_matcher
+{
+    M m;
+    root_name_set names;
+
+    auto match(matcher_context& ctx, instruction_ref ins) const { return m.match(ctx, ins); }
+
+    const root_name_set& root_names() const { return names; }
+};
+
+/// Attach the op names of the root instruction to a matcher
+template <class M>
+root_matcher<M> make_root_matcher(M m, root_name_set names)
+{
+    return {m, std::move(names)};
+}
+
 /// Converts a matcher to bind the instruction to name
 template <class M>
 auto bind_match(M m, std::string name)
@@ -157,9 +203,14 @@ struct bindable_matcher
 {
     M m;
 
-    auto bind(std::string name) const { return bind_match(m, std::move(name)); }
+    auto bind(std::string name) const
+    {
+        return make_root_matcher(bind_match(m, std::move(name)), get_root_names(m));
+    }
 
     auto match(matcher_context& ctx, instruction_ref ins) const { return m.match(ctx, ins); }
+
+    root_name_set root_names() const { return get_root_names(m); }
 };
 
 /// Create a bindable matcher
@@ -229,8 +280,8 @@ struct basic_matcher
     {
         // Copy m because we cant capture `this` by value
         auto mm = m;
-        return make_basic_fun_matcher([=](matcher_context& ctx,
-                                          instruction_ref ins) -> optional<instruction_ref> {
+        auto f  = make_function_matcher([=](matcher_context& ctx,
+                                           instruction_ref ins) -> optional<instruction_ref> {
             auto result = mm.match(ctx, ins);
             if(result)
             {
@@ -241,11 +292,17 @@ struct basic_matcher
             }
             return nullopt;
         });
+        return make_basic_matcher(make_root_matcher(f, get_root_names(m)));
     }
 
-    auto bind(std::string name) const { return bind_match(m, std::move(name)); }
+    auto bind(std::string name) const
+    {
+        return make_root_matcher(bind_match(m, std::move(name)), get_root_names(m));
+    }
 
     auto match(matcher_context& ctx, instruction_ref ins) const { return m.match(ctx, ins); }
+
+    root_name_set root_names() const { return get_root_names(m); }
 };
 
 /// Create a typed-erased matcher
@@ -375,29 +432,76 @@ match::matcher_result find_match(module& modl, M&& m)
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_MATCHES)
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_MATCHES_FOR)
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_VALIDATE_MATCHES)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_MATCHER_INDEX)
 
-/// Find matches for an instruction in the module for per section of matchers
+/// Index of the matchers that can possibly match an instruction, based on
+/// the op names of the root instruction derived from `match::name(...)`
+struct matcher_index
+{
+    template <class... Ms>
+    matcher_index(const Ms&... ms)
+    {
+        std::vector<root_name_set> names = {get_root_names(ms.matcher())...};
+        any.resize(names.size(), true);
+        if(enabled(MIGRAPHX_DISABLE_MATCHER_INDEX{}))
+            return;
+        std::transform(names.begin(), names.end(), any.begin(), [](const auto& n) {
+            return not n.has_value();
+        });
+        for(std::size_t i = 0; i < names.size(); i++)
+        {
+            if(not names[i])
+                continue;
+            for(const auto& name : *names[i])
+                candidates.emplace(name, any).first->second[i] = true;
+        }
+    }
+
+    /// A mask of the matchers that can match an instruction with this name
+    const std::vector<bool>& operator[](const std::string& name) const
+    {
+        auto it = candidates.find(name);
+        if(it == candidates.end())
+            return any;
+        return it->second;
+    }
+
+    private:
+    std::unordered_map<std::string, std::vector<bool>> candidates;
+    std::vector<bool> any;
+};
+
+/// Find matches for an instruction in the module using only the matchers
+/// selected in the candidates mask, returns true if a matcher was applied
 template <class Mod, class... Ms>
-void find_matches_for(source_location location, Mod& mod, instruction_ref ins, Ms&&... ms)
+bool find_matches_for(source_location location,
+                      Mod& mod,
+                      instruction_ref ins,
+                      const std::vector<bool>& candidates,
+                      Ms&&... ms)
 {
     const int trace         = value_of(MIGRAPHX_TRACE_MATCHES{});
     const bool validate     = enabled(MIGRAPHX_VALIDATE_MATCHES{});
     const auto trace_filter = string_value_of(MIGRAPHX_TRACE_MATCHES_FOR{});
     bool match              = false;
+    std::size_t i           = 0;
     each_args(
         [&](auto&& m) {
+            const bool candidate = candidates.empty() or candidates[i];
+            i++;
+            if(match or not candidate)
+                return;
             const auto& matcher_name = get_type_name(m);
             const bool trace_for     = not trace_filter.empty() and
                                    (contains(std::string{location.file_name()}, trace_filter) or
                                     contains(std::string{location.function_name()}, trace_filter) or
                                     contains(matcher_name, trace_filter));
-            if(match)
-                return;
             if(trace > 1 and trace_for)
                 std::cout << "Match: " << matcher_name << std::endl;
             auto r = match_instruction(get_module(mod), ins, m.matcher());
             if(r.result == get_module(mod).end())
                 return;
+            get_pass_counters().matcher_hits++;
             if(trace > 0 or trace_for)
             {
                 std::cout << "Matched by " << matcher_name << std::endl;
@@ -420,6 +524,14 @@ void find_matches_for(source_location location, Mod& mod, instruction_ref ins, M
             match = true;
         },
         ms...);
+    return match;
+}
+
+/// Find matches for an instruction in the module for per section of matchers
+template <class Mod, class... Ms>
+void find_matches_for(source_location location, Mod& mod, instruction_ref ins, Ms&&... ms)
+{
+    find_matches_for(location, mod, ins, std::vector<bool>{}, ms...);
 }
 
 /// Find matches in a module
@@ -428,9 +540,10 @@ struct find_matches
 {
     find_matches(Mod& mod, Ms&&... ms, source_location location = source_location::current())
     {
+        const matcher_index index{ms...};
         for(auto ins : iterator_for(get_module(mod)))
         {
-            find_matches_for(location, mod, ins, ms...);
+            find_matches_for(location, mod, ins, index[ins->name()], ms...);
         }
     }
 };
@@ -438,6 +551,73 @@ struct find_matches
 template <class Mod, class... Ms>
 find_matches(Mod& mod, Ms&&... ms) -> find_matches<Mod, Ms...>;
 
+/// Tracks which instructions to revisit between sweeps over a module
+struct MIGRAPHX_EXPORT match_worklist
+{
+    /// Start recording the instructions changed from now on
+    void start();
+
+    /// Select the instructions to visit in the next sweep: every instruction
+    /// created or changed since `start`, their inputs, and every instruction
+    /// that uses them
+    void update(const module& m);
+
+    bool empty() const;
+
+    bool contains(instruction_ref ins) const;
+
+    /// Whether to visit the instruction in the current sweep, which is when `update` selected
+    /// it, or when it or any instruction it uses changed earlier in this sweep. The
+    /// instructions must be checked in module order.
+    bool next(instruction_ref ins);
+
+    private:
+    std::size_t version = 0;
+    std::unordered_set<instruction_ref> visit;
+    std::unordered_set<instruction_ref> changed;
+};
+
+/**
+ * Call `f` on the instructions of the module over several sweeps, removing
+ * dead code after every sweep. The first sweep visits every instruction;
+ * later sweeps only visit the instructions selected by `match_worklist`.
+ * It stops once a sweep, including the dead code elimination, leaves the
+ * module unchanged, or when the maximum number of sweeps is reached.
+ */
+MIGRAPHX_EXPORT void find_matches_worklist_for(module& m,
+                                               std::size_t sweeps,
+                                               const std::function<void(instruction_ref)>& f);
+
+/**
+ * Repeatedly find matches in a module, removing dead code after every sweep.
+ * After the first sweep, an instruction is only visited again when it, an
+ * instruction it uses directly or indirectly, or an instruction using one of
+ * those changed since it was last visited. This finds the same matches as
+ * running `find_matches` followed by `dead_code_elimination` `sweeps` times
+ * only as long as every matcher looks at no more than the root, the
+ * instructions it uses directly or indirectly, and their outputs. A matcher
+ * that looks further, such as at the inputs of another output of an input,
+ * can miss a match that a full sweep would find.
+ */
+template <class Mod, class... Ms>
+struct find_matches_worklist
+{
+    find_matches_worklist(std::size_t sweeps,
+                          Mod& mod,
+                          Ms&&... ms,
+                          source_location location = source_location::current())
+    {
+        const matcher_index index{ms...};
+        find_matches_worklist_for(get_module(mod), sweeps, [&](instruction_ref ins) {
+            find_matches_for(location, mod, ins, index[ins->name()], ms...);
+        });
+    }
+};
+
+template <class Mod, class... Ms>
+find_matches_worklist(std::size_t sweeps, Mod& mod, Ms&&... ms)
+    -> find_matches_worklist<Mod, Ms...>;
+
 template <class M, class F>
 struct find_generic_match
 {
@@ -504,16 +684,56 @@ struct match_fold_f
         return p([&](auto... ms) { return match_fold_f::fold_matchers(ctx, ins, ms...); });
     }
 
+    template <class... Ms>
+    static root_name_set fold_root_names(const Ms&... ms)
+    {
+        if(not Matches)
+            return nullopt;
+        std::vector<root_name_set> names = {get_root_names(ms)...};
+        if(std::is_same<Op, lazy_or>{})
+        {
+            // Any of the names can match, unless one of the matchers can match anything
+            std::unordered_set<std::string> result;
+            for(const auto& n : names)
+            {
+                if(not n)
+                    return nullopt;
+                result.insert(n->begin(), n->end());
+            }
+            return result;
+        }
+        // Only the names that every matcher can match
+        root_name_set result = nullopt;
+        for(const auto& n : names)
+        {
+            if(not n)
+                continue;
+            if(not result)
+            {
+                result = n;
+                continue;
+            }
+            std::unordered_set<std::string> common;
+            std::copy_if(n->begin(),
+                         n->end(),
+                         std::inserter(common, common.end()),
+                         [&](const auto& x) { return result->count(x) > 0; });
+            result = std::move(common);
+        }
+        return result;
+    }
+
     template <class... Ts>
     auto operator()(Ts... ms) const
     {
-        return make_bf_matcher(
+        auto f = make_function_matcher(
             [=](matcher_context& ctx, instruction_ref ins) -> optional<instruction_ref> {
                 bool matches = match_fold_f::fold_matchers(ctx, ins, ms...);
                 if(matches == Matches)
                     return {ins};
                 return nullopt;
             });
+        return make_bindable_matcher(make_root_matcher(f, fold_root_names(ms...)));
     }
 
     template <class Selector>
@@ -702,8 +922,11 @@ inline auto var(std::string s)
 
 inline auto name(std::string s)
 {
-    return make_basic_pred_matcher(
-        [=, m_s = std::move(s)](instruction_ref ins) { return ins->name() == m_s; });
+    std::unordered_set<std::string> names = {s};
+    return make_basic_matcher(make_root_matcher(
+        make_predicate_matcher(
+            [=, m_s = std::move(s)](instruction_ref ins) { return ins->name() == m_s; }),
+        std::move(names)));
 }
 
 inline auto name_contains(const std::string& name)
@@ -714,9 +937,9 @@ inline auto name_contains(const std::string& name)
 
 inline auto name(std::unordered_set<std::string> names)
 {
-    return make_basic_pred_matcher([=, m_names = std::move(names)](instruction_ref ins) {
-        return m_names.count(ins->name()) > 0;
-    });
+    auto p = make_predicate_matcher(
+        [=, m_names = names](instruction_ref ins) { return m_names.count(ins->name()) > 0; });
+    return make_basic_matcher(make_root_matcher(p, std::move(names)));
 }
 
 template <class... Ts>
@@ -70,6 +70,9 @@ struct MIGRAPHX_EXPORT module
 
     std::string name() const;
 
+    /// An identifier that is unique to this module, copies of the module get a new one
+    std::size_t id() const;
+
     bool bypass() const;
     void set_bypass(bool b = true);
 
@@ -0,0 +1,52 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_NUMA_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_NUMA_HPP
+
+#include <migraphx/config.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/// Number of NUMA nodes, which is 1 when the topology is not available
+MIGRAPHX_EXPORT std::size_t get_numa_node_count();
+
+/// The CPUs of a NUMA node that the process may run on, or all of them for a negative node
+MIGRAPHX_EXPORT std::vector<std::size_t> get_numa_node_cpus(int node);
+
+/// The NUMA node of the CPU the calling thread is running on
+MIGRAPHX_EXPORT int get_current_numa_node();
+
+/// Restrict the calling thread to the CPUs, returns false when it is not supported
+MIGRAPHX_EXPORT bool set_thread_affinity(const std::vector<std::size_t>& cpus);
+
+/// Prefer placing the pages of the memory range on the node, returns false when it is not supported
+MIGRAPHX_EXPORT bool bind_memory_to_numa_node(void* p, std::size_t n, int node);
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif // MIGRAPHX_GUARD_MIGRAPHX_NUMA_HPP
@@ -25,6 +25,7 @@
 #define MIGRAPHX_GUARD_MIGRAPHLIB_ONNX_HPP
 
 #include <migraphx/program.hpp>
+#include <migraphx/program_cache.hpp>
 #include <migraphx/config.hpp>
 #include <migraphx/onnx/export.h>
 
@@ -58,6 +59,11 @@ struct onnx_options
     int64_t limit_max_iterations = std::numeric_limits<uint16_t>::max();
     /// Use dynamic output for operators when available
     bool use_dyn_output = false;
+    /// Defer reading the raw data of the initializers until it is used
+    bool lazy_initializers = false;
+    /// Stream the onnx file and read the raw data of the initializers from their offsets in the
+    /// file instead of parsing the whole file at once. Files over 2GB are always streamed.
+    bool stream_initializers = false;
 };
 
 /// Create a program from an onnx file
@@ -73,8 +79,20 @@ MIGRAPHX_ONNX_EXPORT program parse_onnx_buffer(const void* data,
                                                std::size_t size,
                                                const onnx_options& options);
 
+/// Create a program from an onnx file and compile it, or load the program compiled earlier for
+/// the same file, options and target from the cache
+MIGRAPHX_ONNX_EXPORT program compile_onnx(const std::string& name,
+                                          const target& t,
+                                          const compile_options& coptions = compile_options{},
+                                          const onnx_options& options = onnx_options{},
+                                          const program_cache& cache = program_cache::from_env());
+
 MIGRAPHX_ONNX_EXPORT std::vector<std::string> get_onnx_operators();
 
+/// Hash of an onnx file for the program cache, with the file_stamp of each external data file
+/// it refers to
+MIGRAPHX_ONNX_EXPORT value hash_onnx_file(const std::string& name);
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
 
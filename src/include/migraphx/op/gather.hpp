@@ -31,10 +31,13 @@
 #include <migraphx/streamutils.hpp>
 #include <migraphx/literal.hpp>
 #include <migraphx/shape_for_each.hpp>
+#include <migraphx/par_for.hpp>
 #include <migraphx/config.hpp>
 #include <migraphx/value.hpp>
 #include <migraphx/op/normalize_attribute.hpp>
+#include <algorithm>
 #include <cmath>
+#include <numeric>
 #include <utility>
 
 namespace migraphx {
@@ -105,6 +108,33 @@ struct gather
         }
     }
 
+    // Copies whole rows for a standard data tensor: everything below the gather axis is
+    // contiguous, so each (outer, index) pair of the output is a single copy. The loop runs
+    // through par, which has the signature of migraphx::par.
+    template <class Output, class Data, class Indices, class Par>
+    void gather_rows(Output output, Data data, Indices indices, Par par) const
+    {
+        auto lens          = data.get_shape().lens();
+        auto axis_dim_size = static_cast<int64_t>(lens[axis]);
+        auto outer         = std::accumulate(
+            lens.begin(), lens.begin() + axis, std::size_t{1}, std::multiplies<>{});
+        auto inner = std::accumulate(
+            lens.begin() + axis + 1, lens.end(), std::size_t{1}, std::multiplies<>{});
+        auto nindices   = indices.get_shape().elements();
+        // keep small rows in larger chunks so scheduling does not dominate the copy
+        auto grain      = std::max<std::size_t>(1, 1024 / std::max<std::size_t>(1, inner));
+        const auto* src = data.data();
+        auto* dst       = output.data();
+        par(outer * nindices, grain, [&, src, dst](std::size_t i) {
+            int64_t in_index = indices[i % nindices];
+            in_index         = (in_index < 0) ? in_index + axis_dim_size : in_index;
+            // don't go out of bounds: https://github.com/ROCm/AMDMIGraphX/issues/2838
+            assert(in_index >= 0 and in_index < axis_dim_size);
+            auto row = (i / nindices) * axis_dim_size + in_index;
+            std::copy(src + row * inner, src + (row + 1) * inner, dst + i * inner);
+        });
+    }
+
     argument compute(const dyn_output& dyn_out, std::vector<argument> args) const
     {
         argument result{dyn_out.computed_shape};
@@ -120,6 +150,10 @@ struct gather
                     in_index      = (in_index < 0) ? in_index + axis_dim_size : in_index;
                     output[0]     = data[in_index];
                 }
+                else if(data.get_shape().standard())
+                {
+                    gather_rows(output, data, indices, migraphx::par{});
+                }
                 else
                 {
                     auto out_lens  = data.get_shape().lens();
@@ -208,10 +208,21 @@ struct gathernd
                         (batch_idx * data_batch_stride) + relative_slice_offset;
                 });
 
-                par_for(num_slices * slice_size, [&](const auto i) {
-                    auto slice_offset = input_slice_offsets[i / slice_size];
-                    output[i]         = data[slice_offset + i % slice_size];
-                });
+                // a slice is contiguous in a standard tensor, so copy it as a whole row
+                if(data_shape.standard())
+                {
+                    par_for(num_slices, [&](const auto i) {
+                        const auto* src = data.data() + input_slice_offsets[i];
+                        std::copy(src, src + slice_size, output.data() + i * slice_size);
+                    });
+                }
+                else
+                {
+                    par_for(num_slices * slice_size, [&](const auto i) {
+                        auto slice_offset = input_slice_offsets[i / slice_size];
+                        output[i]         = data[slice_offset + i % slice_size];
+                    });
+                }
             });
         });
 
@@ -0,0 +1,88 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_OPERATORS_GROUPED_DOT_HPP
+#define MIGRAPHX_GUARD_OPERATORS_GROUPED_DOT_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/config.hpp>
+#include <migraphx/gemm.hpp>
+#include <migraphx/op/dot.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * Independent matrix multiplications with the same shapes. The inputs are the n A matrices
+ * followed by the n B matrices, and the product of the i-th pair is the i-th slice of the first
+ * dimension of the output, so the inputs are never copied into a batch.
+ */
+struct grouped_dot
+{
+    std::string name() const { return "grouped_dot"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.same_type();
+        if(inputs.empty() or inputs.size() % 2 != 0)
+            MIGRAPHX_THROW("GROUPED_DOT: expects pairs of inputs");
+        auto n = inputs.size() / 2;
+        auto a = inputs.front();
+        auto b = inputs.at(n);
+        if(std::any_of(inputs.begin(), inputs.begin() + n, [&](const shape& s) {
+               return s.lens() != a.lens();
+           }) or
+           std::any_of(inputs.begin() + n, inputs.end(), [&](const shape& s) {
+               return s.lens() != b.lens();
+           }))
+            MIGRAPHX_THROW("GROUPED_DOT: every group must have the same shapes");
+        auto out  = dot{}.compute_shape({a, b});
+        auto lens = out.lens();
+        lens.insert(lens.begin(), n);
+        return {out.type(), lens};
+    }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        argument result{output_shape};
+        auto n    = args.size() / 2;
+        auto lens = output_shape.lens();
+        lens.erase(lens.begin());
+        shape group_shape{output_shape.type(), lens};
+        for(std::size_t i = 0; i < n; i++)
+        {
+            argument c{group_shape, result.data() + i * group_shape.bytes()};
+            visit_all(c, args[i], args[n + i])(
+                [&](auto cmat, auto amat, auto bmat) { gemm(cmat, amat, bmat, 1.0f, 0.0f); });
+        }
+        return result;
+    }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
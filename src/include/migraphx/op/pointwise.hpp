@@ -30,6 +30,7 @@
 #include <migraphx/permutation.hpp>
 #include <migraphx/instruction.hpp>
 #include <migraphx/par_for.hpp>
+#include <migraphx/pointwise_executor.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -37,6 +38,16 @@ namespace op {
 
 struct pointwise
 {
+    // The translation of the submodule, which is not shared with copies of the operator
+    pointwise_executor_cache executor_cache{};
+
+    // The cache is not part of the operator's attributes
+    template <class Self, class F>
+    static auto reflect(Self&, F)
+    {
+        return pack();
+    }
+
     std::string name() const { return "pointwise"; }
 
     shape compute_shape(const std::vector<shape>& inputs, std::vector<module_ref> mods) const
@@ -70,8 +81,12 @@ struct pointwise
                      const std::function<std::vector<argument>(
                          module_ref&, const std::unordered_map<std::string, argument>&)>& run) const
     {
+        auto* pm      = mods.front();
+        auto executor = executor_cache.get(*pm);
+        if(executor->context_free)
+            return executor->execute(output_shape, args);
+
         argument output{output_shape};
-        auto* pm    = mods.front();
         auto pnames = pm->get_parameter_names();
         std::sort(pnames.begin(), pnames.end());
 
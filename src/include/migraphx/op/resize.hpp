@@ -31,8 +31,12 @@
 #include <migraphx/streamutils.hpp>
 #include <migraphx/literal.hpp>
 #include <migraphx/shape_for_each.hpp>
+#include <migraphx/float_equal.hpp>
+#include <migraphx/par_for.hpp>
 #include <migraphx/config.hpp>
+#include <algorithm>
 #include <cmath>
+#include <numeric>
 #include <utility>
 
 namespace migraphx {
@@ -41,7 +45,8 @@ namespace op {
 
 /**
  * The Resize operation mirrors the Onnx Resize operation with some differences.
- * Currently, only Nearest mode is supported.  "Axes" and "ROI" attributes not recognized.
+ * Nearest, linear and cubic modes are supported.  "Axes" and "ROI" attributes not recognized,
+ * so the "tf_crop_and_resize" coordinate transformation is not available.
  *
  * Accepts either one or two runtime inputs.
  * Input 0 - data to be resized
@@ -124,16 +129,37 @@ struct resize
         return idx_ops.at(s_mode);
     }
 
+    // Cubic convolution coefficients for a fractional offset s from the tap left of the sample
+    // point, for the four taps at offsets -1, 0, 1 and 2.
+    static std::array<double, 4> get_cubic_coeffs(double s, double a)
+    {
+        auto far  = [&](double x) { return ((a * x - 5 * a) * x + 8 * a) * x - 4 * a; };
+        auto near = [&](double x) { return ((a + 2) * x - (a + 3)) * x * x + 1; };
+        return {far(s + 1), near(s), near(1 - s), far(2 - s)};
+    }
+
+    // The input indices and weights that contribute to each output index along one axis.
+    // Taps that fall outside the input are clamped to the edge.
+    struct axis_taps
+    {
+        std::size_t ntaps = 0;
+        std::vector<std::size_t> indices;
+        std::vector<double> weights;
+    };
+
     std::vector<float> scales;
     std::vector<size_t> sizes;
     // what integer rounding rule to use with Nearest mode.
     std::string nearest_mode;
 
-    // Resizing modes.  1: nearest 2: bilinear/linear 3: cubic
-    // Only "nearest" currently supported.
+    // Resizing modes: "nearest", "linear" (bilinear, trilinear, ...) or "cubic"
     std::string mode{"nearest"};
     // What floating-point conversion rule to use (any resizing mode)
     std::string coordinate_transformation_mode;
+    // The "a" coefficient of the cubic convolution kernel (cubic mode)
+    float cubic_coeff_a = -0.75f;
+    // Drop and renormalize the weights of taps that fall outside the input (cubic mode)
+    bool exclude_outside = false;
 
     std::string name() const { return "resize"; }
 
@@ -144,15 +170,17 @@ struct resize
                     f(self.sizes, "sizes"),
                     f(self.nearest_mode, "nearest_mode"),
                     f(self.mode, "mode"),
-                    f(self.coordinate_transformation_mode, "coordinate_transformation_mode"));
+                    f(self.coordinate_transformation_mode, "coordinate_transformation_mode"),
+                    f(self.cubic_coeff_a, "cubic_coeff_a"),
+                    f(self.exclude_outside, "exclude_outside"));
     }
 
     shape compute_shape(std::vector<shape> inputs) const
     {
         check_shapes{inputs, *this, true}.has(1, 2);
 
-        if(mode != "nearest")
-            MIGRAPHX_THROW("RESIZE: Only Nearest mode is supported");
+        if(not contains({"nearest", "linear", "cubic"}, mode))
+            MIGRAPHX_THROW("RESIZE: mode " + mode + " not supported!");
 
         // Inputs are X, sizes or scale, ROI and axes not supported.
         if(inputs.size() == 1)
@@ -283,6 +311,9 @@ struct resize
         }
 
         shape output_shape = {args[0].get_shape().type(), out_lens};
+        if(mode != "nearest")
+            return interpolate(output_shape, args[0], vec_scale);
+
         argument result{output_shape};
         auto nearest_op = get_nearest_op(nearest_mode);
         auto idx_op     = get_original_idx_op(coordinate_transformation_mode);
@@ -302,6 +333,119 @@ struct resize
         });
         return result;
     }
+
+    // Computes the linear or cubic taps of one axis.  Returns no taps when every output index
+    // maps exactly onto the same input index, so the axis can be skipped.
+    axis_taps get_axis_taps(std::size_t l_in, std::size_t l_out, double scale) const
+    {
+        auto idx_op = get_original_idx_op(coordinate_transformation_mode);
+        axis_taps result;
+        if(l_in == l_out)
+        {
+            bool identity = true;
+            for(std::size_t i = 0; i < l_out and identity; ++i)
+                identity = float_equal(idx_op(l_in, l_out, i, scale), static_cast<double>(i));
+            if(identity)
+                return result;
+        }
+
+        result.ntaps = (mode == "cubic") ? 4 : 2;
+        result.indices.resize(l_out * result.ntaps);
+        result.weights.resize(l_out * result.ntaps);
+        auto last = static_cast<std::ptrdiff_t>(l_in) - 1;
+        for(std::size_t i = 0; i < l_out; ++i)
+        {
+            auto* indices = result.indices.data() + i * result.ntaps;
+            auto* weights = result.weights.data() + i * result.ntaps;
+            auto x        = idx_op(l_in, l_out, i, scale);
+            if(mode == "linear")
+            {
+                x          = std::max(0.0, std::min<double>(last, x));
+                auto lo    = static_cast<std::ptrdiff_t>(std::floor(x));
+                indices[0] = lo;
+                indices[1] = std::min(lo + 1, last);
+                weights[1] = x - lo;
+                weights[0] = 1.0 - weights[1];
+                continue;
+            }
+            auto base   = static_cast<std::ptrdiff_t>(std::floor(x));
+            auto coeffs = get_cubic_coeffs(x - base, cubic_coeff_a);
+            double sum  = 0;
+            for(std::size_t k = 0; k < 4; ++k)
+            {
+                auto idx = base - 1 + static_cast<std::ptrdiff_t>(k);
+                if(exclude_outside and (idx < 0 or idx > last))
+                    coeffs[k] = 0;
+                indices[k] = std::max<std::ptrdiff_t>(0, std::min(idx, last));
+                weights[k] = coeffs[k];
+                sum += coeffs[k];
+            }
+            if(exclude_outside and sum != 0)
+                std::transform(weights, weights + 4, weights, [&](auto w) { return w / sum; });
+        }
+        return result;
+    }
+
+    // Separable linear/cubic interpolation: each resized axis is interpolated in its own pass
+    // over a dense intermediate buffer, instead of gathering all 2^n (or 4^n) neighbors of
+    // every output element at once.
+    argument interpolate(const shape& output_shape,
+                         const argument& data,
+                         const std::vector<float>& vec_scale) const
+    {
+        auto lens            = data.get_shape().lens();
+        const auto& out_lens = output_shape.lens();
+        std::vector<axis_taps> taps(lens.size());
+        std::vector<std::size_t> axes;
+        for(std::size_t axis = 0; axis < lens.size(); ++axis)
+        {
+            taps[axis] = get_axis_taps(lens[axis], out_lens[axis], vec_scale[axis]);
+            if(taps[axis].ntaps > 0)
+                axes.push_back(axis);
+        }
+        // Shrink first so that later passes run over as few elements as possible
+        std::stable_sort(axes.begin(), axes.end(), [&](auto a, auto b) {
+            return out_lens[a] * lens[b] < out_lens[b] * lens[a];
+        });
+
+        argument result{output_shape};
+        visit_all(result, data)([&](auto output, auto input) {
+            using type = typename decltype(output)::value_type;
+            std::vector<double> buffer(input.get_shape().elements());
+            std::transform(input.begin(), input.end(), buffer.begin(), [](auto x) {
+                return static_cast<double>(x);
+            });
+            for(auto axis : axes)
+            {
+                const auto& t = taps[axis];
+                auto l_in     = lens[axis];
+                auto l_out    = out_lens[axis];
+                auto outer    = std::accumulate(
+                    lens.begin(), lens.begin() + axis, std::size_t{1}, std::multiplies<>{});
+                auto inner = std::accumulate(
+                    lens.begin() + axis + 1, lens.end(), std::size_t{1}, std::multiplies<>{});
+                std::vector<double> next(outer * l_out * inner, 0.0);
+                par_for(outer * l_out, [&](auto i) {
+                    auto* dst       = next.data() + i * inner;
+                    const auto* src = buffer.data() + (i / l_out) * l_in * inner;
+                    auto j          = i % l_out;
+                    for(std::size_t k = 0; k < t.ntaps; ++k)
+                    {
+                        auto w          = t.weights[j * t.ntaps + k];
+                        const auto* row = src + t.indices[j * t.ntaps + k] * inner;
+                        for(std::size_t e = 0; e < inner; ++e)
+                            dst[e] += w * row[e];
+                    }
+                });
+                buffer     = std::move(next);
+                lens[axis] = l_out;
+            }
+            std::transform(buffer.begin(), buffer.end(), output.begin(), [](auto x) {
+                return static_cast<type>(x);
+            });
+        });
+        return result;
+    }
 };
 
 } // namespace op
@@ -27,11 +27,14 @@
 #include <array>
 #include <migraphx/check_shapes.hpp>
 #include <migraphx/shape_for_each.hpp>
+#include <migraphx/par_for.hpp>
 #include <migraphx/config.hpp>
 #include <migraphx/value.hpp>
 #include <migraphx/op/name.hpp>
 #include <migraphx/op/normalize_attribute.hpp>
 #include <migraphx/argument.hpp>
+#include <algorithm>
+#include <numeric>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -68,37 +71,60 @@ struct scatter_op : op_name<Derived>
         return inputs.front().with_lens(inputs.front().lens());
     }
 
+    // Applies the updates to an output that already holds the data.  Elements that differ in
+    // any coordinate other than the axis can never land on the same output element, so every
+    // line along the axis is an independent partition: lines run in parallel and each line is
+    // applied in order, which keeps duplicate indices deterministic without atomics.  The
+    // lines run through par, which has the signature of migraphx::par.
+    template <class Output, class Indices, class Updates, class Par>
+    void scatter_lines(Output output, Indices indices, Updates updates, Par par) const
+    {
+        auto ind_s         = indices.get_shape();
+        auto axis_len      = ind_s.lens()[axis];
+        auto axis_dim_size = static_cast<int64_t>(output.get_shape().lens()[axis]);
+        auto line_lens     = ind_s.lens();
+        line_lens[axis]    = 1;
+        shape line_s{ind_s.type(), line_lens};
+
+        const auto& out_strides = output.get_shape().strides();
+        const auto& ind_strides = ind_s.strides();
+        const auto& upd_strides = updates.get_shape().strides();
+        auto dot                = [](const auto& idx, const auto& strides) {
+            return std::inner_product(idx.begin(), idx.end(), strides.begin(), std::size_t{0});
+        };
+        auto* out_ptr       = output.data();
+        const auto* ind_ptr = indices.data();
+        const auto* upd_ptr = updates.data();
+        auto reduce         = derived().reduction();
+        // Give each task about 1024 updates
+        auto grain = std::max<std::size_t>(1, 1024 / std::max<std::size_t>(1, axis_len));
+        par(line_s.elements(), grain, [&](std::size_t l) {
+            auto idx      = line_s.multi(l);
+            auto out_base = dot(idx, out_strides);
+            auto ind_base = dot(idx, ind_strides);
+            auto upd_base = dot(idx, upd_strides);
+            for(std::size_t j = 0; j < axis_len; ++j)
+            {
+                int64_t index = ind_ptr[ind_base + j * ind_strides[axis]];
+                // normalize negative indexes (may be redundant after using
+                // normalize_compute_shape())
+                index = (index < 0) ? index + axis_dim_size : index;
+                reduce(out_ptr[out_base + index * out_strides[axis]],
+                       upd_ptr[upd_base + j * upd_strides[axis]]);
+            }
+        });
+    }
+
     argument compute(const shape& output_shape, std::vector<argument> args) const
     {
         argument result{output_shape};
 
-        // max dimension in each axis
-        auto axis_dim_size = output_shape.lens()[axis];
         // cast all arguments as correct type
         visit_all(result, args[0], args[2])([&](auto output, auto data, auto update) {
             // copy all of data to output
             std::copy(data.begin(), data.end(), output.begin());
             args[1].visit([&](auto indices) {
-                auto ind_s = indices.get_shape();
-                // iterate through items in shape
-                shape_for_each(ind_s, [&](const auto& idx) {
-                    auto out_idx = idx;
-
-                    // Overloaded tensor_view::() invokes indexing logic of
-                    // std::size_t shape::index(std::size_t i) const
-                    // which handles nonstandard shapes correctly
-                    auto index = indices(idx.begin(), idx.end());
-
-                    // normalize negative indexes (may be redundant after using
-                    // normalize_compute_shape())
-                    index         = (index < 0) ? index + axis_dim_size : index;
-                    out_idx[axis] = index;
-
-                    // look up the appropriate locations in output, using idx and out_idx.
-                    // call reduction() method of derived struct to copy and reduce that element
-                    derived().reduction()(output(out_idx.begin(), out_idx.end()),
-                                          update(idx.begin(), idx.end()));
-                });
+                scatter_lines(output, indices, update, migraphx::par{});
             });
         });
 
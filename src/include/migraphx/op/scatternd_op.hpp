@@ -29,6 +29,8 @@
 #include <migraphx/argument.hpp>
 #include <migraphx/par_for.hpp>
 #include <migraphx/ranges.hpp>
+#include <algorithm>
+#include <numeric>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -110,36 +112,67 @@ struct scatternd_op : op_name<Derived>
         }
     }
 
+    /** Applies the updates to an output that already holds the data.  Every index
+     * tuple selects a contiguous slice of the output.  Updates are grouped by the slice they
+     * write to, groups run in parallel and each group is applied in its original order, so
+     * duplicate indices reduce deterministically without atomics.  The groups run through par,
+     * which has the signature of migraphx::par.
+     */
+    template <class Output, class Indices, class Updates, class Par>
+    void scatter_slices(Output output, Indices indices, Updates updates, Par par) const
+    {
+        auto& self           = static_cast<const Derived&>(*this);
+        const auto& lens     = output.get_shape().lens();
+        const auto& ind_lens = indices.get_shape().lens();
+        auto k               = ind_lens.back();
+        auto num_updates     = std::accumulate(
+            ind_lens.begin(), ind_lens.end() - 1, std::size_t{1}, std::multiplies<>{});
+        auto slice_size = std::accumulate(
+            lens.begin() + k, lens.end(), std::size_t{1}, std::multiplies<>{});
+        std::vector<std::size_t> offsets(num_updates);
+        par(num_updates, 1024, [&](std::size_t u) {
+            std::size_t offset = 0;
+            for(std::size_t d = 0; d < k; ++d)
+            {
+                int64_t index = indices[u * k + d];
+                index         = (index < 0) ? index + static_cast<int64_t>(lens[d]) : index;
+                offset        = offset * lens[d] + index;
+            }
+            offsets[u] = offset * slice_size;
+        });
+
+        std::vector<std::size_t> order(num_updates);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](auto a, auto b) {
+            return offsets[a] < offsets[b];
+        });
+        std::vector<std::size_t> groups;
+        for(std::size_t i = 0; i < num_updates; ++i)
+        {
+            if(i == 0 or offsets[order[i]] != offsets[order[i - 1]])
+                groups.push_back(i);
+        }
+        groups.push_back(num_updates);
+
+        auto reduce = self.reduction();
+        auto grain  = std::max<std::size_t>(1, 1024 / std::max<std::size_t>(1, slice_size));
+        par(groups.size() - 1, grain, [&](std::size_t g) {
+            for(auto i = groups[g]; i < groups[g + 1]; ++i)
+            {
+                auto u = order[i];
+                for(std::size_t e = 0; e < slice_size; ++e)
+                    reduce(output[offsets[u] + e], updates[u * slice_size + e]);
+            }
+        });
+    }
+
     argument compute(const dyn_output& dyn_out, std::vector<argument> args) const
     {
         argument result{dyn_out.computed_shape};
-        auto& self = static_cast<const Derived&>(*this);
         visit_all(result, args[0], args[2])([&](auto output, auto data, auto updates) {
             std::copy(data.begin(), data.end(), output.begin());
             args[1].visit([&](auto indices) {
-                auto updates_shape = updates.get_shape();
-                auto updates_std   = shape{updates_shape.type(), updates_shape.lens()};
-                auto indices_shape = indices.get_shape();
-                auto k             = indices_shape.lens().back();
-                auto q             = indices_shape.ndim();
-                auto r             = dyn_out.computed_shape.ndim();
-                for(auto i = 0u; i < updates_shape.elements(); ++i)
-                {
-                    auto updates_idx = updates_std.multi(i);
-                    std::vector<std::size_t> indices_idx(q, 0);
-                    std::copy(
-                        updates_idx.begin(), updates_idx.begin() + (q - 1), indices_idx.begin());
-                    auto index_start = indices.begin() +
-                                       indices_shape.index(indices_idx.begin(), indices_idx.end());
-                    auto index_end = index_start + k;
-
-                    std::vector<std::size_t> out_idx(r, 0);
-                    std::copy(index_start, index_end, out_idx.begin());
-                    std::copy(
-                        updates_idx.begin() + (q - 1), updates_idx.end(), out_idx.begin() + k);
-
-                    self.reduction()(output[dyn_out.computed_shape.index(out_idx)], updates[i]);
-                }
+                scatter_slices(output, indices, updates, migraphx::par{});
             });
         });
 
@@ -43,6 +43,20 @@ void par_for(std::size_t n, std::size_t, F f)
     par_for(n, f);
 }
 
+/**
+ * Runs f(i) for every i in [0, n), possibly in parallel, with at least grain iterations per
+ * task. Kernels shared between targets take the loop as a parameter with this signature, so the
+ * reference ops pass par{} and a target can pass its own thread pool instead.
+ */
+struct par
+{
+    template <class F>
+    void operator()(std::size_t n, std::size_t grain, F f) const
+    {
+        par_for(n, grain, f);
+    }
+};
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
 
@@ -26,6 +26,7 @@
 
 #include <migraphx/config.hpp>
 #include <migraphx/pass.hpp>
+#include <migraphx/pass_profiler.hpp>
 #include <migraphx/module_ref.hpp>
 #include <migraphx/tracer.hpp>
 #include <vector>
@@ -51,11 +52,16 @@ struct module_pass_manager
 MIGRAPHX_EXPORT void run_passes(program& prog,
                                 module_ref root_mod,
                                 const std::vector<pass>& passes,
-                                tracer trace = tracer{});
-MIGRAPHX_EXPORT void
-run_passes(module& mod, const std::vector<pass>& passes, tracer trace = tracer{});
-MIGRAPHX_EXPORT void
-run_passes(program& prog, const std::vector<pass>& passes, tracer trace = tracer{});
+                                tracer trace           = tracer{},
+                                pass_profiler profiler = pass_profiler{});
+MIGRAPHX_EXPORT void run_passes(module& mod,
+                                const std::vector<pass>& passes,
+                                tracer trace           = tracer{},
+                                pass_profiler profiler = pass_profiler{});
+MIGRAPHX_EXPORT void run_passes(program& prog,
+                                const std::vector<pass>& passes,
+                                tracer trace           = tracer{},
+                                pass_profiler profiler = pass_profiler{});
 
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
@@ -0,0 +1,115 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_PASS_PROFILER_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_PASS_PROFILER_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/functional.hpp>
+#include <migraphx/value.hpp>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/// Counters updated while a pass is running, used to attribute work to a pass
+struct pass_counters
+{
+    std::size_t matcher_hits          = 0;
+    std::size_t inserted_instructions = 0;
+    /// Number of profiled passes currently running on this thread
+    std::size_t depth = 0;
+    /// Inclusive totals of the passes run from within the current pass, which
+    /// are subtracted so that nested passes are not counted twice
+    double nested_ms                         = 0;
+    std::size_t nested_matcher_hits          = 0;
+    std::size_t nested_inserted_instructions = 0;
+};
+
+/// Get the counters for the current thread
+MIGRAPHX_EXPORT pass_counters& get_pass_counters();
+
+/// Statistics collected for one pass applied to one module
+struct pass_record
+{
+    std::string pass;
+    std::string module;
+    /// Time spent in the pass, excluding the passes it ran itself
+    double ms                       = 0;
+    std::size_t instructions_before = 0;
+    std::size_t instructions_after  = 0;
+    std::size_t matcher_hits        = 0;
+    /// Number of instructions inserted into any module while the pass ran
+    std::size_t inserted_instructions = 0;
+    /// Nesting level, 0 for a pass run by the pass manager and 1 or more for a
+    /// pass run from within another pass
+    std::size_t depth = 0;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.pass, "pass"),
+                    f(self.module, "module"),
+                    f(self.ms, "ms"),
+                    f(self.instructions_before, "instructions_before"),
+                    f(self.instructions_after, "instructions_after"),
+                    f(self.matcher_hits, "matcher_hits"),
+                    f(self.inserted_instructions, "inserted_instructions"),
+                    f(self.depth, "depth"));
+    }
+};
+
+/**
+ * Collects a pass_record for every pass run on every module during compilation.
+ * Copies share the same records, so it can be passed by value through
+ * compile_options and read back after `program::compile` returns.
+ */
+struct MIGRAPHX_EXPORT pass_profiler
+{
+    pass_profiler() = default;
+
+    static pass_profiler create();
+
+    bool enabled() const { return records != nullptr; }
+
+    void add(pass_record r) const;
+
+    const std::vector<pass_record>& get_records() const;
+
+    /// Records as a list of objects, suitable for `to_json_string`
+    value to_value() const;
+
+    /// Print the totals for each pass, sorted by time
+    void print(std::ostream& os) const;
+
+    private:
+    std::shared_ptr<std::vector<pass_record>> records = nullptr;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif // MIGRAPHX_GUARD_MIGRAPHX_PASS_PROFILER_HPP
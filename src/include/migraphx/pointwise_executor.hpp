@@ -0,0 +1,89 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_POINTWISE_EXECUTOR_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_POINTWISE_EXECUTOR_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/module_ref.hpp>
+#include <migraphx/operation.hpp>
+#include <migraphx/shape.hpp>
+#include <memory>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/**
+ * Evaluates a pointwise submodule over blocks of elements. The submodule is translated once into
+ * a list of steps over registers, where each register holds a block of values. Each step then
+ * computes its operator over a whole block instead of one scalar at a time.
+ */
+struct MIGRAPHX_EXPORT pointwise_executor
+{
+    struct step
+    {
+        operation op;
+        std::vector<std::size_t> inputs;
+        std::size_t output;
+        shape::type_t type;
+    };
+
+    // Register of each parameter, in the order of the sorted parameter names
+    std::vector<std::size_t> parameters;
+    std::vector<std::pair<std::size_t, literal>> literals;
+    std::vector<step> steps;
+    std::size_t registers = 0;
+    std::size_t output    = 0;
+    // Lowered operators need a context, so they can only be evaluated with the module
+    bool context_free = true;
+
+    static pointwise_executor translate(const module& m);
+
+    argument execute(const shape& output_shape, const std::vector<argument>& args) const;
+};
+
+/**
+ * The translation of the submodule of one pointwise instruction. A copy of the operator, as made
+ * by make_op or when copying a module, starts out empty, so the translation is owned by the
+ * instruction and freed with it. It is translated again when the submodule has changed since.
+ */
+struct MIGRAPHX_EXPORT pointwise_executor_cache
+{
+    pointwise_executor_cache() = default;
+    pointwise_executor_cache(const pointwise_executor_cache&);
+    pointwise_executor_cache& operator=(const pointwise_executor_cache&);
+
+    std::shared_ptr<const pointwise_executor> get(const module& m) const;
+
+    private:
+    struct entry;
+    // Updated atomically, so evaluating the instruction from several threads needs no lock
+    mutable std::shared_ptr<const entry> current = nullptr;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_MIGRAPHX_POINTWISE_EXECUTOR_HPP
@@ -0,0 +1,87 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_PROGRAM_CACHE_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_PROGRAM_CACHE_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/compile_options.hpp>
+#include <migraphx/filesystem.hpp>
+#include <migraphx/optional.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/target.hpp>
+#include <migraphx/value.hpp>
+#include <functional>
+#include <string>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/**
+ * Compiled programs stored as .mxr files in a directory, so later processes can load a program
+ * instead of parsing and compiling the model again. A program is keyed by a SHA-256 digest of
+ * the model, the target with its context, the compile options and the MIGraphX version. Once the
+ * files in the directory grow past max_size, the least recently used ones are removed.
+ */
+struct MIGRAPHX_EXPORT program_cache
+{
+    /// Directory of the cached programs, the cache is disabled when it is empty
+    std::string dir = "";
+    /// Bytes the directory is kept under, 0 does not limit it
+    std::size_t max_size = 0;
+
+    /// The cache at MIGRAPHX_PROGRAM_CACHE_DIR, limited to MIGRAPHX_PROGRAM_CACHE_MAX_SIZE MB
+    static program_cache from_env();
+
+    bool enabled() const { return not dir.empty(); }
+
+    /// Key for the program described by the model value once compiled for the target
+    std::string
+    get_key(const value& model, const target& t, const compile_options& options = {}) const;
+
+    /// Load the program stored for the key, a file that can't be loaded is removed
+    optional<program> load(const std::string& key) const;
+
+    /// Store the program for the key, then remove the least recently used programs
+    void store(const std::string& key, const program& p) const;
+
+    /**
+     * Load the program stored for the model, or create it with parse, compile it and store
+     * it. Without a cache directory the program is always parsed and compiled.
+     */
+    program compile(const value& model,
+                    const std::function<program()>& parse,
+                    const target& t,
+                    const compile_options& options = {}) const;
+};
+
+/// SHA-256 digest of the contents of a file
+MIGRAPHX_EXPORT std::string hash_file(const fs::path& p);
+
+/// Path, size and modification time of a file, which change when the file is rewritten, without
+/// reading it
+MIGRAPHX_EXPORT value file_stamp(const fs::path& p);
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_MIGRAPHX_PROGRAM_CACHE_HPP
@@ -39,6 +39,13 @@ struct module;
 struct MIGRAPHX_EXPORT propagate_constant
 {
     std::unordered_set<std::string> skip_ops = {};
+    /// Fold the constants in waves that use at most this many bytes, and remove the folded
+    /// instructions after each wave. When 0, MIGRAPHX_CONST_FOLD_MAX_MEMORY is used (in MB), and
+    /// everything is folded at once when that is not set either.
+    std::size_t max_memory = 0;
+    /// Directory where the folded literals are cached, keyed by a SHA-256 digest of the
+    /// instructions that compute them. When empty, MIGRAPHX_CONST_FOLD_CACHE_DIR is used.
+    std::string cache_dir = "";
     std::string name() const { return "propagate_constant"; }
     void apply(module& m) const;
 };
@@ -32,6 +32,7 @@
 #include <migraphx/target.hpp>
 #include <migraphx/program.hpp>
 #include <migraphx/env.hpp>
+#include <migraphx/calibration.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -41,13 +42,19 @@ struct program;
 MIGRAPHX_EXPORT void quantize_fp16(program& prog,
                                    const std::vector<std::string>& ins_names = {"all"});
 
+MIGRAPHX_EXPORT void quantize_bf16(program& prog,
+                                   const std::vector<std::string>& ins_names = {"all"});
+
 MIGRAPHX_EXPORT void quantize_int8(program& prog,
                                    const target& t,
                                    const std::vector<parameter_map>& calibration,
                                    const std::unordered_set<std::string>& ins_names = {
-                                       "dot", "convolution"});
-MIGRAPHX_EXPORT void
-quantize_fp8(program& prog, const target& t, const std::vector<parameter_map>& calibration);
+                                       "dot", "convolution"},
+                                   const calibration_options& options = {});
+MIGRAPHX_EXPORT void quantize_fp8(program& prog,
+                                  const target& t,
+                                  const std::vector<parameter_map>& calibration,
+                                  const calibration_options& options = {});
 
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
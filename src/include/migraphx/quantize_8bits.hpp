@@ -56,6 +56,8 @@ struct MIGRAPHX_EXPORT quantize_8bits_pass
 {
     shape::type_t precision = shape::int8_type;
     std::vector<std::pair<float, float>> quant_params;
+    // Quantize constant weights of convolution and dot with one scale per output channel
+    bool per_channel = false;
     std::string name() const { return "quantize_8bits"; }
     void apply(module& m) const;
 };
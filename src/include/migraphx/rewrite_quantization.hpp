@@ -24,8 +24,10 @@
 #ifndef MIGRAPHX_GUARD_RTGLIB_REWRITE_QUANTIZATION_HPP
 #define MIGRAPHX_GUARD_RTGLIB_REWRITE_QUANTIZATION_HPP
 
+#include <set>
 #include <string>
 #include <migraphx/config.hpp>
+#include <migraphx/shape.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -37,6 +39,8 @@ struct module;
  */
 struct MIGRAPHX_EXPORT rewrite_quantization
 {
+    // Quantized types that are left for the target to lower
+    std::set<shape::type_t> skip_types = {};
     std::string name() const { return "rewrite_quantization"; }
     void apply(module& m) const;
 };
@@ -0,0 +1,64 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_SHA256_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_SHA256_HPP
+
+#include <migraphx/config.hpp>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/**
+ * SHA-256 digest of a stream of bytes. Unlike std::hash, two different inputs are not expected
+ * to ever give the same digest, so it can be used alone as the key of a file on disk.
+ */
+struct MIGRAPHX_EXPORT sha256
+{
+    sha256();
+
+    void update(const char* data, std::size_t n);
+    void update(std::string_view s) { update(s.data(), s.size()); }
+
+    /// The digest as 64 hex characters, no more data can be added afterwards
+    std::string hex_digest();
+
+    private:
+    void compress(const unsigned char* block);
+
+    std::array<std::uint32_t, 8> state;
+    std::array<unsigned char, 64> buffer{};
+    std::size_t buffered = 0;
+    std::uint64_t length = 0;
+};
+
+/// Hex SHA-256 digest of the bytes
+MIGRAPHX_EXPORT std::string sha256_hex(std::string_view s);
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_MIGRAPHX_SHA256_HPP
@@ -33,6 +33,9 @@
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
+/// A name starting with prefix that is unique across processes and threads
+MIGRAPHX_EXPORT std::string unique_string(const std::string& prefix);
+
 struct MIGRAPHX_EXPORT tmp_dir
 {
     fs::path path;
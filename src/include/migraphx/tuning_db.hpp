@@ -0,0 +1,60 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_TUNING_DB_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_TUNING_DB_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/filesystem.hpp>
+#include <migraphx/optional.hpp>
+#include <migraphx/sqlite.hpp>
+#include <migraphx/value.hpp>
+#include <string>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/**
+ * Solutions found by tuning, stored in a sqlite database keyed by the name of the tuned op and
+ * its problem as in the gpu problem_cache, so later compiles can reuse them without benchmarking
+ * again. The MIOpen perf_db schema read by the gpu target only describes convolutions, so it is
+ * not used here.
+ */
+struct MIGRAPHX_EXPORT tuning_db
+{
+    tuning_db() = default;
+    /// Open the database at the path, creating it when it does not exist
+    static tuning_db open(const fs::path& p);
+    /// Open the existing database at the path without writing to it
+    static tuning_db read(const fs::path& p);
+
+    optional<value> get(const std::string& name, const value& problem);
+    void insert(const std::string& name, const value& problem, const value& solution);
+
+    private:
+    sqlite db;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_MIGRAPHX_TUNING_DB_HPP
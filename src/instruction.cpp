@@ -26,6 +26,7 @@
 #include <migraphx/erase.hpp>
 #include <migraphx/module.hpp>
 #include <migraphx/ranges.hpp>
+#include <atomic>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -57,10 +58,33 @@ instruction::instruction(literal l)
 {
 }
 
+static std::atomic<std::size_t>& version_counter()
+{
+    static std::atomic<std::size_t> counter{0};
+    return counter;
+}
+
+instruction::version_stamp::version_stamp() : value(version_counter()++) {}
+
+instruction::version_stamp::version_stamp(const version_stamp&) : value(version_counter()++) {}
+
+instruction::version_stamp& instruction::version_stamp::operator=(const version_stamp&)
+{
+    value = version_counter()++;
+    return *this;
+}
+
+std::size_t instruction::get_version() const { return version.value; }
+
+std::size_t instruction::next_version() { return version_counter(); }
+
+void instruction::touch() { version.value = version_counter()++; }
+
 void instruction::replace(const shape& r)
 {
     if(r != result)
     {
+        touch();
         result = r;
         for(auto&& ins : output)
         {
@@ -74,6 +98,7 @@ void instruction::replace(operation o)
 {
     normalized = false;
     op         = std::move(o);
+    touch();
     recompute_shape();
 }
 
@@ -87,6 +112,7 @@ void instruction::clear_arguments()
     }
     arguments.clear();
     module_args.clear();
+    touch();
 }
 
 bool operator==(const instruction& i, instruction_ref ref)
@@ -181,7 +207,10 @@ bool operator!=(instruction_ref ref, const instruction& i) { return not(i == ref
 void instruction::add_output(instruction_ref ins)
 {
     if(std::find_if(output.begin(), output.end(), equal_to(ins)) == output.end())
+    {
         output.push_back(ins);
+        touch();
+    }
 }
 
 void instruction::backreference(instruction_ref ref)
@@ -288,12 +317,14 @@ void instruction::replace_argument(instruction_ref old, instruction_ref new_ins)
     assert(std::any_of(arguments.begin(), arguments.end(), equal_to(old)));
     std::replace_if(arguments.begin(), arguments.end(), equal_to(old), new_ins);
     old->remove_output(*this);
+    touch();
 }
 
 void instruction::replace_mod_argument(module_ref old, module_ref new_mod)
 {
     assert(std::any_of(module_args.begin(), module_args.end(), [&](auto i) { return i == old; }));
     std::replace(module_args.begin(), module_args.end(), old, new_mod);
+    touch();
 }
 
 bool instruction::is_undefined() const
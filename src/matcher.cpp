@@ -0,0 +1,101 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/matcher.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <algorithm>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+namespace match {
+
+void match_worklist::start() { version = instruction::next_version(); }
+
+void match_worklist::update(const module& m)
+{
+    visit.clear();
+    changed.clear();
+    std::vector<instruction_ref> stack;
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->get_version() < version)
+            continue;
+        stack.push_back(ins);
+        visit.insert(ins->inputs().begin(), ins->inputs().end());
+    }
+    std::unordered_set<instruction_ref> used;
+    while(not stack.empty())
+    {
+        auto ins = stack.back();
+        stack.pop_back();
+        if(not used.insert(ins).second)
+            continue;
+        visit.insert(ins);
+        stack.insert(stack.end(), ins->outputs().begin(), ins->outputs().end());
+    }
+}
+
+bool match_worklist::empty() const { return visit.empty(); }
+
+bool match_worklist::contains(instruction_ref ins) const { return visit.count(ins) > 0; }
+
+bool match_worklist::next(instruction_ref ins)
+{
+    if(ins->get_version() >= version or
+       std::any_of(ins->inputs().begin(), ins->inputs().end(), [&](instruction_ref input) {
+           return changed.count(input) > 0;
+       }))
+    {
+        changed.insert(ins);
+        return true;
+    }
+    return contains(ins);
+}
+
+void find_matches_worklist_for(module& m,
+                               std::size_t sweeps,
+                               const std::function<void(instruction_ref)>& f)
+{
+    match_worklist worklist;
+    for(std::size_t i = 0; i < sweeps; i++)
+    {
+        worklist.start();
+        for(auto ins : iterator_for(m))
+        {
+            if(i > 0 and not worklist.next(ins))
+                continue;
+            f(ins);
+        }
+        dead_code_elimination{}.apply(m);
+        worklist.update(m);
+        if(worklist.empty())
+            break;
+    }
+}
+
+} // namespace match
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
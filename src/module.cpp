@@ -32,9 +32,11 @@
 #include <migraphx/iterator_for.hpp>
 #include <migraphx/iterator.hpp>
 #include <migraphx/pass_manager.hpp>
+#include <migraphx/pass_profiler.hpp>
 #include <migraphx/make_op.hpp>
 #include <migraphx/register_target.hpp>
 #include <migraphx/json.hpp>
+#include <atomic>
 #include <iostream>
 #include <sstream>
 #include <algorithm>
@@ -47,12 +49,19 @@ inline namespace MIGRAPHX_INLINE_NS {
 
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_FINALIZE)
 
+static std::size_t next_module_id()
+{
+    static std::atomic<std::size_t> id{0};
+    return id++;
+}
+
 struct module_impl
 {
     // A list is used to keep references to an instruction stable
     std::list<instruction> instructions;
     std::unordered_set<instruction*> instruction_set;
     std::string name;
+    std::size_t id = next_module_id();
     uint32_t nparams = 0;
     bool bypass      = false;
 
@@ -69,6 +78,7 @@ struct module_impl
         // cppcheck-suppress redundantInitialization
         auto r = instructions.emplace(pos, std::forward<Ts>(xs)...);
         instruction_set.insert(std::addressof(*r));
+        get_pass_counters().inserted_instructions++;
         return r;
     }
     instruction_ref insert(instruction_ref pos, const instruction& ins)
@@ -134,6 +144,8 @@ module& module::operator=(module m)
 
 std::string module::name() const { return impl->name; }
 
+std::size_t module::id() const { return impl->id; }
+
 void module::set_name(const std::string& name) { impl->name = name; }
 
 bool module::bypass() const { return impl->bypass; }
@@ -144,7 +156,8 @@ void module::assign(const module& m)
     // copy the impl
     if(not impl)
         impl = std::make_unique<module_impl>();
-    *impl = *m.impl;
+    *impl    = *m.impl;
+    impl->id = next_module_id();
 
     // clear instructions
     if(not impl->instructions.empty())
@@ -192,6 +205,7 @@ void module::assign(const module& m)
             else
             {
                 copy_ins = add_instruction(ins->get_operator(), copy_inputs, module_args);
+                copy_ins->set_normalized(ins->is_normalized());
             }
         }
 
@@ -247,6 +261,10 @@ insert_generic_instructions(module& m,
             }
 
             copy_ins = m.insert_instruction(ins, sins->get_operator(), copy_inputs, mod_args);
+            // Callers can map the inputs to other shapes, such as scalars to full tensors, and
+            // then the attributes need to be normalized again
+            if(to_shapes(copy_inputs) == to_shapes(inputs))
+                copy_ins->set_normalized(sins->is_normalized());
         }
         map_ins[sins] = copy_ins;
     }
@@ -0,0 +1,166 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/numa.hpp>
+#include <migraphx/filesystem.hpp>
+#include <migraphx/stringutils.hpp>
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+static fs::path numa_node_path(std::size_t node)
+{
+    return fs::path{"/sys/devices/system/node"} / ("node" + std::to_string(node));
+}
+
+// Parse a list of cpus such as "0-3,8-11"
+static std::vector<std::size_t> parse_cpu_list(const std::string& s)
+{
+    std::vector<std::size_t> result;
+    for(const auto& r : split_string(trim(s), ','))
+    {
+        if(r.empty())
+            continue;
+        auto dash  = r.find('-');
+        auto first = std::stoul(r.substr(0, dash));
+        auto last  = dash == std::string::npos ? first : std::stoul(r.substr(dash + 1));
+        for(auto i = first; i <= last; i++)
+            result.push_back(i);
+    }
+    return result;
+}
+
+// The cpus the process was started on, which is read once so that threads pinned later do not
+// change it
+static const std::vector<std::size_t>& get_allowed_cpus()
+{
+    static const std::vector<std::size_t> cpus = [] {
+        std::vector<std::size_t> result;
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if(sched_getaffinity(0, sizeof(set), &set) == 0)
+        {
+            for(std::size_t i = 0; i < CPU_SETSIZE; i++)
+            {
+                if(CPU_ISSET(i, &set))
+                    result.push_back(i);
+            }
+        }
+#endif
+        if(result.empty())
+        {
+            result.resize(std::max(1u, std::thread::hardware_concurrency()));
+            std::iota(result.begin(), result.end(), 0);
+        }
+        return result;
+    }();
+    return cpus;
+}
+
+std::size_t get_numa_node_count()
+{
+    std::size_t n = 0;
+    while(fs::exists(numa_node_path(n)))
+        n++;
+    return std::max<std::size_t>(n, 1);
+}
+
+std::vector<std::size_t> get_numa_node_cpus(int node)
+{
+    const auto& allowed = get_allowed_cpus();
+    if(node < 0)
+        return allowed;
+    auto path = numa_node_path(node) / "cpulist";
+    if(not fs::exists(path))
+        return node == 0 ? allowed : std::vector<std::size_t>{};
+    // sysfs reports a page as the file size, so read it as a stream instead of with read_string
+    std::ifstream is(path);
+    std::string line;
+    std::getline(is, line);
+    auto cpus = parse_cpu_list(line);
+    std::vector<std::size_t> result;
+    std::copy_if(cpus.begin(), cpus.end(), std::back_inserter(result), [&](auto cpu) {
+        return std::binary_search(allowed.begin(), allowed.end(), cpu);
+    });
+    return result;
+}
+
+int get_current_numa_node()
+{
+#ifdef __linux__
+    unsigned int cpu  = 0;
+    unsigned int node = 0;
+    if(syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+        return node;
+#endif
+    return 0;
+}
+
+bool set_thread_affinity(const std::vector<std::size_t>& cpus)
+{
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for(auto cpu : cpus)
+    {
+        if(cpu < CPU_SETSIZE)
+            CPU_SET(cpu, &set);
+    }
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+bool bind_memory_to_numa_node(void* p, std::size_t n, int node)
+{
+#ifdef __linux__
+    // MPOL_PREFERRED from linux/mempolicy.h, which is not always installed
+    const int preferred = 1;
+    unsigned long mask  = 0;
+    if(node < 0 or static_cast<std::size_t>(node) >= 8 * sizeof(mask))
+        return false;
+    mask = 1UL << node;
+    return syscall(SYS_mbind, p, n, preferred, &mask, 8 * sizeof(mask), 0) == 0;
+#else
+    (void)p;
+    (void)n;
+    (void)node;
+    return false;
+#endif
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -32,6 +32,7 @@
 #include <onnx.pb.h>
 #include <unordered_map>
 #include <functional>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -104,6 +105,10 @@ struct onnx_parser
     int64_t max_loop_iterations  = 10;
     int64_t limit_max_iterations = std::numeric_limits<uint16_t>::max();
     int64_t opset_version        = 13;
+    bool lazy_initializers       = false;
+    bool stream_initializers     = false;
+    // Keeps the tensors alive for lazily loaded initializers
+    std::shared_ptr<const onnx::ModelProto> model = nullptr;
 
     std::unordered_map<std::string, op_func> ops;
 
@@ -120,6 +125,7 @@ struct onnx_parser
     parse_graph(module* mod, const onnx::GraphProto& graph, bool inlining = false);
     literal parse_value(const onnx::AttributeProto& attr) const;
     literal parse_tensor(const onnx::TensorProto& t) const;
+    literal parse_initializer(const onnx::TensorProto& t) const;
     shape parse_type(const onnx::TypeProto& t) const;
     shape parse_type(const onnx::TypeProto& t, const std::vector<std::size_t>& input_dims) const;
 };
@@ -23,6 +23,7 @@
  */
 #include <migraphx/onnx/onnx_parser.hpp>
 #include <migraphx/onnx/op_parser.hpp>
+#include <migraphx/onnx/stream_model.hpp>
 #include <iostream>
 #include <fstream>
 #include <unordered_map>
@@ -33,6 +34,9 @@
 
 #include <migraphx/program.hpp>
 #include <migraphx/onnx.hpp>
+#include <migraphx/serialize.hpp>
+#include <map>
+#include <set>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -70,6 +74,8 @@ program parse_onnx_from(const onnx_options& options, Ts&&... xs)
     parser.max_loop_iterations    = options.max_loop_iterations;
     parser.limit_max_iterations   = options.limit_max_iterations;
     parser.use_dyn_output         = options.use_dyn_output;
+    parser.lazy_initializers      = options.lazy_initializers;
+    parser.stream_initializers    = options.stream_initializers;
 
     if(options.print_program_on_error)
     {
@@ -108,7 +114,99 @@ program parse_onnx_buffer(const void* data, std::size_t size, const onnx_options
     return parse_onnx_from(options, data, size);
 }
 
+// Sort the map so equal maps give the same value
+template <class Map>
+static value sorted_to_value(const Map& m)
+{
+    using sorted_map = std::map<typename Map::key_type, typename Map::mapped_type>;
+    return migraphx::to_value(sorted_map(m.begin(), m.end()));
+}
+
+// The options that change the parsed program
+static value onnx_options_to_value(const onnx_options& options)
+{
+    value result;
+    result["default_dim_value"]      = options.default_dim_value;
+    result["default_dyn_dim_value"]  = migraphx::to_value(options.default_dyn_dim_value);
+    result["map_input_dims"]         = sorted_to_value(options.map_input_dims);
+    result["dim_params"]             = sorted_to_value(options.dim_params);
+    result["map_dyn_input_dims"]     = sorted_to_value(options.map_dyn_input_dims);
+    result["skip_unknown_operators"] = options.skip_unknown_operators;
+    result["max_loop_iterations"]    = options.max_loop_iterations;
+    result["limit_max_iterations"]   = options.limit_max_iterations;
+    result["use_dyn_output"]         = options.use_dyn_output;
+    return result;
+}
+
+program compile_onnx(const std::string& name,
+                     const target& t,
+                     const compile_options& coptions,
+                     const onnx_options& options,
+                     const program_cache& cache)
+{
+    value model;
+    if(cache.enabled())
+    {
+        model["onnx"]    = hash_onnx_file(name);
+        model["options"] = onnx_options_to_value(options);
+    }
+    return cache.compile(model, [&] { return parse_onnx(name, options); }, t, coptions);
+}
+
 std::vector<std::string> get_onnx_operators() { return onnx::get_op_parsers(); }
 
+namespace onnx {
+
+static void find_external_data(const onnx::TensorProto& t, std::set<std::string>& files)
+{
+    for(const auto& entry : t.external_data())
+    {
+        if(entry.key() == "location")
+            files.insert(entry.value());
+    }
+}
+
+static void find_external_data(const onnx::GraphProto& g, std::set<std::string>& files)
+{
+    for(const auto& t : g.initializer())
+        find_external_data(t, files);
+    for(const auto& node : g.node())
+    {
+        for(const auto& attr : node.attribute())
+        {
+            if(attr.has_t())
+                find_external_data(attr.t(), files);
+            for(const auto& t : attr.tensors())
+                find_external_data(t, files);
+            if(attr.has_g())
+                find_external_data(attr.g(), files);
+            for(const auto& sg : attr.graphs())
+                find_external_data(sg, files);
+        }
+    }
+}
+
+} // namespace onnx
+
+value hash_onnx_file(const std::string& name)
+{
+    value result;
+    result["file"] = hash_file(name);
+    // Streaming skips the raw data of the initializers, which is already in the hash
+    std::ifstream is(name, std::ios::binary);
+    auto model = onnx::stream_model(is, name);
+    std::set<std::string> files;
+    onnx::find_external_data(model.graph(), files);
+    // Streamed initializers refer to the onnx file itself
+    files.erase(fs::path(name).filename().string());
+    auto dir = fs::path(name).parent_path();
+    std::vector<value> stamps;
+    std::transform(files.begin(), files.end(), std::back_inserter(stamps), [&](const auto& f) {
+        return file_stamp(dir / f);
+    });
+    result["external_data"] = stamps;
+    return result;
+}
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
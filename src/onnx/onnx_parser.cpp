@@ -23,6 +23,7 @@
  */
 #include <migraphx/onnx/onnx_parser.hpp>
 #include <migraphx/onnx/op_parser.hpp>
+#include <migraphx/onnx/stream_model.hpp>
 #include <migraphx/fallthrough.hpp>
 #include <migraphx/make_op.hpp>
 #include <migraphx/stringutils.hpp>
@@ -35,6 +36,7 @@
 #include <migraphx/filesystem.hpp>
 #include <migraphx/op/unknown.hpp>
 #include <migraphx/float8.hpp>
+#include <migraphx/par_for.hpp>
 #include <migraphx/env.hpp>
 #include <onnx.pb.h>
 
@@ -248,35 +250,42 @@ void onnx_parser::parse_from(std::istream& is, std::string name)
     if(not parent_path.empty())
         this->path = parent_path.string();
 
-    onnx::ModelProto model;
-    if(model.ParseFromIstream(&is))
-    {
-        auto version  = get_opset_version(model);
-        opset_version = (version == -1) ? opset_version : version;
+    bool stream = stream_initializers;
+    // Files over the protobuf message limit can only be read by streaming them
+    std::error_code ec;
+    auto file_size = fs::file_size(this->filename, ec);
+    if(not ec and file_size > std::numeric_limits<int32_t>::max())
+        stream = true;
+
+    auto m = std::make_shared<onnx::ModelProto>();
+    if(stream)
+        *m = stream_model(is, this->filename);
+    else if(not m->ParseFromIstream(&is))
+        MIGRAPHX_THROW("PARSE_FROM: Failed reading onnx file: " + this->filename);
 
-        if(model.has_graph())
-        {
-            (void)this->parse_graph(mm, model.graph());
-        }
-    }
-    else
+    this->model   = m;
+    auto version  = get_opset_version(*m);
+    opset_version = (version == -1) ? opset_version : version;
+
+    if(m->has_graph())
     {
-        MIGRAPHX_THROW("PARSE_FROM: Failed reading onnx file: " + this->filename);
+        (void)this->parse_graph(mm, m->graph());
     }
 }
 
 void onnx_parser::parse_from(const void* data, std::size_t size)
 {
     auto* mm = prog.get_main_module();
-    onnx::ModelProto model;
-    if(model.ParseFromArray(data, size))
+    auto m   = std::make_shared<onnx::ModelProto>();
+    if(m->ParseFromArray(data, size))
     {
-        auto version  = get_opset_version(model);
+        this->model   = m;
+        auto version  = get_opset_version(*m);
         opset_version = (version == -1) ? opset_version : version;
 
-        if(model.has_graph())
+        if(m->has_graph())
         {
-            (void)this->parse_graph(mm, model.graph());
+            (void)this->parse_graph(mm, m->graph());
         }
     }
     else
@@ -324,12 +333,19 @@ std::unordered_map<std::string, instruction_ref>
 parse_intializer(const onnx_parser& parser, module* mod, const onnx::GraphProto& graph)
 {
     std::unordered_map<std::string, instruction_ref> mod_insts;
-    for(auto&& f : graph.initializer())
+    // Decoding the initializers is independent, so it is done in parallel before they are added
+    // to the module in order
+    std::vector<literal> literals(graph.initializer_size());
+    par_for(literals.size(), [&](auto i) {
+        literals[i] = parser.parse_initializer(graph.initializer(i));
+    });
+    for(std::size_t i = 0; i < literals.size(); i++)
     {
+        const auto& f = graph.initializer(i);
         if(enabled(MIGRAPHX_TRACE_ONNX_PARSER{}))
             std::cout << "initializer: " << f.name() << std::endl;
         // backup instructions in parent mod
-        mod_insts[f.name()] = mod->add_literal(parser.parse_tensor(f));
+        mod_insts[f.name()] = mod->add_literal(std::move(literals[i]));
         if(enabled(MIGRAPHX_TRACE_ONNX_PARSER{}))
             mod->debug_print(mod_insts[f.name()]);
     }
@@ -493,33 +509,74 @@ literal onnx_parser::parse_value(const onnx::AttributeProto& attr) const
     MIGRAPHX_THROW("PARSE_VALUE: Invalid attribute type " + std::to_string(attr.type()));
 }
 
+// The file, offset and size of the external data of a tensor
+struct external_data_location
+{
+    fs::path file;
+    std::size_t offset = 0;
+    std::size_t nbytes = 0;
+};
+
+static external_data_location
+get_external_data(const onnx::TensorProto& t, const fs::path& path, std::size_t nbytes)
+{
+    const auto& external_data    = t.external_data();
+    const std::string& data_file = external_data.at(0).value();
+    size_t num_data_fields       = external_data.size();
+    size_t offset                = 0;
+
+    if(num_data_fields > 1) // if offset field is present
+    {
+        offset = std::stoul(external_data.at(1).value());
+    }
+    if(num_data_fields > 2) // if nbytes field is present
+    {
+        nbytes = std::stoul(external_data.at(2).value());
+    }
+    return {path / data_file, offset, nbytes};
+}
+
+static std::vector<char>
+read_external_data(const onnx::TensorProto& t, const fs::path& path, std::size_t nbytes)
+{
+    auto location = get_external_data(t, path, nbytes);
+    return read_buffer(location.file, location.offset, location.nbytes);
+}
+
+// Check the tensor holds the bytes of its shape, without reading them
+static void check_data_size(const onnx::TensorProto& t, const fs::path& path, std::size_t bytes)
+{
+    std::size_t available = t.raw_data().size();
+    if(not t.external_data().empty())
+    {
+        auto location = get_external_data(t, path, bytes);
+        std::error_code ec;
+        auto file_size = fs::file_size(location.file, ec);
+        if(ec)
+            MIGRAPHX_THROW("PARSE_TENSOR: Failure opening file: " + location.file.string());
+        available = location.offset > file_size
+                        ? 0
+                        : std::min(location.nbytes, file_size - location.offset);
+    }
+    if(available < bytes)
+        MIGRAPHX_THROW("PARSE_TENSOR: " + t.name() + " has " + std::to_string(available) +
+                       " bytes of data but its shape needs " + std::to_string(bytes));
+}
+
 literal onnx_parser::parse_tensor(const onnx::TensorProto& t) const
 {
     std::vector<std::size_t> dims(t.dims().begin(), t.dims().end());
     auto type = get_type(t.data_type());
     shape tensor_shape(type, dims);
-    auto external_data = t.external_data();
-    if(not external_data.empty())
+    if(not t.external_data().empty())
     {
-        const std::string& data_file = external_data.at(0).value();
-        size_t num_data_fields       = external_data.size();
-        size_t offset                = 0;
-        size_t nbytes                = tensor_shape.bytes();
-
-        if(num_data_fields > 1) // if offset field is present
-        {
-            offset = std::stoul(t.external_data().at(1).value());
-        }
-        if(num_data_fields > 2) // if nbytes field is present
-        {
-            nbytes = std::stoul(t.external_data().at(2).value());
-        }
-        auto raw_buffer = read_buffer(path / data_file, offset, nbytes);
-        std::string s(raw_buffer.begin(), raw_buffer.end());
-        return create_literal(type, dims, s.data());
+        check_data_size(t, path, tensor_shape.bytes());
+        auto raw_buffer = read_external_data(t, path, tensor_shape.bytes());
+        return create_literal(type, dims, raw_buffer.data());
     }
     if(t.has_raw_data())
     {
+        check_data_size(t, path, tensor_shape.bytes());
         const std::string& s = t.raw_data();
         return create_literal(type, dims, s.data());
     }
@@ -558,6 +615,16 @@ literal onnx_parser::parse_tensor(const onnx::TensorProto& t) const
                        [](float raw_val) { return migraphx::fp8::fp8e4m3fnuz{raw_val}; });
         return create_literal(shape::fp8e4m3fnuz_type, dims, data_fp8);
     }
+    case onnx::TensorProto::BFLOAT16: {
+        std::vector<bf16> data_bf16;
+        std::transform(t.int32_data().begin(),
+                       t.int32_data().end(),
+                       std::back_inserter(data_bf16),
+                       [](int32_t raw_val) {
+                           return bf16{static_cast<uint16_t>(raw_val), bf16::from_bits()};
+                       });
+        return create_literal(shape::bf16_type, dims, data_bf16);
+    }
     case onnx::TensorProto::FLOAT8E5M2FNUZ:
     case onnx::TensorProto::FLOAT8E5M2:
     case onnx::TensorProto::FLOAT8E4M3FN:
@@ -568,6 +635,34 @@ literal onnx_parser::parse_tensor(const onnx::TensorProto& t) const
     }
     MIGRAPHX_THROW("PARSE_TENSOR: Invalid tensor type");
 }
+
+literal onnx_parser::parse_initializer(const onnx::TensorProto& t) const
+{
+    bool raw = t.has_raw_data() or not t.external_data().empty();
+    if(not lazy_initializers or model == nullptr or not raw)
+        return parse_tensor(t);
+    std::vector<std::size_t> dims(t.dims().begin(), t.dims().end());
+    auto type = get_type(t.data_type());
+    shape s   = dims.empty() ? shape{type} : shape{type, dims};
+    if(s.elements() == 0)
+        return parse_tensor(t);
+    // Fail while parsing instead of when the data is first read
+    check_data_size(t, path, s.bytes());
+    // The tensor is owned by the model, so keep the model alive until the data is read
+    return literal{s, [m = model, tp = &t, p = path, bytes = s.bytes()](char* buffer) {
+                       (void)m;
+                       if(not tp->external_data().empty())
+                       {
+                           auto raw_buffer = read_external_data(*tp, p, bytes);
+                           std::copy(raw_buffer.begin(), raw_buffer.begin() + bytes, buffer);
+                       }
+                       else
+                       {
+                           const std::string& data = tp->raw_data();
+                           std::copy(data.begin(), data.begin() + bytes, buffer);
+                       }
+                   }};
+}
 shape onnx_parser::parse_type(const onnx::TypeProto& t) const
 {
     shape::type_t shape_type = get_type(t.tensor_type().elem_type());
@@ -638,9 +733,9 @@ shape::type_t get_type(int dtype)
                      "incorrect final outputs\n";
         return shape::fp8e4m3fnuz_type;
     }
+    case 16: return shape::bf16_type;
     case 14:
     case 15:
-    case 16:
     case 17:
     case 19:
     case 20:
@@ -653,7 +748,8 @@ shape::type_t get_type(int dtype)
 bool is_type_float(shape::type_t dtype)
 {
     bool r = false;
-    if(dtype == shape::float_type or dtype == shape::double_type or dtype == shape::half_type)
+    if(dtype == shape::float_type or dtype == shape::double_type or dtype == shape::half_type or
+       dtype == shape::bf16_type)
     {
         r = true;
     }
@@ -0,0 +1,221 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/onnx/stream_model.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/filesystem.hpp>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace onnx {
+
+namespace pbio = google::protobuf::io;
+
+// Field numbers from onnx.proto
+constexpr uint32_t model_graph_field        = 7;
+constexpr uint32_t graph_initializer_field  = 5;
+constexpr uint32_t tensor_raw_data_field    = 9;
+constexpr uint32_t wire_type_varint         = 0;
+constexpr uint32_t wire_type_fixed64        = 1;
+constexpr uint32_t wire_type_length_delimit = 2;
+constexpr uint32_t wire_type_fixed32        = 5;
+
+static constexpr uint32_t make_tag(uint32_t field, uint32_t wire_type)
+{
+    return (field << 3u) | wire_type;
+}
+
+static void write_varint(std::string& out, uint64_t x)
+{
+    while(x >= 0x80)
+    {
+        out.push_back(static_cast<char>((x & 0x7f) | 0x80));
+        x >>= 7u;
+    }
+    out.push_back(static_cast<char>(x));
+}
+
+namespace {
+// Reads the wire format directly from the zero copy stream. A CodedInputStream is only used for
+// each small read, since it can't read past 2GB, and it returns what it buffered when destroyed.
+struct model_reader
+{
+    pbio::ZeroCopyInputStream* input;
+    std::string location;
+
+    int64_t position() const { return input->ByteCount(); }
+
+    // Returns 0 at the end of the stream
+    uint32_t read_tag() const
+    {
+        pbio::CodedInputStream cis(input);
+        return cis.ReadTag();
+    }
+
+    uint64_t read_varint() const
+    {
+        pbio::CodedInputStream cis(input);
+        uint64_t x = 0;
+        if(not cis.ReadVarint64(&x))
+            MIGRAPHX_THROW("STREAM_MODEL: Failed reading varint at " +
+                           std::to_string(position()));
+        return x;
+    }
+
+    void read_bytes(std::string& out, uint64_t n) const
+    {
+        if(n > std::numeric_limits<int>::max())
+            MIGRAPHX_THROW("STREAM_MODEL: Field is too large: " + std::to_string(n));
+        pbio::CodedInputStream cis(input);
+        std::string s;
+        if(not cis.ReadString(&s, n))
+            MIGRAPHX_THROW("STREAM_MODEL: Failed reading " + std::to_string(n) + " bytes");
+        out += s;
+    }
+
+    void skip(uint64_t n) const
+    {
+        while(n > 0)
+        {
+            auto m = std::min<uint64_t>(n, std::numeric_limits<int>::max());
+            if(not input->Skip(m))
+                MIGRAPHX_THROW("STREAM_MODEL: Unexpected end of file");
+            n -= m;
+        }
+    }
+
+    // Append the field to the serialized fields in out
+    void copy_field(uint32_t tag, std::string& out) const
+    {
+        write_varint(out, tag);
+        switch(tag & 7u)
+        {
+        case wire_type_varint: write_varint(out, read_varint()); break;
+        case wire_type_fixed64: read_bytes(out, 8); break;
+        case wire_type_length_delimit: {
+            auto n = read_varint();
+            write_varint(out, n);
+            read_bytes(out, n);
+            break;
+        }
+        case wire_type_fixed32: read_bytes(out, 4); break;
+        default: MIGRAPHX_THROW("STREAM_MODEL: Unsupported wire type " + std::to_string(tag & 7u));
+        }
+    }
+
+    int64_t read_end() const
+    {
+        auto n = read_varint();
+        return position() + n;
+    }
+
+    onnx::TensorProto read_tensor(int64_t end) const
+    {
+        std::string fields;
+        int64_t offset = -1;
+        uint64_t bytes = 0;
+        while(position() < end)
+        {
+            auto tag = read_tag();
+            if(tag == make_tag(tensor_raw_data_field, wire_type_length_delimit))
+            {
+                bytes  = read_varint();
+                offset = position();
+                skip(bytes);
+            }
+            else
+            {
+                copy_field(tag, fields);
+            }
+        }
+        onnx::TensorProto t;
+        if(not t.ParseFromString(fields))
+            MIGRAPHX_THROW("STREAM_MODEL: Failed parsing initializer");
+        if(offset >= 0)
+        {
+            t.set_data_location(onnx::TensorProto::EXTERNAL);
+            auto add_entry = [&](const std::string& key, const std::string& value) {
+                auto* entry = t.add_external_data();
+                entry->set_key(key);
+                entry->set_value(value);
+            };
+            add_entry("location", location);
+            add_entry("offset", std::to_string(offset));
+            add_entry("length", std::to_string(bytes));
+        }
+        return t;
+    }
+
+    onnx::GraphProto read_graph(int64_t end) const
+    {
+        std::string fields;
+        std::vector<onnx::TensorProto> initializers;
+        while(position() < end)
+        {
+            auto tag = read_tag();
+            if(tag == make_tag(graph_initializer_field, wire_type_length_delimit))
+                initializers.push_back(read_tensor(read_end()));
+            else
+                copy_field(tag, fields);
+        }
+        onnx::GraphProto graph;
+        if(not graph.ParseFromString(fields))
+            MIGRAPHX_THROW("STREAM_MODEL: Failed parsing graph");
+        for(auto& t : initializers)
+            graph.add_initializer()->Swap(&t);
+        return graph;
+    }
+};
+} // namespace
+
+onnx::ModelProto stream_model(std::istream& is, const std::string& filename)
+{
+    if(is.fail())
+        MIGRAPHX_THROW("STREAM_MODEL: Failed reading onnx file: " + filename);
+    pbio::IstreamInputStream input(&is);
+    // The offsets are relative to the model file which is in the directory of the parser path
+    model_reader reader{&input, fs::path(filename).filename().string()};
+    std::string fields;
+    onnx::ModelProto model;
+    while(auto tag = reader.read_tag())
+    {
+        if(tag == make_tag(model_graph_field, wire_type_length_delimit))
+            model.mutable_graph()->MergeFrom(reader.read_graph(reader.read_end()));
+        else
+            reader.copy_field(tag, fields);
+    }
+    if(is.bad())
+        MIGRAPHX_THROW("STREAM_MODEL: Failed reading onnx file: " + filename);
+    if(not model.MergeFromString(fields))
+        MIGRAPHX_THROW("STREAM_MODEL: Failed parsing onnx file: " + filename);
+    return model;
+}
+
+} // namespace onnx
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
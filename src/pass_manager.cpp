@@ -23,6 +23,7 @@
  */
 #include <migraphx/program.hpp>
 #include <migraphx/pass_manager.hpp>
+#include <migraphx/pass_profiler.hpp>
 #include <migraphx/stringutils.hpp>
 #include <migraphx/instruction.hpp>
 #include <migraphx/target.hpp>
@@ -72,6 +73,7 @@ struct module_pm : module_pass_manager
     tracer* t             = nullptr;
     module* common_parent = nullptr;
     program* prog         = nullptr;
+    pass_profiler profiler{};
 
     module_pm(module* pmod = nullptr, tracer* pt = nullptr) : mod(pmod), t(pt) {}
 
@@ -120,7 +122,45 @@ struct module_pm : module_pass_manager
         trace("Pass: ", p.name());
         assert(mod);
         assert(mod->validate() == mod->end());
-        if(enabled(MIGRAPHX_TIME_PASSES{}))
+        if(profiler.enabled())
+        {
+            using milliseconds = std::chrono::duration<double, std::milli>;
+            pass_record r;
+            r.pass                = p.name();
+            r.module              = mod->name();
+            r.instructions_before = mod->size();
+            auto& counters        = get_pass_counters();
+            auto start            = counters;
+            r.depth               = counters.depth++;
+            double ms             = 0;
+            try
+            {
+                ms = time<milliseconds>([&] { p.apply(*this); });
+            }
+            catch(...)
+            {
+                counters.depth--;
+                throw;
+            }
+            counters.depth--;
+            auto hits     = counters.matcher_hits - start.matcher_hits;
+            auto inserted = counters.inserted_instructions - start.inserted_instructions;
+            r.instructions_after = mod->size();
+            r.ms                 = ms - (counters.nested_ms - start.nested_ms);
+            r.matcher_hits =
+                hits - (counters.nested_matcher_hits - start.nested_matcher_hits);
+            r.inserted_instructions =
+                inserted -
+                (counters.nested_inserted_instructions - start.nested_inserted_instructions);
+            // Report the inclusive totals to the enclosing pass, if any
+            counters.nested_ms                    = start.nested_ms + ms;
+            counters.nested_matcher_hits          = start.nested_matcher_hits + hits;
+            counters.nested_inserted_instructions = start.nested_inserted_instructions + inserted;
+            if(enabled(MIGRAPHX_TIME_PASSES{}))
+                std::cout << p.name() << ": " << r.ms << "ms\n";
+            profiler.add(std::move(r));
+        }
+        else if(enabled(MIGRAPHX_TIME_PASSES{}))
         {
             using milliseconds = std::chrono::duration<double, std::milli>;
             auto ms            = time<milliseconds>([&] { p.apply(*this); });
@@ -137,7 +177,11 @@ struct module_pm : module_pass_manager
 
 module& get_module(module_pass_manager& mpm) { return mpm.get_module(); }
 
-void run_passes(program& prog, module_ref root_mod, const std::vector<pass>& passes, tracer trace)
+void run_passes(program& prog,
+                module_ref root_mod,
+                const std::vector<pass>& passes,
+                tracer trace,
+                pass_profiler profiler)
 {
     if(enabled(MIGRAPHX_TRACE_PASSES{}))
         trace = tracer{std::cout};
@@ -156,6 +200,7 @@ void run_passes(program& prog, module_ref root_mod, const std::vector<pass>& pas
                 continue;
             module_pm mpm{mod, root_mod, &trace};
             mpm.prog      = &prog;
+            mpm.profiler  = profiler;
             auto parents  = range(tree.equal_range(mod));
             auto nparents = distance(parents);
             if(nparents == 0)
@@ -172,19 +217,27 @@ void run_passes(program& prog, module_ref root_mod, const std::vector<pass>& pas
     }
 }
 
-void run_passes(module& mod, const std::vector<pass>& passes, tracer trace)
+void run_passes(module& mod,
+                const std::vector<pass>& passes,
+                tracer trace,
+                pass_profiler profiler)
 {
     if(enabled(MIGRAPHX_TRACE_PASSES{}))
         trace = tracer{std::cout};
     for(const auto& p : passes)
     {
-        module_pm{&mod, &mod, &trace}.run_pass(p);
+        module_pm mpm{&mod, &mod, &trace};
+        mpm.profiler = profiler;
+        mpm.run_pass(p);
     }
 }
 
-void run_passes(program& prog, const std::vector<pass>& passes, tracer trace)
+void run_passes(program& prog,
+                const std::vector<pass>& passes,
+                tracer trace,
+                pass_profiler profiler)
 {
-    run_passes(prog, prog.get_main_module(), passes, trace);
+    run_passes(prog, prog.get_main_module(), passes, trace, std::move(profiler));
 }
 
 } // namespace MIGRAPHX_INLINE_NS
@@ -0,0 +1,125 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/pass_profiler.hpp>
+#include <migraphx/serialize.hpp>
+#include <migraphx/functional.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <unordered_map>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+pass_counters& get_pass_counters()
+{
+    thread_local pass_counters counters{};
+    return counters;
+}
+
+pass_profiler pass_profiler::create()
+{
+    pass_profiler result;
+    result.records = std::make_shared<std::vector<pass_record>>();
+    return result;
+}
+
+void pass_profiler::add(pass_record r) const
+{
+    if(not enabled())
+        return;
+    records->push_back(std::move(r));
+}
+
+const std::vector<pass_record>& pass_profiler::get_records() const
+{
+    static const std::vector<pass_record> empty = {};
+    if(not enabled())
+        return empty;
+    return *records;
+}
+
+value pass_profiler::to_value() const { return migraphx::to_value(get_records()); }
+
+struct pass_total
+{
+    std::string pass;
+    std::size_t runs         = 0;
+    double ms                = 0;
+    std::ptrdiff_t delta     = 0;
+    std::size_t matcher_hits = 0;
+    std::size_t inserted     = 0;
+};
+
+void pass_profiler::print(std::ostream& os) const
+{
+    std::vector<pass_total> totals;
+    std::unordered_map<std::string, std::size_t> index;
+    double total_ms = 0;
+    for(const auto& r : get_records())
+    {
+        auto it = index.find(r.pass);
+        if(it == index.end())
+        {
+            it = index.emplace(r.pass, totals.size()).first;
+            totals.push_back({r.pass});
+        }
+        auto& t = totals[it->second];
+        t.runs++;
+        t.ms += r.ms;
+        t.delta += static_cast<std::ptrdiff_t>(r.instructions_after) -
+                   static_cast<std::ptrdiff_t>(r.instructions_before);
+        t.matcher_hits += r.matcher_hits;
+        t.inserted += r.inserted_instructions;
+        total_ms += r.ms;
+    }
+    std::stable_sort(totals.begin(), totals.end(), by(std::greater<>{}, [](const auto& t) {
+                         return t.ms;
+                     }));
+
+    auto flags        = os.flags();
+    auto precision    = os.precision();
+    std::size_t width = 4;
+    for(const auto& t : totals)
+        width = std::max(width, t.pass.size());
+
+    os << std::left << std::setw(width) << "Pass" << std::right << std::setw(8) << "Runs"
+       << std::setw(14) << "Time(ms)" << std::setw(10) << "Percent" << std::setw(14)
+       << "Ins delta" << std::setw(14) << "Matches" << std::setw(14) << "Inserted"
+       << std::endl;
+    for(const auto& t : totals)
+    {
+        double percent = total_ms > 0 ? 100.0 * t.ms / total_ms : 0.0;
+        os << std::left << std::setw(width) << t.pass << std::right << std::setw(8) << t.runs
+           << std::setw(14) << std::fixed << std::setprecision(3) << t.ms << std::setw(9)
+           << std::setprecision(2) << percent << "%" << std::setw(14) << t.delta
+           << std::setw(14) << t.matcher_hits << std::setw(14) << t.inserted << std::endl;
+    }
+    os << "Total time: " << std::setprecision(3) << total_ms << "ms" << std::endl;
+    os.flags(flags);
+    os.precision(precision);
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,247 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/pointwise_executor.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/ranges.hpp>
+#include <atomic>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+// Number of elements computed by each step at a time
+constexpr std::size_t block_size = 1024;
+
+pointwise_executor pointwise_executor::translate(const module& m)
+{
+    pointwise_executor e;
+    std::unordered_map<instruction_ref, std::size_t> regs;
+    std::unordered_map<instruction_ref, std::size_t> last_use;
+    std::size_t i = 0;
+    for(auto ins : iterator_for(m))
+    {
+        for(auto input : ins->inputs())
+            last_use[input] = i;
+        i++;
+    }
+
+    // Reuse the registers of values that are no longer needed
+    std::vector<std::size_t> free_regs;
+    auto allocate = [&](instruction_ref ins) {
+        if(free_regs.empty())
+        {
+            regs[ins] = e.registers++;
+        }
+        else
+        {
+            regs[ins] = free_regs.back();
+            free_regs.pop_back();
+        }
+        return regs[ins];
+    };
+
+    auto pnames = m.get_parameter_names();
+    std::sort(pnames.begin(), pnames.end());
+    std::transform(pnames.begin(),
+                   pnames.end(),
+                   std::back_inserter(e.parameters),
+                   [&](const auto& name) { return allocate(m.get_parameter(name)); });
+    // The literals are loaded with the parameters before any step runs, so they get their
+    // registers before any register is freed
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() == "@literal")
+            e.literals.emplace_back(allocate(ins), ins->get_literal());
+    }
+
+    i = 0;
+    for(auto ins : iterator_for(m))
+    {
+        auto pos = i++;
+        if(contains({"@param", "@literal"}, ins->name()))
+            continue;
+        if(ins->name() == "@return")
+        {
+            e.output = regs.at(ins->inputs().front());
+            return e;
+        }
+        if(not ins->module_inputs().empty())
+            MIGRAPHX_THROW("POINTWISE: Submodules are not supported in pointwise: " + ins->name());
+        step s;
+        s.op   = ins->normalized_operator();
+        s.type = ins->get_shape().type();
+        e.context_free &= s.op.is_context_free();
+        std::transform(ins->inputs().begin(),
+                       ins->inputs().end(),
+                       std::back_inserter(s.inputs),
+                       [&](auto input) { return regs.at(input); });
+        for(auto input : ins->inputs())
+        {
+            if(last_use.at(input) == pos and not contains(free_regs, regs.at(input)))
+                free_regs.push_back(regs.at(input));
+        }
+        s.output = allocate(ins);
+        e.steps.push_back(s);
+    }
+    e.output = regs.at(std::prev(m.end()));
+    return e;
+}
+
+// Visit the offsets of the elements in [start, start + len) of a non-standard shape, carrying the
+// index from one element to the next instead of computing it for each element
+template <class F>
+static void for_each_offset(const shape& s, std::size_t start, std::size_t len, F f)
+{
+    const auto& lens    = s.lens();
+    const auto& strides = s.strides();
+    auto idx            = s.multi(start);
+    auto offset         = s.index(idx);
+    for(std::size_t j = 0; j < len; j++)
+    {
+        f(j, offset);
+        for(auto k = lens.size(); k > 0; k--)
+        {
+            idx[k - 1]++;
+            offset += strides[k - 1];
+            if(idx[k - 1] < lens[k - 1])
+                break;
+            offset -= idx[k - 1] * strides[k - 1];
+            idx[k - 1] = 0;
+        }
+    }
+}
+
+// Get the block of an input, which can be used directly when it has the same layout as the output
+static argument
+load_block(const argument& arg, std::size_t start, std::size_t len, bool memory_order)
+{
+    const auto& s = arg.get_shape();
+    shape block{s.type(), {len}};
+    if(s.scalar() or s.elements() == 1)
+    {
+        argument r{block};
+        visit_all(r, arg)([&](auto out, auto x) { std::fill(out.begin(), out.end(), x[0]); });
+        return r;
+    }
+    if(memory_order or s.standard())
+        return {block, arg.data() + start * s.type_size()};
+    argument r{block};
+    visit_all(r, arg)([&](auto out, auto x) {
+        for_each_offset(s, start, len, [&](auto j, auto offset) { out[j] = x.data()[offset]; });
+    });
+    return r;
+}
+
+argument pointwise_executor::execute(const shape& output_shape,
+                                     const std::vector<argument>& args) const
+{
+    argument result{output_shape};
+    // When all inputs have the same layout as the output the elements can be computed in the
+    // order they are stored in memory
+    bool memory_order = output_shape.packed() and all_of(args, [&](const argument& arg) {
+                            const auto& s = arg.get_shape();
+                            return s.scalar() or s.elements() == 1 or s == output_shape;
+                        });
+    bool contiguous_output = memory_order or output_shape.standard();
+    auto n                 = output_shape.elements();
+    par_for((n + block_size - 1) / block_size, [&](auto b) {
+        auto start = b * block_size;
+        auto len   = std::min(block_size, n - start);
+        std::vector<argument> regs(registers);
+        for(std::size_t k = 0; k < parameters.size(); k++)
+            regs[parameters[k]] = load_block(args[k], start, len, memory_order);
+        for(const auto& [r, l] : literals)
+            regs[r] = load_block(l.get_argument(), start, len, memory_order);
+        for(const auto& s : steps)
+        {
+            std::vector<argument> inputs;
+            std::transform(s.inputs.begin(),
+                           s.inputs.end(),
+                           std::back_inserter(inputs),
+                           [&](auto r) { return regs[r]; });
+            regs[s.output] = s.op.compute(shape{s.type, {len}}, inputs);
+        }
+        visit_all(result, regs[output])([&](auto out, auto x) {
+            if(contiguous_output)
+            {
+                std::copy(x.begin(), x.end(), out.data() + start);
+            }
+            else
+            {
+                for_each_offset(output_shape, start, len, [&](auto j, auto offset) {
+                    out.data()[offset] = x[j];
+                });
+            }
+        });
+    });
+    return result;
+}
+
+struct pointwise_executor_cache::entry
+{
+    // The module id, since the address of a module can be reused after it is freed
+    std::size_t id      = 0;
+    std::size_t size    = 0;
+    std::size_t version = 0;
+    pointwise_executor executor;
+};
+
+// The latest version of the instructions in the module, which changes with any edit to it
+static std::size_t module_version(const module& m)
+{
+    std::size_t result = 0;
+    for(auto ins : iterator_for(m))
+        result = std::max(result, ins->get_version());
+    return result;
+}
+
+pointwise_executor_cache::pointwise_executor_cache(const pointwise_executor_cache&) {}
+
+pointwise_executor_cache& pointwise_executor_cache::operator=(const pointwise_executor_cache&)
+{
+    std::atomic_store(&current, std::shared_ptr<const entry>{});
+    return *this;
+}
+
+std::shared_ptr<const pointwise_executor> pointwise_executor_cache::get(const module& m) const
+{
+    auto version = module_version(m);
+    auto e       = std::atomic_load(&current);
+    if(e == nullptr or e->id != m.id() or e->size != m.size() or e->version != version)
+    {
+        auto r      = std::make_shared<entry>();
+        r->id       = m.id();
+        r->size     = m.size();
+        r->version  = version;
+        r->executor = pointwise_executor::translate(m);
+        e           = r;
+        std::atomic_store(&current, e);
+    }
+    return {e, &e->executor};
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
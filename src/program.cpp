@@ -23,6 +23,7 @@
  */
 #include <migraphx/version.h>
 #include <migraphx/compile_options.hpp>
+#include <migraphx/cost_model.hpp>
 #include <migraphx/program.hpp>
 #include <migraphx/stringutils.hpp>
 #include <migraphx/instruction.hpp>
@@ -282,7 +283,8 @@ void program::compile(const std::vector<target>& targets, std::vector<compile_op
             auto passes = root_target.get_passes(this->impl->contexts[root_target_id],
                                                  compile_opts[root_target_id]);
             passes.push_back(mark_instruction_target{static_cast<size_t>(root_target_id)});
-            run_passes(*this, current_mod, passes, trace);
+            run_passes(
+                *this, current_mod, passes, trace, compile_opts[root_target_id].profiler);
 
             auto invalid = current_mod->validate();
             if(invalid != current_mod->end())
@@ -316,7 +318,7 @@ void program::compile(const target& t, compile_options options)
     options.trace(*this);
     options.trace();
     auto&& passes = t.get_passes(this->impl->contexts.front(), options);
-    run_passes(*this, passes, options.trace);
+    run_passes(*this, passes, options.trace, options.profiler);
     auto mods = this->get_modules();
     // Validate and finalize
     for(const auto& mod : reverse(mods))
@@ -890,13 +892,31 @@ void program::perf_report(std::ostream& os,
     double total_instruction_time = 0.0;
     std::unordered_map<std::string, double> op_times;
     std::unordered_map<std::string, std::size_t> op_n;
+    std::unordered_map<std::string, op_cost> op_costs;
+    std::unordered_map<instruction_ref, op_cost> ins_costs;
+    op_cost total_cost;
     for(auto&& p : ins_vec)
     {
         double avg = common_average(p.second);
-        op_times[perf_group(p.first->get_operator())] += avg;
+        auto group = perf_group(p.first->get_operator());
+        auto cost  = estimate_cost(p.first);
+        op_times[group] += avg;
         total_instruction_time += avg;
-        op_n[perf_group(p.first->get_operator())]++;
+        op_n[group]++;
+        op_costs[group].flops += cost.flops;
+        op_costs[group].bytes += cost.bytes;
+        total_cost.flops += cost.flops;
+        total_cost.bytes += cost.bytes;
+        ins_costs[p.first] = cost;
     }
+    auto model = roofline::host();
+    // Achieved throughput and whether the work is compute or memory bound
+    auto print_throughput = [&](const op_cost& cost, double ms) {
+        if(cost.bytes == 0 or ms <= 0)
+            return;
+        os << ", " << cost.flops / (ms * 1.0e6) << " GFLOP/s, " << cost.bytes / (ms * 1.0e6)
+           << " GB/s, " << model.classify(cost) << "-bound";
+    };
     double calculate_overhead_time    = total_time - total_instruction_time;
     double calculate_overhead_percent = calculate_overhead_time * 100.0 / total_time;
 
@@ -911,6 +931,7 @@ void program::perf_report(std::ostream& os,
         double avg     = common_average(ins_vec[ins]);
         double percent = std::ceil(100.0 * avg / total_instruction_time);
         os << ": " << avg << "ms, " << percent << "%";
+        print_throughput(ins_costs[ins], avg);
         os << std::endl;
     });
 
@@ -927,8 +948,9 @@ void program::perf_report(std::ostream& os,
     {
         double percent = std::ceil(100.0 * avg / total_instruction_time);
         double per_ins = avg / nn;
-        os << name << ": " << avg << "ms / " << nn << " = " << per_ins << "ms, " << percent << "%"
-           << std::endl;
+        os << name << ": " << avg << "ms / " << nn << " = " << per_ins << "ms, " << percent << "%";
+        print_throughput(op_costs.at(name), avg);
+        os << std::endl;
     }
 
     os << std::endl;
@@ -937,6 +959,10 @@ void program::perf_report(std::ostream& os,
     os << "Rate: " << rate * batch << " inferences/sec" << std::endl;
     os << "Total time: " << total_time << "ms" << std::endl;
     os << "Total instructions time: " << total_instruction_time << "ms" << std::endl;
+    os << "Total work: " << total_cost.flops / 1.0e9 << " GFLOP, " << total_cost.bytes / 1.0e9
+       << " GB" << std::endl;
+    os << "Throughput: " << total_cost.flops / (total_instruction_time * 1.0e6) << " GFLOP/s, "
+       << total_cost.bytes / (total_instruction_time * 1.0e6) << " GB/s" << std::endl;
     os << "Overhead time: " << overhead_time << "ms"
        << ", " << calculate_overhead_time << "ms" << std::endl;
     os << "Overhead: " << std::round(overhead_percent) << "%"
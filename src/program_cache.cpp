@@ -0,0 +1,209 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/program_cache.hpp>
+#include <migraphx/env.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/file_buffer.hpp>
+#include <migraphx/json.hpp>
+#include <migraphx/load_save.hpp>
+#include <migraphx/sha256.hpp>
+#include <migraphx/version.h>
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_PROGRAM_CACHE_DIR)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_PROGRAM_CACHE_MAX_SIZE)
+
+program_cache program_cache::from_env()
+{
+    program_cache result;
+    result.dir      = string_value_of(MIGRAPHX_PROGRAM_CACHE_DIR{});
+    result.max_size = value_of(MIGRAPHX_PROGRAM_CACHE_MAX_SIZE{}) * 1024 * 1024;
+    return result;
+}
+
+// The tracer and the profiler don't change the compiled program
+static value compile_options_to_value(const compile_options& options)
+{
+    return {{"offload_copy", options.offload_copy},
+            {"fast_math", options.fast_math},
+            {"exhaustive_tune", options.exhaustive_tune},
+            {"num_threads", options.num_threads},
+            {"pin_threads", options.pin_threads},
+            {"numa_node", options.numa_node}};
+}
+
+std::string
+program_cache::get_key(const value& model, const target& t, const compile_options& options) const
+{
+    value v;
+    v["model"]   = model;
+    v["target"]  = t.name();
+    v["context"] = t.get_context().to_value();
+    v["options"] = compile_options_to_value(options);
+    v["version"] = std::to_string(MIGRAPHX_VERSION_MAJOR) + "." +
+                   std::to_string(MIGRAPHX_VERSION_MINOR) + "." +
+                   std::to_string(MIGRAPHX_VERSION_PATCH) + "-" + MIGRAPHX_VERSION_TWEAK;
+    return t.name() + "-" + sha256_hex(to_json_string(v));
+}
+
+static fs::path program_file(const std::string& dir, const std::string& key)
+{
+    return fs::path{dir} / (key + ".mxr");
+}
+
+optional<program> program_cache::load(const std::string& key) const
+{
+    if(not enabled())
+        return nullopt;
+    auto file = program_file(dir, key);
+    std::error_code ec;
+    if(not fs::exists(file, ec))
+        return nullopt;
+    try
+    {
+        auto p = migraphx::load(file.string());
+        // Mark the program as recently used
+        fs::last_write_time(file, fs::file_time_type::clock::now(), ec);
+        return p;
+    }
+    catch(const std::exception&)
+    {
+        // The file is partial or from an incompatible build
+        fs::remove(file, ec);
+        return nullopt;
+    }
+}
+
+// Remove the least recently used programs, other than keep, until the directory fits in max_size
+static void evict(const fs::path& dir, std::size_t max_size, const fs::path& keep)
+{
+    struct entry
+    {
+        fs::file_time_type time;
+        std::size_t size;
+        fs::path path;
+    };
+    std::vector<entry> entries;
+    std::size_t total = 0;
+    std::error_code ec;
+    for(const auto& e : fs::directory_iterator{dir, ec})
+    {
+        if(e.path().extension() != ".mxr")
+            continue;
+        auto size = fs::file_size(e.path(), ec);
+        if(ec)
+            continue;
+        auto time = fs::last_write_time(e.path(), ec);
+        if(ec)
+            continue;
+        total += size;
+        entries.push_back({time, size, e.path()});
+    }
+    std::sort(entries.begin(), entries.end(), [](const entry& x, const entry& y) {
+        return x.time < y.time;
+    });
+    for(const auto& e : entries)
+    {
+        if(total <= max_size)
+            break;
+        if(e.path == keep)
+            continue;
+        if(fs::remove(e.path, ec))
+            total -= e.size;
+    }
+}
+
+void program_cache::store(const std::string& key, const program& p) const
+{
+    if(not enabled())
+        return;
+    auto file = program_file(dir, key);
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    if(not try_write_file(file, [&](const fs::path& tmp) { save(p, tmp.string()); }))
+        return;
+    if(max_size > 0)
+        evict(dir, max_size, file);
+}
+
+program program_cache::compile(const value& model,
+                               const std::function<program()>& parse,
+                               const target& t,
+                               const compile_options& options) const
+{
+    std::string key;
+    if(enabled())
+    {
+        key    = get_key(model, t, options);
+        auto p = load(key);
+        if(p.has_value())
+            return std::move(*p);
+    }
+    auto p = parse();
+    p.compile(t, options);
+    if(enabled())
+        store(key, p);
+    return p;
+}
+
+std::string hash_file(const fs::path& p)
+{
+    std::ifstream is(p.string(), std::ios::binary);
+    if(not is)
+        MIGRAPHX_THROW("Failed to open file: " + p.string());
+    sha256 h;
+    std::vector<char> buffer(1024 * 1024);
+    while(is)
+    {
+        is.read(buffer.data(), buffer.size());
+        auto n = is.gcount();
+        if(n <= 0)
+            break;
+        h.update(buffer.data(), n);
+    }
+    return h.hex_digest();
+}
+
+value file_stamp(const fs::path& p)
+{
+    value result = {{"path", p.string()}};
+    std::error_code ec;
+    auto size = fs::file_size(p, ec);
+    if(ec)
+        return result;
+    auto time = fs::last_write_time(p, ec);
+    if(ec)
+        return result;
+    result["size"] = size;
+    result["time"] = static_cast<std::int64_t>(time.time_since_epoch().count());
+    return result;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -28,12 +28,19 @@
 #include <migraphx/functional.hpp>
 #include <migraphx/simple_par_for.hpp>
 #include <migraphx/env.hpp>
+#include <migraphx/file_buffer.hpp>
+#include <migraphx/filesystem.hpp>
+#include <migraphx/sha256.hpp>
+#include <migraphx/version.h>
+#include <sstream>
 #include <unordered_set>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_PROPAGATE_CONSTANT)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_CONST_FOLD_MAX_MEMORY)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_CONST_FOLD_CACHE_DIR)
 
 bool skip_propagate(instruction_ref ins)
 {
@@ -53,6 +60,87 @@ bool is_const_ins(instruction_ref ins, std::unordered_set<std::string> skip_ops)
            skip_ops.find(ins->name()) == skip_ops.end();
 }
 
+// Bytes held while folding an instruction, which is its result and the largest intermediate
+static std::size_t fold_bytes(instruction_ref ins)
+{
+    std::size_t largest = 0;
+    std::unordered_set<instruction_ref> visited;
+    fix([&](auto self, auto x) {
+        if(x->name() == "@literal" or not visited.insert(x).second)
+            return;
+        largest = std::max(largest, x->get_shape().bytes());
+        for(auto input : x->inputs())
+            self(input);
+    })(ins);
+    return ins->get_shape().bytes() + largest;
+}
+
+// Digest of the instructions that compute ins, including the data of the literals
+static std::string digest_subgraph(instruction_ref ins,
+                                   std::unordered_map<instruction_ref, std::string>& digests)
+{
+    auto it = digests.find(ins);
+    if(it != digests.end())
+        return it->second;
+    sha256 h;
+    std::stringstream ss;
+    ss << ins->name() << ins->get_shape();
+    if(ins->name() != "@literal")
+        ss << ins->get_operator().to_value();
+    h.update(ss.str());
+    if(ins->name() == "@literal")
+    {
+        const auto& a = ins->get_literal();
+        h.update(a.data(), a.get_shape().bytes());
+    }
+    for(auto input : ins->inputs())
+        h.update(digest_subgraph(input, digests));
+    return digests[ins] = h.hex_digest();
+}
+
+static std::string cache_key(instruction_ref ins,
+                             std::unordered_map<instruction_ref, std::string>& digests)
+{
+    // Ops could compute different results in another version
+    return sha256_hex(digest_subgraph(ins, digests) + MIGRAPHX_VERSION_TWEAK +
+                      std::to_string(MIGRAPHX_VERSION_MAJOR) + "." +
+                      std::to_string(MIGRAPHX_VERSION_MINOR));
+}
+
+// Evaluate the instruction, or read the result from the cache file when it is there
+static argument fold(instruction_ref ins, const fs::path& cache_file)
+{
+    const auto& s = ins->get_shape();
+    if(not cache_file.empty() and fs::exists(cache_file))
+    {
+        auto buffer = std::make_shared<std::vector<char>>(read_buffer(cache_file));
+        if(buffer->size() == s.bytes())
+            return {s, std::shared_ptr<char>(buffer, buffer->data())};
+    }
+    auto result = ins->eval();
+    if(not cache_file.empty() and not result.empty())
+        try_write_buffer(cache_file, result.data(), s.bytes());
+    return result;
+}
+
+// Remove the instructions that computed a folded instruction once nothing else uses them
+static void remove_unused(module& m, instruction_ref ins, instruction_ref last)
+{
+    fix([&](auto self, auto x) {
+        if(x == last or not x->outputs().empty() or x->name() == "@param")
+            return;
+        std::vector<instruction_ref> inputs;
+        for(auto input : x->inputs())
+        {
+            if(not contains(inputs, input))
+                inputs.push_back(input);
+        }
+        m.remove_instruction(x);
+        for(auto input : inputs)
+            self(input);
+    })(ins);
+}
+
 void propagate_constant::apply(module& m) const
 {
     std::unordered_set<instruction_ref> const_instrs;
@@ -80,18 +168,74 @@ void propagate_constant::apply(module& m) const
         }
     }
 
-    // Compute literals in parallel
-    std::vector<instruction_ref> const_instrs_vec{const_instrs.begin(), const_instrs.end()};
-    std::vector<argument> literals(const_instrs_vec.size());
-    simple_par_for(const_instrs_vec.size(), 1, [&](const auto i) {
-        literals[i] = const_instrs_vec[i]->eval();
-    });
+    // Fold in module order so the waves and the literals are deterministic
+    std::vector<instruction_ref> const_instrs_vec;
+    for(auto ins : iterator_for(m))
+    {
+        if(contains(const_instrs, ins))
+            const_instrs_vec.push_back(ins);
+    }
+
+    auto budget = max_memory;
+    if(budget == 0)
+        budget = value_of(MIGRAPHX_CONST_FOLD_MAX_MEMORY{}) * 1024 * 1024;
+    fs::path cache{cache_dir.empty() ? string_value_of(MIGRAPHX_CONST_FOLD_CACHE_DIR{})
+                                     : cache_dir};
+    if(not cache.empty())
+    {
+        // The cache is only an optimization, so it is disabled when the directory cannot be made
+        std::error_code ec;
+        fs::create_directories(cache, ec);
+        if(ec)
+        {
+            if(enabled(MIGRAPHX_TRACE_PROPAGATE_CONSTANT{}))
+                std::cout << "Constant folding cache disabled: " << ec.message() << std::endl;
+            cache.clear();
+        }
+    }
 
-    // Replace instructions in m
-    for(size_t i = 0; i < const_instrs_vec.size(); i++)
+    std::size_t start = 0;
+    while(start < const_instrs_vec.size())
     {
-        if(not literals[i].empty())
+        // Take the next instructions until the budget is used, with at least one in each wave
+        std::size_t end = const_instrs_vec.size();
+        if(budget > 0)
+        {
+            std::size_t wave_bytes = fold_bytes(const_instrs_vec[start]);
+            end                    = start + 1;
+            while(end < const_instrs_vec.size())
+            {
+                auto bytes = fold_bytes(const_instrs_vec[end]);
+                if(wave_bytes + bytes > budget)
+                    break;
+                wave_bytes += bytes;
+                end++;
+            }
+        }
+        std::vector<instruction_ref> wave{const_instrs_vec.begin() + start,
+                                          const_instrs_vec.begin() + end};
+        start = end;
+
+        std::vector<fs::path> cache_files(wave.size());
+        if(not cache.empty())
+        {
+            std::unordered_map<instruction_ref, std::string> digests;
+            std::transform(wave.begin(), wave.end(), cache_files.begin(), [&](auto ins) {
+                return cache / (cache_key(ins, digests) + ".bin");
+            });
+        }
+
+        // Compute literals in parallel
+        std::vector<argument> literals(wave.size());
+        simple_par_for(wave.size(), 1, [&](const auto i) {
+            literals[i] = fold(wave[i], cache_files[i]);
+        });
+
+        // Replace instructions in m
+        for(size_t i = 0; i < wave.size(); i++)
         {
+            if(literals[i].empty())
+                continue;
             if(enabled(MIGRAPHX_TRACE_PROPAGATE_CONSTANT{}))
             {
                 std::cout << "Constant replace: " << std::endl;
@@ -102,12 +246,17 @@ void propagate_constant::apply(module& m) const
                     for(auto input : ins->inputs())
                         self(input);
                     inss.push_back(ins);
-                })(const_instrs_vec[i]);
+                })(wave[i]);
                 m.debug_print(inss);
             }
-            assert(literals[i].get_shape() == const_instrs_vec[i]->get_shape());
+            assert(literals[i].get_shape() == wave[i]->get_shape());
             auto l = m.add_literal(literals[i].get_shape(), literals[i].data());
-            m.replace_instruction(const_instrs_vec[i], l);
+            // The literal has its own copy
+            literals[i] = {};
+            m.replace_instruction(wave[i], l);
+            // Free the inputs that are no longer used before folding the next wave
+            if(budget > 0)
+                remove_unused(m, wave[i], last);
         }
     }
 }
@@ -43,6 +43,8 @@
 #include <migraphx/op/common.hpp>
 #include <migraphx/float8.hpp>
 #include <migraphx/pass_manager.hpp>
+#include <mutex>
+#include <unordered_map>
 #ifdef HAVE_GPU
 #include <migraphx/gpu/hip.hpp>
 #endif
@@ -191,9 +193,15 @@ py::buffer_info to_buffer_info(T& x)
         strides.begin(), strides.end(), strides.begin(), [&](auto i) { return i * s.type_size(); });
     py::buffer_info b;
     visit_type(s, [&](auto as) {
+        // The struct format characters used by the buffer protocol have no bf16
+        if constexpr(std::is_same<decltype(as()), migraphx::bf16>{})
+        {
+            MIGRAPHX_THROW("MIGRAPHX PYTHON: bf16 is not supported by the buffer protocol, use "
+                           "DLPack or convert to float");
+        }
         // migraphx use int8_t data to store bool type, we need to
         // explicitly specify the data type as bool for python
-        if(s.type() == migraphx::shape::bool_type)
+        else if(s.type() == migraphx::shape::bool_type)
         {
             b = py::buffer_info(x.data(),
                                 as.size(),
@@ -220,9 +228,13 @@ migraphx::shape to_shape(const py::buffer_info& info)
     migraphx::shape::type_t t;
     std::size_t n = 0;
     visit_types([&](auto as) {
-        if(info.format == py::format_descriptor<decltype(as())>::format() or
-           (info.format == "l" and py::format_descriptor<decltype(as())>::format() == "q") or
-           (info.format == "L" and py::format_descriptor<decltype(as())>::format() == "Q"))
+        if constexpr(std::is_same<decltype(as()), migraphx::bf16>{})
+        {
+            return;
+        }
+        else if(info.format == py::format_descriptor<decltype(as())>::format() or
+                (info.format == "l" and py::format_descriptor<decltype(as())>::format() == "q") or
+                (info.format == "L" and py::format_descriptor<decltype(as())>::format() == "Q"))
         {
             t = as.type_enum();
             n = sizeof(as());
@@ -255,6 +267,287 @@ migraphx::shape to_shape(const py::buffer_info& info)
     }
 }
 
+// Definitions of the DLPack ABI (https://github.com/dmlc/dlpack) used to exchange tensors with
+// other frameworks without copying
+enum dl_device_type : int32_t
+{
+    kDLCPU      = 1,
+    kDLCUDAHost = 3,
+    kDLROCM     = 10,
+    kDLROCMHost = 11
+};
+
+enum dl_data_type_code : uint8_t
+{
+    kDLInt    = 0,
+    kDLUInt   = 1,
+    kDLFloat  = 2,
+    kDLBfloat = 4,
+    kDLBool   = 6
+};
+
+struct DLDevice
+{
+    int32_t device_type;
+    int32_t device_id;
+};
+
+struct DLDataType
+{
+    uint8_t code;
+    uint8_t bits;
+    uint16_t lanes;
+};
+
+struct DLTensor
+{
+    void* data;
+    DLDevice device;
+    int32_t ndim;
+    DLDataType dtype;
+    int64_t* shape;
+    int64_t* strides;
+    uint64_t byte_offset;
+};
+
+struct DLManagedTensor
+{
+    DLTensor dl_tensor;
+    void* manager_ctx;
+    void (*deleter)(DLManagedTensor*);
+};
+
+DLDataType to_dlpack_type(migraphx::shape::type_t t)
+{
+    migraphx::shape s{t};
+    auto bits = static_cast<uint8_t>(s.type_size() * 8);
+    switch(t)
+    {
+    case migraphx::shape::bool_type: return {kDLBool, bits, 1};
+    case migraphx::shape::half_type:
+    case migraphx::shape::float_type:
+    case migraphx::shape::double_type: return {kDLFloat, bits, 1};
+    case migraphx::shape::bf16_type: return {kDLBfloat, bits, 1};
+    case migraphx::shape::uint8_type:
+    case migraphx::shape::uint16_type:
+    case migraphx::shape::uint32_type:
+    case migraphx::shape::uint64_type: return {kDLUInt, bits, 1};
+    case migraphx::shape::int8_type:
+    case migraphx::shape::int16_type:
+    case migraphx::shape::int32_type:
+    case migraphx::shape::int64_type: return {kDLInt, bits, 1};
+    default: break;
+    }
+    MIGRAPHX_THROW("MIGRAPHX PYTHON: Unsupported DLPack type " + s.type_string());
+}
+
+migraphx::shape::type_t from_dlpack_type(DLDataType t)
+{
+    if(t.lanes == 1)
+    {
+        for(auto type : migraphx::shape::types())
+        {
+            // DLPack has no fp8 types
+            if(migraphx::contains(
+                   {migraphx::shape::tuple_type, migraphx::shape::fp8e4m3fnuz_type}, type))
+                continue;
+            auto dt = to_dlpack_type(type);
+            if(dt.code == t.code and dt.bits == t.bits)
+                return type;
+        }
+    }
+    MIGRAPHX_THROW("MIGRAPHX PYTHON: Unsupported DLPack type code " + std::to_string(t.code) +
+                   " with " + std::to_string(t.bits) + " bits");
+}
+
+// Device memory can only be passed to programs that run on a device, host targets read the
+// data directly. Host targets have no queue in their context.
+bool runs_on_host(const migraphx::program& p)
+{
+    if(not p.is_compiled())
+        return true;
+    return p.get_context().get_queue().unsafe_get() == nullptr;
+}
+
+// Returns the DLPack device that owns the data of the argument
+DLDevice get_dlpack_device(const migraphx::argument& a)
+{
+#ifdef HAVE_GPU
+    auto device = migraphx::gpu::get_device_of(a.data());
+    if(device >= 0)
+        return {kDLROCM, device};
+#else
+    (void)a;
+#endif
+    return {kDLCPU, 0};
+}
+
+// Wrap the tensor of a DLPack capsule, the argument owns the managed tensor and releases it
+// when the last reference to the data is gone. Only CPU tensors are accepted for host targets.
+migraphx::argument from_dlpack(const py::object& obj, bool host)
+{
+    py::object cap = py::hasattr(obj, "__dlpack__") ? obj.attr("__dlpack__")() : obj;
+    if(not PyCapsule_IsValid(cap.ptr(), "dltensor"))
+        MIGRAPHX_THROW("MIGRAPHX PYTHON: Expected a DLPack capsule that has not been consumed");
+    auto* managed = static_cast<DLManagedTensor*>(PyCapsule_GetPointer(cap.ptr(), "dltensor"));
+    // Renaming the capsule transfers the ownership of the tensor
+    PyCapsule_SetName(cap.ptr(), "used_dltensor");
+
+    std::shared_ptr<DLManagedTensor> holder(managed, [](DLManagedTensor* x) {
+        if(x->deleter == nullptr)
+            return;
+        // The deleter of the producer can release python objects
+        py::gil_scoped_acquire gil;
+        x->deleter(x);
+    });
+    const auto& t = managed->dl_tensor;
+    if(host and t.device.device_type != kDLCPU)
+        MIGRAPHX_THROW("MIGRAPHX PYTHON: DLPack device type " +
+                       std::to_string(t.device.device_type) +
+                       " is not supported by a host target, expected a CPU tensor");
+    if(not migraphx::contains({kDLCPU, kDLCUDAHost, kDLROCM, kDLROCMHost}, t.device.device_type))
+        MIGRAPHX_THROW("MIGRAPHX PYTHON: Unsupported DLPack device type " +
+                       std::to_string(t.device.device_type));
+    auto type = from_dlpack_type(t.dtype);
+    std::vector<std::size_t> lens(t.shape, t.shape + t.ndim);
+    migraphx::shape s{type};
+    if(t.ndim > 0 and t.strides == nullptr)
+    {
+        s = migraphx::shape{type, lens};
+    }
+    else if(t.ndim > 0)
+    {
+        if(std::any_of(t.strides, t.strides + t.ndim, [](auto x) { return x < 0; }))
+            MIGRAPHX_THROW("MIGRAPHX PYTHON: Negative DLPack strides are not supported");
+        s = migraphx::shape{type, lens, std::vector<std::size_t>(t.strides, t.strides + t.ndim)};
+    }
+    auto* data = static_cast<char*>(t.data) + t.byte_offset;
+    return {s, std::shared_ptr<char>(holder, data)};
+}
+
+// Export the argument as a DLPack capsule, the managed tensor keeps the argument alive until
+// the consumer calls its deleter
+py::capsule to_dlpack(const migraphx::argument& a)
+{
+    struct dlpack_tensor
+    {
+        migraphx::argument arg;
+        std::vector<int64_t> lens;
+        std::vector<int64_t> strides;
+        DLManagedTensor tensor;
+    };
+    const auto& s = a.get_shape();
+    if(s.dynamic() or s.type() == migraphx::shape::tuple_type)
+        MIGRAPHX_THROW("MIGRAPHX PYTHON: Only static non-tuple arguments can be exported");
+    auto x = std::make_unique<dlpack_tensor>();
+    x->arg = a;
+    x->lens.assign(s.lens().begin(), s.lens().end());
+    x->strides.assign(s.strides().begin(), s.strides().end());
+    auto& t               = x->tensor.dl_tensor;
+    t.data                = a.data();
+    t.device              = get_dlpack_device(a);
+    t.ndim                = static_cast<int32_t>(s.ndim());
+    t.dtype               = to_dlpack_type(s.type());
+    t.shape               = x->lens.data();
+    t.strides             = x->strides.data();
+    t.byte_offset         = 0;
+    x->tensor.manager_ctx = x.get();
+    x->tensor.deleter     = [](DLManagedTensor* m) {
+        delete static_cast<dlpack_tensor*>(m->manager_ctx);
+    };
+    auto* managed = &x.release()->tensor;
+    return py::capsule(managed, "dltensor", [](PyObject* cap) {
+        // Only delete the tensor when it was never consumed
+        if(not PyCapsule_IsValid(cap, "dltensor"))
+            return;
+        auto* m = static_cast<DLManagedTensor*>(PyCapsule_GetPointer(cap, "dltensor"));
+        m->deleter(m);
+    });
+}
+
+// Arguments can be passed as python buffers, such as numpy arrays, or as DLPack tensors
+migraphx::argument to_argument(const py::handle& x, bool host, bool writable = false)
+{
+    if(py::isinstance<py::buffer>(x))
+    {
+        py::buffer_info info = x.cast<py::buffer>().request(writable);
+        return migraphx::argument(to_shape(info), info.ptr);
+    }
+    return from_dlpack(py::reinterpret_borrow<py::object>(x), host);
+}
+
+migraphx::parameter_map to_parameter_map(const py::dict& params, bool host)
+{
+    migraphx::parameter_map pm;
+    for(auto x : params)
+    {
+        std::string key = x.first.cast<std::string>();
+        pm[key]         = to_argument(x.second, host);
+    }
+    return pm;
+}
+
+// Evaluating a program is not reentrant, since the context and the scratch memory are shared
+// by all of its runs, so the runs of the same program from several threads are serialized. The
+// lock is kept in the __dict__ of the Python program, so it is destroyed with the program.
+std::mutex& get_program_lock(const py::object& self)
+{
+    // The GIL is held, so two threads can't both create the lock
+    py::dict d = self.attr("__dict__");
+    if(not d.contains("_run_lock"))
+    {
+        d["_run_lock"] = py::capsule(new std::mutex, [](void* x) {
+            delete static_cast<std::mutex*>(x);
+        });
+    }
+    std::mutex* lock = d["_run_lock"].cast<py::capsule>();
+    return *lock;
+}
+
+// Run the program without holding the GIL. The preallocated outputs are bound to the output
+// parameters of the program so the results are written in place, and the results of programs
+// without output parameters are copied into them.
+std::vector<migraphx::argument> run_program(const migraphx::program& p,
+                                            std::mutex& lock,
+                                            migraphx::parameter_map pm,
+                                            const std::vector<migraphx::argument>& outputs,
+                                            migraphx::execution_environment exec_env = {})
+{
+    auto output_shapes = p.get_output_shapes();
+    if(not outputs.empty() and outputs.size() != output_shapes.size())
+        MIGRAPHX_THROW("MIGRAPHX PYTHON: Expected " + std::to_string(output_shapes.size()) +
+                       " outputs but got " + std::to_string(outputs.size()));
+    auto param_shapes = p.get_parameter_shapes();
+    std::vector<bool> bound(outputs.size(), false);
+    for(std::size_t i = 0; i < outputs.size(); i++)
+    {
+        const auto& s = outputs[i].get_shape();
+        if(s.type() != output_shapes[i].type() or s.lens() != output_shapes[i].lens())
+            MIGRAPHX_THROW("MIGRAPHX PYTHON: Output " + std::to_string(i) + " has shape " +
+                           migraphx::to_string(s) + " but the program produces " +
+                           migraphx::to_string(output_shapes[i]));
+        auto name = p.get_main_module()->name() + ":#output_" + std::to_string(i);
+        if(not migraphx::contains(param_shapes, name))
+            continue;
+        pm[name] = outputs[i];
+        bound[i] = true;
+    }
+    // Wait for the program without the GIL, the deleters of DLPack tensors acquire it
+    py::gil_scoped_release release;
+    std::lock_guard<std::mutex> guard(lock);
+    auto results = p.eval(std::move(pm), std::move(exec_env));
+    if(outputs.empty())
+        return results;
+    for(std::size_t i = 0; i < outputs.size(); i++)
+    {
+        if(bound[i])
+            continue;
+        migraphx::visit_all(outputs[i], results[i])(
+            [](auto out, auto r) { std::copy(r.begin(), r.end(), out.begin()); });
+    }
+    return outputs;
+}
+
 MIGRAPHX_PYBIND11_MODULE(migraphx, m)
 {
     py::class_<migraphx::shape> shape_cls(m, "shape");
@@ -313,6 +606,15 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
             return migraphx::argument(to_shape(info), info.ptr);
         }))
         .def("get_shape", &migraphx::argument::get_shape)
+        .def(
+            "__dlpack__",
+            [](const migraphx::argument& x, const py::object&) { return to_dlpack(x); },
+            py::arg("stream") = py::none())
+        .def("__dlpack_device__",
+             [](const migraphx::argument& x) {
+                 auto device = get_dlpack_device(x);
+                 return py::make_tuple(static_cast<int>(device.device_type), device.device_id);
+             })
         .def("data_ptr",
              [](migraphx::argument& x) { return reinterpret_cast<std::uintptr_t>(x.data()); })
         .def("tolist",
@@ -367,7 +669,7 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
             py::arg("args"))
         .def("__repr__", [](const migraphx::module& mm) { return migraphx::to_string(mm); });
 
-    py::class_<migraphx::program>(m, "program")
+    py::class_<migraphx::program>(m, "program", py::dynamic_attr())
         .def(py::init([]() { return migraphx::program(); }))
         .def("get_parameter_names", &migraphx::program::get_parameter_names)
         .def("get_parameter_shapes", &migraphx::program::get_parameter_shapes)
@@ -395,34 +697,31 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
             "create_module",
             [](migraphx::program& p, const std::string& name) { return p.create_module(name); },
             py::arg("name"))
-        .def("run",
-             [](migraphx::program& p, py::dict params) {
-                 migraphx::parameter_map pm;
-                 for(auto x : params)
-                 {
-                     std::string key      = x.first.cast<std::string>();
-                     py::buffer b         = x.second.cast<py::buffer>();
-                     py::buffer_info info = b.request();
-                     pm[key]              = migraphx::argument(to_shape(info), info.ptr);
-                 }
-                 return p.eval(pm);
-             })
+        .def(
+            "run",
+            [](const py::object& self, const py::dict& params, const py::object& outputs) {
+                const auto& p = self.cast<const migraphx::program&>();
+                auto host     = runs_on_host(p);
+                std::vector<migraphx::argument> outs;
+                if(not outputs.is_none())
+                {
+                    for(auto x : outputs)
+                        outs.push_back(to_argument(x, host, true));
+                }
+                return run_program(p, get_program_lock(self), to_parameter_map(params, host), outs);
+            },
+            py::arg("params"),
+            py::arg("outputs") = py::none())
         .def("run_async",
-             [](migraphx::program& p,
-                py::dict params,
+             [](const py::object& self,
+                const py::dict& params,
                 std::uintptr_t stream,
                 std::string stream_name) {
-                 migraphx::parameter_map pm;
-                 for(auto x : params)
-                 {
-                     std::string key      = x.first.cast<std::string>();
-                     py::buffer b         = x.second.cast<py::buffer>();
-                     py::buffer_info info = b.request();
-                     pm[key]              = migraphx::argument(to_shape(info), info.ptr);
-                 }
+                 const auto& p = self.cast<const migraphx::program&>();
                  migraphx::execution_environment exec_env{
                      migraphx::any_ptr(reinterpret_cast<void*>(stream), stream_name), true};
-                 return p.eval(pm, exec_env);
+                 auto pm = to_parameter_map(params, runs_on_host(p));
+                 return run_program(p, get_program_lock(self), std::move(pm), {}, exec_env);
              })
         .def("sort", &migraphx::program::sort)
         .def("print", [](const migraphx::program& p) { std::cout << p << std::endl; })
@@ -451,6 +750,18 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
         .value("reverse", migraphx::op::rnn_direction::reverse)
         .value("bidirectional", migraphx::op::rnn_direction::bidirectional);
 
+    m.def(
+        "from_dlpack",
+        [](const py::object& x) {
+#ifdef HAVE_GPU
+            return from_dlpack(x, false);
+#else
+            // Without a device target only CPU tensors can be read
+            return from_dlpack(x, true);
+#endif
+        },
+        py::arg("x"));
+
     m.def(
         "argument_from_pointer",
         [](const migraphx::shape shape, const int64_t address) {
@@ -577,12 +888,29 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
           &migraphx::quantize_fp16,
           py::arg("prog"),
           py::arg("ins_names") = std::vector<std::string>{"all"});
-    m.def("quantize_int8",
-          &migraphx::quantize_int8,
+    m.def("quantize_bf16",
+          &migraphx::quantize_bf16,
           py::arg("prog"),
-          py::arg("t"),
-          py::arg("calibration") = std::vector<migraphx::parameter_map>{},
-          py::arg("ins_names")   = std::unordered_set<std::string>{"dot", "convolution"});
+          py::arg("ins_names") = std::vector<std::string>{"all"});
+    m.def(
+        "quantize_int8",
+        [](migraphx::program& prog,
+           const migraphx::target& t,
+           const std::vector<migraphx::parameter_map>& calibration,
+           const std::unordered_set<std::string>& ins_names,
+           const std::string& calibration_method,
+           bool per_channel) {
+            migraphx::calibration_options options;
+            options.method      = migraphx::to_calibration_method(calibration_method);
+            options.per_channel = per_channel;
+            migraphx::quantize_int8(prog, t, calibration, ins_names, options);
+        },
+        py::arg("prog"),
+        py::arg("t"),
+        py::arg("calibration")        = std::vector<migraphx::parameter_map>{},
+        py::arg("ins_names")          = std::unordered_set<std::string>{"dot", "convolution"},
+        py::arg("calibration_method") = "max_abs",
+        py::arg("per_channel")        = false);
     m.def(
         "autocast_fp8",
         [](migraphx::program& prog) {
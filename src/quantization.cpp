@@ -62,80 +62,104 @@ void quantize_fp16(program& prog, const std::vector<std::string>& ins_names)
                 optimize_module{{"quantizelinear", "dequantizelinear"}}});
 }
 
+// Same as quantize_fp16 but for bf16, which keeps the range of float so it won't overflow
+void quantize_bf16(program& prog, const std::vector<std::string>& ins_names)
+{
+    run_passes(prog,
+               {normalize_ops{},
+                optimize_module{{"quantizelinear", "dequantizelinear"}},
+                quantize_bf16_pass{ins_names},
+                optimize_module{{"quantizelinear", "dequantizelinear"}}});
+}
+
 void quantize_8bits(program& prog,
                     const target& t,
                     shape::type_t precision,
                     const std::vector<parameter_map>& calibration,
-                    const std::unordered_set<std::string>& ins_names)
+                    const std::unordered_set<std::string>& ins_names,
+                    const calibration_options& options)
 {
     // Run optimize_module() before converting to int8/fp8 to const eval and fold in FP32 to
     // avoid loss of precision.
     run_passes(prog, {normalize_ops{}, optimize_module{}});
 
-    std::shared_ptr<std::vector<std::pair<float, float>>> quant_8bit_params =
-        std::make_shared<std::vector<std::pair<float, float>>>();
-    std::shared_ptr<std::vector<float>> max_abs_vals = std::make_shared<std::vector<float>>();
+    std::shared_ptr<std::vector<calibration_observer>> observers =
+        std::make_shared<std::vector<calibration_observer>>();
 
-    float quantized_range  = (precision == shape::type_t::int8_type) ? 127.0 : 240.0;
-    auto calc_quant_params = [&](std::size_t ins_index, std::vector<argument> args) {
-        std::pair<float, float> param_pair{64.0f, 0.0f};
-        // scale and shift is need for only int8 type, and we do not
-        // consider shift, so set shift to 0
-        std::vector<float> vec_val;
-        argument arg = t.copy_from(args.front());
-        arg.visit([&](auto output) { vec_val.assign(output.begin(), output.end()); });
-        auto max_val                = *std::max_element(vec_val.begin(), vec_val.end());
-        auto min_val                = *std::min_element(vec_val.begin(), vec_val.end());
-        auto max_abs                = std::max(std::fabs(max_val), std::fabs(min_val));
-        max_abs_vals->at(ins_index) = std::max(max_abs_vals->at(ins_index), max_abs);
-        // if all values are 0, no need to do scaling
-        if(float_equal(max_abs_vals->at(ins_index), 0.0f))
-        {
-            param_pair.first = 1.0f;
-        }
-        else
-        {
-            param_pair.first = quantized_range / max_abs_vals->at(ins_index);
-        }
-        quant_8bit_params->at(ins_index) = param_pair;
+    float quantized_range = (precision == shape::type_t::int8_type) ? 127.0 : 240.0;
+    // The observers read the captured argument in place, so no copy is made when the
+    // target is on the host
+    auto observe = [&](std::size_t ins_index, std::vector<argument> args) {
+        observers->at(ins_index).observe(t.copy_from(args.front()));
     };
 
     // pass to add capture argument op
     std::size_t param_num = 0;
-    run_passes(prog, {capture_arguments_pass{ins_names, calc_quant_params, &param_num}});
-    quant_8bit_params->resize(param_num, std::pair<float, float>(64.0f, 0.0f));
-    max_abs_vals->resize(param_num, 0.0f);
-
-    // use the calibration data to compute the quantization scale
-    auto capture_prog = prog;
-    capture_prog.compile(t);
+    run_passes(prog, {capture_arguments_pass{ins_names, observe, &param_num}});
 
-    // use all calibration data to run the program to calculate the
-    // quantization scale and shift
-    for(auto&& arg : calibration)
+    std::vector<std::pair<float, float>> quant_8bit_params;
+    if(options.load_table.empty())
     {
-        parameter_map m;
-        for(auto&& x : capture_prog.get_parameter_shapes())
+        observers->resize(param_num, calibration_observer{options});
+
+        // use the calibration data to compute the quantization scale
+        auto capture_prog = prog;
+        capture_prog.compile(t);
+
+        // use all calibration data to run the program to calculate the
+        // quantization scale and shift
+        for(auto&& arg : calibration)
         {
-            if(arg.count(x.first) > 0)
-            {
-                assert(x.second == arg.at(x.first).get_shape());
-                m[x.first] = t.copy_to(arg.at(x.first));
-            }
-            else
+            parameter_map m;
+            for(auto&& x : capture_prog.get_parameter_shapes())
             {
-                m[x.first] = t.allocate(x.second);
+                if(arg.count(x.first) > 0)
+                {
+                    assert(x.second == arg.at(x.first).get_shape());
+                    m[x.first] = t.copy_to(arg.at(x.first));
+                }
+                else
+                {
+                    m[x.first] = t.allocate(x.second);
+                }
             }
+            capture_prog.eval(m);
         }
-        capture_prog.eval(m);
+
+        // scale and shift is need for only int8 type, and we do not
+        // consider shift, so set shift to 0
+        std::transform(observers->begin(),
+                       observers->end(),
+                       std::back_inserter(quant_8bit_params),
+                       [&](const calibration_observer& obs) -> std::pair<float, float> {
+                           // tensors that were never captured keep the default scale
+                           if(obs.empty())
+                               return {64.0f, 0.0f};
+                           auto threshold = obs.threshold(quantized_range);
+                           // if all values are 0, no need to do scaling
+                           if(float_equal(threshold, 0.0f))
+                               return {1.0f, 0.0f};
+                           return {quantized_range / threshold, 0.0f};
+                       });
     }
+    else
+    {
+        quant_8bit_params = load_calibration_table(options.load_table, precision);
+        if(quant_8bit_params.size() != param_num)
+            MIGRAPHX_THROW("Calibration table " + options.load_table + " has " +
+                           std::to_string(quant_8bit_params.size()) +
+                           " entries but the program captures " + std::to_string(param_num));
+    }
+
+    if(not options.save_table.empty())
+        save_calibration_table(options.save_table, precision, quant_8bit_params);
 
     // print the quantization parameters in only the main module
     if(enabled(MIGRAPHX_8BITS_QUANTIZATION_PARAMS{}))
     {
-        for(std::size_t i = 0; i < quant_8bit_params->size(); ++i)
+        for(std::size_t i = 0; i < quant_8bit_params.size(); ++i)
         {
-            auto param = quant_8bit_params->at(i);
+            auto param = quant_8bit_params.at(i);
             std::cout << "ins_index = " << i << ", scale = " << param.first
                       << ", shift = " << param.second << std::endl;
         }
@@ -143,7 +167,7 @@ void quantize_8bits(program& prog,
     }
 
     run_passes(prog,
-               {quantize_8bits_pass{precision, *quant_8bit_params},
+               {quantize_8bits_pass{precision, quant_8bit_params, options.per_channel},
                 simplify_qdq{},
                 optimize_module{},
                 dead_code_elimination{}});
@@ -152,17 +176,21 @@ void quantize_8bits(program& prog,
 void quantize_int8(program& prog,
                    const target& t,
                    const std::vector<parameter_map>& calibration,
-                   const std::unordered_set<std::string>& ins_names)
+                   const std::unordered_set<std::string>& ins_names,
+                   const calibration_options& options)
 {
     std::unordered_set<std::string> op_names = {"convolution", "dot"};
     if(op_names != ins_names)
     {
         MIGRAPHX_THROW("QUANTIZE_INT8: only support DOT and CONVOLUTION operation");
     }
-    quantize_8bits(prog, t, shape::int8_type, calibration, ins_names);
+    quantize_8bits(prog, t, shape::int8_type, calibration, ins_names, options);
 }
 
-void quantize_fp8(program& prog, const target& t, const std::vector<parameter_map>& calibration)
+void quantize_fp8(program& prog,
+                  const target& t,
+                  const std::vector<parameter_map>& calibration,
+                  const calibration_options& options)
 {
     std::cout << "[Warning] : MIGraphX has BETA support for FP8. Using FP8 may result in "
                  "incorrect final outputs\n";
@@ -180,7 +208,8 @@ void quantize_fp8(program& prog, const target& t, const std::vector<parameter_ma
             supported_ins_names.insert(ins->name());
         }
     }
-    quantize_8bits(prog, t, shape::fp8e4m3fnuz_type, calibration, supported_ins_names);
+    quantize_8bits(
+        prog, t, shape::fp8e4m3fnuz_type, calibration, supported_ins_names, options);
 }
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
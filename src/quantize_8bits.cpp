@@ -32,6 +32,8 @@
 #include <migraphx/stringutils.hpp>
 #include <migraphx/op/capture.hpp>
 #include <migraphx/ranges.hpp>
+#include <migraphx/optional.hpp>
+#include <migraphx/shape_for_each.hpp>
 #include <migraphx/target.hpp>
 #include <migraphx/make_op.hpp>
 #include <migraphx/pass_manager.hpp>
@@ -48,9 +50,44 @@ static std::vector<shape::type_t>& get_quantizable_type()
     return quantable_types;
 }
 
+// Constant weights feeding convolution or dot can be quantized per output channel, which is the
+// first axis of the convolution weights and the last axis of the dot B matrix
+static optional<std::size_t> weight_channel_axis(instruction_ref capture)
+{
+    auto input = capture->inputs().front();
+    if(capture->outputs().size() != 1 or not input->can_eval())
+        return nullopt;
+    auto op = capture->outputs().front();
+    if(op->inputs().size() < 2 or op->inputs().at(1) != capture)
+        return nullopt;
+    if(op->name() == "convolution")
+        return 0;
+    if(op->name() == "dot")
+        return input->get_shape().lens().size() - 1;
+    return nullopt;
+}
+
+static std::vector<float>
+per_channel_scales(instruction_ref weights, std::size_t axis, float quantized_range)
+{
+    std::vector<float> max_abs(weights->get_shape().lens().at(axis), 0.0f);
+    weights->eval().visit([&](auto w) {
+        shape_for_each(w.get_shape(), [&](const auto& idx) {
+            auto x             = std::fabs(static_cast<float>(w(idx.begin(), idx.end())));
+            max_abs[idx[axis]] = std::max(max_abs[idx[axis]], x);
+        });
+    });
+    std::vector<float> scales(max_abs.size());
+    std::transform(max_abs.begin(), max_abs.end(), scales.begin(), [&](float x) {
+        return float_equal(x, 0.0f) ? 1.0f : x / quantized_range;
+    });
+    return scales;
+}
+
 void quantize_8bits_pass::apply(module& m) const // NOLINT
 {
     const auto& quantizable_types = get_quantizable_type();
+    float quantized_range         = (precision == shape::int8_type) ? 127.0 : 240.0;
     for(auto ins : iterator_for(m))
     {
         if(ins->name() != "capture")
@@ -68,10 +105,22 @@ void quantize_8bits_pass::apply(module& m) const // NOLINT
         {
             auto zero_point =
                 m.add_literal(migraphx::literal{migraphx::shape{precision}, {param.second}});
-            auto scale       = m.add_literal(literal({s.type()}, {1.0f / param.first}));
             const auto& lens = s.lens();
-            scale =
-                m.insert_instruction(ins, make_op("multibroadcast", {{"out_lens", lens}}), scale);
+            instruction_ref scale;
+            auto axis = per_channel ? weight_channel_axis(ins) : nullopt;
+            if(axis.has_value())
+            {
+                auto scales   = per_channel_scales(input, *axis, quantized_range);
+                auto scale_ch = m.add_literal(literal({s.type(), {scales.size()}}, scales));
+                scale         = m.insert_instruction(
+                    ins, make_op("broadcast", {{"axis", *axis}, {"out_lens", lens}}), scale_ch);
+            }
+            else
+            {
+                scale = m.add_literal(literal({s.type()}, {1.0f / param.first}));
+                scale = m.insert_instruction(
+                    ins, make_op("multibroadcast", {{"out_lens", lens}}), scale);
+            }
             zero_point = m.insert_instruction(
                 ins, make_op("multibroadcast", {{"out_lens", lens}}), zero_point);
             auto q_in =
@@ -35,7 +35,8 @@
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
-static void quantize_module(module& m, const std::vector<std::string>& ins_names)
+static void
+quantize_module(module& m, const std::vector<std::string>& ins_names, shape::type_t qtype)
 {
     for(auto ins : iterator_for(m))
     {
@@ -52,14 +53,14 @@ static void quantize_module(module& m, const std::vector<std::string>& ins_names
 
         auto mod_inputs = ins->module_inputs();
         auto s          = ins->get_shape();
-        // Convert each of the inputs that are floating point to fp16
+        // Convert each of the inputs that are floating point to fp16 or bf16
         auto inputs = ins->inputs();
         std::transform(inputs.begin(), inputs.end(), inputs.begin(), [&](auto input) {
             auto input_type = input->get_shape().type();
             if(input_type != shape::float_type and input_type != shape::double_type)
                 return input;
             return m.insert_instruction(
-                ins, make_op("convert", {{"target_type", shape::half_type}}), input);
+                ins, make_op("convert", {{"target_type", qtype}}), input);
         });
 
         // Insert quantized ins
@@ -96,7 +97,15 @@ static void quantize_module(module& m, const std::vector<std::string>& ins_names
     }
 }
 
-void quantize_fp16_pass::apply(module& m) const { quantize_module(m, ins_names); }
+void quantize_fp16_pass::apply(module& m) const
+{
+    quantize_module(m, ins_names, shape::half_type);
+}
+
+void quantize_bf16_pass::apply(module& m) const
+{
+    quantize_module(m, ins_names, shape::bf16_type);
+}
 
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
@@ -29,6 +29,7 @@
 #include <migraphx/program.hpp>
 #include <migraphx/shape.hpp>
 #include <migraphx/common.hpp>
+#include <migraphx/ranges.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -110,12 +111,14 @@ void rewrite_quantization::apply(module& m) const
     {
         if(ins->name() == "quantizelinear")
         {
-            apply_quantizelinear(m, ins);
+            if(not contains(skip_types, ins->get_shape().type()))
+                apply_quantizelinear(m, ins);
         }
 
         else if(ins->name() == "dequantizelinear")
         {
-            apply_dequantizelinear(m, ins);
+            if(not contains(skip_types, ins->inputs().front()->get_shape().type()))
+                apply_dequantizelinear(m, ins);
         }
     }
 }
@@ -0,0 +1,121 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/rewrite_resize.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/op/resize.hpp>
+#include <migraphx/shape_for_each.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/module.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+// Gathers every tap of every output element and reduces them with the tap weights.  The
+// index and weight literals hold ntaps^ndim entries per output element.
+static void replace_with_gather(module& m, instruction_ref ins)
+{
+    auto&& op     = any_cast<op::resize>(ins->get_operator());
+    auto input    = ins->inputs().front();
+    auto in_lens  = input->get_shape().lens();
+    auto out_lens = ins->get_shape().lens();
+    shape in_s{input->get_shape().type(), in_lens};
+    shape out_s{input->get_shape().type(), out_lens};
+
+    std::vector<op::resize::axis_taps> taps(in_lens.size());
+    std::size_t ncombos = 1;
+    for(std::size_t axis = 0; axis < in_lens.size(); ++axis)
+    {
+        double scale = op.sizes.empty() ? op.scales[axis] : 1.0 * out_lens[axis] / in_lens[axis];
+        taps[axis]   = op.get_axis_taps(in_lens[axis], out_lens[axis], scale);
+        // an untouched axis reads its own index
+        if(taps[axis].ntaps == 0)
+        {
+            taps[axis].ntaps = 1;
+            taps[axis].indices.resize(out_lens[axis]);
+            std::iota(taps[axis].indices.begin(), taps[axis].indices.end(), 0);
+            taps[axis].weights.assign(out_lens[axis], 1.0);
+        }
+        ncombos *= taps[axis].ntaps;
+    }
+
+    auto out_elements = out_s.elements();
+    std::vector<int> ind(ncombos * out_elements);
+    std::vector<float> weights(ncombos * out_elements);
+    shape_for_each(out_s, [&](const auto& out_idx, std::size_t i) {
+        std::vector<std::size_t> in_idx(in_lens.size());
+        for(std::size_t c = 0; c < ncombos; ++c)
+        {
+            double w = 1.0;
+            auto rem = c;
+            for(std::size_t axis = 0; axis < in_lens.size(); ++axis)
+            {
+                const auto& t = taps[axis];
+                auto k        = out_idx[axis] * t.ntaps + rem % t.ntaps;
+                in_idx[axis]  = t.indices[k];
+                w *= t.weights[k];
+                rem /= t.ntaps;
+            }
+            ind[c * out_elements + i]     = static_cast<int>(in_s.index(in_idx));
+            weights[c * out_elements + i] = w;
+        }
+    });
+
+    auto combo_lens = out_lens;
+    combo_lens.insert(combo_lens.begin(), ncombos);
+    auto ins_ind = m.add_literal(literal{shape{shape::int32_type, combo_lens}, ind});
+    // Integer inputs are interpolated in float and truncated at the end, like resize does
+    auto integral = shape::is_integral(in_s.type());
+    auto w_type   = integral ? shape::float_type : in_s.type();
+    auto ins_w    = m.add_literal(literal{shape{w_type, combo_lens}, weights});
+    auto rsp      = m.insert_instruction(
+        ins, make_op("reshape", {{"dims", {in_s.elements()}}}), input);
+    auto data = m.insert_instruction(ins, make_op("gather", {{"axis", 0}}), rsp, ins_ind);
+    if(integral)
+        data = m.insert_instruction(ins, make_op("convert", {{"target_type", w_type}}), data);
+    auto mul = m.insert_instruction(ins, make_op("mul"), data, ins_w);
+    auto sum = m.insert_instruction(ins, make_op("reduce_sum", {{"axes", {0}}}), mul);
+    auto out = m.insert_instruction(ins, make_op("squeeze", {{"axes", {0}}}), sum);
+    if(integral)
+        out = m.insert_instruction(ins, make_op("convert", {{"target_type", in_s.type()}}), out);
+    m.replace_instruction(ins, out);
+}
+
+void rewrite_resize::apply(module& m) const
+{
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() != "resize")
+            continue;
+        if(ins->inputs().size() != 1 or ins->get_shape().dynamic())
+            continue;
+        auto&& op = any_cast<op::resize>(ins->get_operator());
+        if(op.mode == "nearest")
+            continue;
+        replace_with_gather(m, ins);
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,137 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/sha256.hpp>
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+static constexpr std::array<std::uint32_t, 64> round_constants = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
+    0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe,
+    0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
+    0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+    0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116,
+    0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7,
+    0xc67178f2};
+
+static std::uint32_t rotr(std::uint32_t x, unsigned n) { return (x >> n) | (x << (32u - n)); }
+
+sha256::sha256()
+    : state{0x6a09e667,
+            0xbb67ae85,
+            0x3c6ef372,
+            0xa54ff53a,
+            0x510e527f,
+            0x9b05688c,
+            0x1f83d9ab,
+            0x5be0cd19}
+{
+}
+
+void sha256::compress(const unsigned char* block)
+{
+    std::array<std::uint32_t, 64> w;
+    for(std::size_t i = 0; i < 16; i++)
+    {
+        w[i] = (std::uint32_t{block[i * 4]} << 24u) | (std::uint32_t{block[i * 4 + 1]} << 16u) |
+               (std::uint32_t{block[i * 4 + 2]} << 8u) | std::uint32_t{block[i * 4 + 3]};
+    }
+    for(std::size_t i = 16; i < 64; i++)
+    {
+        auto s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3u);
+        auto s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10u);
+        w[i]    = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    auto v = state;
+    for(std::size_t i = 0; i < 64; i++)
+    {
+        auto s1  = rotr(v[4], 6) ^ rotr(v[4], 11) ^ rotr(v[4], 25);
+        auto ch  = (v[4] & v[5]) ^ (~v[4] & v[6]);
+        auto t1  = v[7] + s1 + ch + round_constants[i] + w[i];
+        auto s0  = rotr(v[0], 2) ^ rotr(v[0], 13) ^ rotr(v[0], 22);
+        auto maj = (v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]);
+        std::copy_backward(v.begin(), v.end() - 1, v.end());
+        v[4] += t1;
+        v[0] = t1 + s0 + maj;
+    }
+    for(std::size_t i = 0; i < 8; i++)
+        state[i] += v[i];
+}
+
+void sha256::update(const char* data, std::size_t n)
+{
+    const auto* p = reinterpret_cast<const unsigned char*>(data);
+    length += n;
+    if(buffered > 0)
+    {
+        auto k = std::min(n, buffer.size() - buffered);
+        std::memcpy(buffer.data() + buffered, p, k);
+        buffered += k;
+        p += k;
+        n -= k;
+        if(buffered < buffer.size())
+            return;
+        compress(buffer.data());
+        buffered = 0;
+    }
+    for(; n >= buffer.size(); n -= buffer.size(), p += buffer.size())
+        compress(p);
+    std::memcpy(buffer.data(), p, n);
+    buffered = n;
+}
+
+std::string sha256::hex_digest()
+{
+    auto bits = length * 8;
+    // Pad with a one bit, then zeros up to the last 8 bytes of a block, which hold the length
+    const char one = static_cast<char>(0x80);
+    update(&one, 1);
+    const std::array<char, 64> zeros{};
+    update(zeros.data(), (buffer.size() + 56 - buffered) % buffer.size());
+    std::array<char, 8> len;
+    for(std::size_t i = 0; i < 8; i++)
+        len[i] = static_cast<char>(bits >> (56u - 8u * i));
+    update(len.data(), len.size());
+    std::stringstream ss;
+    for(auto x : state)
+        ss << std::hex << std::setw(8) << std::setfill('0') << x;
+    return ss.str();
+}
+
+std::string sha256_hex(std::string_view s)
+{
+    sha256 h;
+    h.update(s);
+    return h.hex_digest();
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
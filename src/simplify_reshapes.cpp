@@ -950,28 +950,25 @@ struct find_reshape_reshape_dot
 
 void simplify_reshapes::apply(module& m) const
 {
-    for(int i = 0; i < depth; i++)
-    {
-        match::find_matches(m,
-                            find_where_op{},
-                            find_resize{},
-                            find_nop_reshapes{},
-                            find_reshaper{},
-                            find_reshape_cont{},
-                            find_transpose{},
-                            find_concat_slice{},
-                            find_concat_transpose{},
-                            find_concat_multibroadcasts{},
-                            find_nested_slice{},
-                            find_nested_concat{},
-                            find_transpose_slice{},
-                            find_broadcast_transpose{},
-                            find_slice_transpose{},
-                            find_transpose_contiguous_reshaper_unary{},
-                            find_reshape_reshape_dot{},
-                            find_scalar_multibroadcast_reshape_or_transpose{});
-        dead_code_elimination{}.apply(m);
-    }
+    match::find_matches_worklist(depth,
+                                 m,
+                                 find_where_op{},
+                                 find_resize{},
+                                 find_nop_reshapes{},
+                                 find_reshaper{},
+                                 find_reshape_cont{},
+                                 find_transpose{},
+                                 find_concat_slice{},
+                                 find_concat_transpose{},
+                                 find_concat_multibroadcasts{},
+                                 find_nested_slice{},
+                                 find_nested_concat{},
+                                 find_transpose_slice{},
+                                 find_broadcast_transpose{},
+                                 find_slice_transpose{},
+                                 find_transpose_contiguous_reshaper_unary{},
+                                 find_reshape_reshape_dot{},
+                                 find_scalar_multibroadcast_reshape_or_transpose{});
 }
 
 } // namespace MIGRAPHX_INLINE_NS
@@ -0,0 +1,148 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/cpu/context.hpp>
+#include <migraphx/cpu/tune_ops.hpp>
+#include <migraphx/context.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/host_allocator.hpp>
+#include <migraphx/numa.hpp>
+#include <migraphx/program_cache.hpp>
+#include <algorithm>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+void context::set_placement(const compile_options& options)
+{
+    if(options.numa_node >= static_cast<int>(get_numa_node_count()))
+        MIGRAPHX_THROW("Invalid NUMA node " + std::to_string(options.numa_node) + ", there are " +
+                       std::to_string(get_numa_node_count()) + " nodes");
+    numa_node         = options.numa_node;
+    placement.threads = options.num_threads;
+    placement.pin     = options.pin_threads;
+    placement.cpus.clear();
+    if(numa_node >= 0 or placement.pin)
+        placement.cpus = get_numa_node_cpus(numa_node);
+    // Use one thread for each CPU of the node by default
+    if(numa_node >= 0 and placement.threads == 0)
+        placement.threads = std::max<std::size_t>(placement.cpus.size(), 1);
+}
+
+// The widest instruction set of the host, which selects the DNNL kernels and the layout of
+// prepacked weights
+static std::string host_isa()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512vnni"))
+        return "avx512vnni";
+    if(__builtin_cpu_supports("avx512bw"))
+        return "avx512bw";
+    if(__builtin_cpu_supports("avx512f"))
+        return "avx512f";
+    if(__builtin_cpu_supports("avx2"))
+        return "avx2";
+    if(__builtin_cpu_supports("avx"))
+        return "avx";
+#endif
+    return "";
+}
+
+value context::to_value() const
+{
+    const auto* version = dnnl::version();
+    value result;
+    result["numa_node"]    = numa_node;
+    result["num_threads"]  = placement.threads;
+    result["pin_threads"]  = placement.pin;
+    result["dnnl_version"] = std::to_string(version->major) + "." +
+                             std::to_string(version->minor) + "." +
+                             std::to_string(version->patch);
+    result["isa"]          = host_isa();
+    // The passes enabled from the environment and the tuned solutions change the compiled
+    // program, so the program cache keys on them too
+    result["settings"] = {{"reduce_fusion", enabled(MIGRAPHX_ENABLE_CPU_REDUCE_FUSION{})},
+                          {"prepack_weights", not enabled(MIGRAPHX_DISABLE_PREPACK_WEIGHTS{})},
+                          {"nhwc", enabled(MIGRAPHX_ENABLE_NHWC{})},
+                          {"batch_dot", enabled(MIGRAPHX_ENABLE_BATCH_DOT{})},
+                          {"tuning_db", file_stamp(get_tuning_db_path())}};
+    return result;
+}
+
+void context::from_value(const value& v)
+{
+    // Programs saved before the placement was stored
+    if(not v.is_object())
+        return;
+    compile_options options;
+    options.numa_node   = v.get("numa_node", -1);
+    options.num_threads = v.get("num_threads", std::size_t{0});
+    options.pin_threads = v.get("pin_threads", false);
+    set_placement(options);
+}
+
+argument context::allocate(const shape& s) const
+{
+    if(numa_node < 0)
+        return argument{s};
+    // Zeroed like argument{s}, so the buffer holds the same values with or without a node
+    auto buffer = allocate_host_buffer(s.bytes(), numa_node);
+    std::fill(buffer.get(), buffer.get() + s.bytes(), 0);
+    return {s, buffer};
+}
+
+argument context::to_numa_node(const argument& a) const
+{
+    if(numa_node < 0 or a.empty() or a.get_shape().type() == shape::tuple_type)
+        return a;
+    const auto& s = a.get_shape();
+    // Not cleared first since every byte is copied
+    argument result{s, allocate_host_buffer(s.bytes(), numa_node)};
+    std::copy(a.data(), a.data() + s.bytes(), result.data());
+    return result;
+}
+
+void context::bind_threads() const
+{
+    // The placement that was last applied to the threads started by this thread
+    thread_local thread_placement current;
+    if(current.threads == placement.threads and current.pin == placement.pin and
+       current.cpus == placement.cpus)
+        return;
+    current = placement;
+#ifndef MIGRAPHX_DISABLE_OMP
+    omp_set_num_threads(placement.get_threads());
+#endif
+    // Run an empty region so every thread of the team is bound
+    auto n = placement.get_threads();
+    parallel_for_impl(
+        n, n, [](std::size_t, std::size_t) {}, [&](std::size_t tid) { placement.bind(tid); });
+}
+
+void bind_dnnl_threads(migraphx::context& ctx) { any_cast<context>(ctx).bind_threads(); }
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
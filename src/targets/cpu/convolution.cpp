@@ -35,8 +35,80 @@ namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace cpu {
 
+template <class Op>
+shape adjust_convolution_shape(const Op& op, const shape& s, int i)
+{
+    if(i == 1 and op.group > 1)
+    {
+        // TODO: Add support for transposed weights
+        if(not s.standard())
+            MIGRAPHX_THROW("Weights for grouped convolution must be standard");
+        auto lens = s.lens();
+        lens.insert(lens.begin(), op.group);
+        lens.at(1) /= op.group;
+        return shape{s.type(), lens};
+    }
+    return s;
+}
+
+template <class Op>
+dnnl::convolution_forward::desc
+get_convolution_desc(const Op& op,
+                     const std::unordered_map<int, dnnl::memory::desc>& m,
+                     dnnl::algorithm algo = dnnl::algorithm::convolution_auto)
+{
+    // In DNNL dilation is zero-based
+    auto dilation = op.dilation;
+    std::transform(
+        dilation.begin(), dilation.end(), dilation.begin(), [](auto x) { return x - 1; });
+    auto kdims = op.kdims();
+    std::vector<size_t> padding_l(op.padding.begin(), op.padding.begin() + kdims);
+    std::vector<size_t> padding_r(op.padding.begin() + kdims, op.padding.end());
+    return {dnnl::prop_kind::forward_inference,
+            algo,
+            m.at(MIGRAPHX_DNNL_PREFIX(ARG_SRC)),
+            m.at(MIGRAPHX_DNNL_PREFIX(ARG_WEIGHTS)),
+            m.at(MIGRAPHX_DNNL_PREFIX(ARG_DST)),
+            to_dnnl_dims(op.stride),
+            to_dnnl_dims(dilation),
+            to_dnnl_dims(padding_l),
+            to_dnnl_dims(padding_r)};
+}
+
 struct dnnl_convolution
     : dnnl_extend_op<dnnl_convolution, dnnl::convolution_forward, op::convolution>
+{
+    // Selected by cpu::tune_ops, DNNL picks the algorithm with convolution_auto
+    std::string algo = "convolution_auto";
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack_join(self.reflect_base(self, f),
+                         migraphx::reflect(self.op, f),
+                         pack(f(self.algo, "algo")));
+    }
+
+    std::vector<int> arg_map(int) const
+    {
+        return {MIGRAPHX_DNNL_PREFIX(ARG_SRC), MIGRAPHX_DNNL_PREFIX(ARG_WEIGHTS)};
+    }
+
+    shape adjust_shape(const shape& x, int i, const shape& output) const
+    {
+        return adjust_convolution_shape(op, base_adjust_shape(x, output), i);
+    }
+
+    dnnl::convolution_forward::desc
+    get_desc(const std::unordered_map<int, dnnl::memory::desc>& m) const
+    {
+        return get_convolution_desc(op, m, to_dnnl_algo(algo));
+    }
+};
+
+struct dnnl_quant_convolution : dnnl_quant_extend_op<dnnl_quant_convolution,
+                                                     dnnl::convolution_forward,
+                                                     op::quant_convolution>
 {
     std::vector<int> arg_map(int) const
     {
@@ -45,39 +117,13 @@ struct dnnl_convolution
 
     shape adjust_shape(const shape& x, int i, const shape& output) const
     {
-        auto s = base_adjust_shape(x, output);
-        if(i == 1 and op.group > 1)
-        {
-            // TODO: Add support for transposed weights
-            if(not s.standard())
-                MIGRAPHX_THROW("Weights for grouped convolution must be standard");
-            auto lens = s.lens();
-            lens.insert(lens.begin(), op.group);
-            lens.at(1) /= op.group;
-            return shape{s.type(), lens};
-        }
-        return s;
+        return adjust_convolution_shape(op, base_adjust_shape(x, output), i);
     }
 
     dnnl::convolution_forward::desc
     get_desc(const std::unordered_map<int, dnnl::memory::desc>& m) const
     {
-        // In DNNL dilation is zero-based
-        auto dilation = op.dilation;
-        std::transform(
-            dilation.begin(), dilation.end(), dilation.begin(), [](auto x) { return x - 1; });
-        auto kdims = op.kdims();
-        std::vector<size_t> padding_l(op.padding.begin(), op.padding.begin() + kdims);
-        std::vector<size_t> padding_r(op.padding.begin() + kdims, op.padding.end());
-        return {dnnl::prop_kind::forward_inference,
-                dnnl::algorithm::convolution_auto,
-                m.at(MIGRAPHX_DNNL_PREFIX(ARG_SRC)),
-                m.at(MIGRAPHX_DNNL_PREFIX(ARG_WEIGHTS)),
-                m.at(MIGRAPHX_DNNL_PREFIX(ARG_DST)),
-                to_dnnl_dims(op.stride),
-                to_dnnl_dims(dilation),
-                to_dnnl_dims(padding_l),
-                to_dnnl_dims(padding_r)};
+        return get_convolution_desc(op, m);
     }
 };
 
@@ -30,10 +30,13 @@ namespace cpu {
 
 struct cpu_copy : reduce_dims_base, auto_register_op<cpu_copy>
 {
+    // Smallest number of elements run by a thread, selected by cpu::tune_ops
+    std::size_t min_grain = 1024;
+
     template <class Self, class F>
-    static auto reflect(Self&, F)
+    static auto reflect(Self& self, F f)
     {
-        return pack();
+        return pack(f(self.min_grain, "min_grain"));
     }
 
     std::string name() const { return "cpu::copy"; }
@@ -48,7 +51,8 @@ struct cpu_copy : reduce_dims_base, auto_register_op<cpu_copy>
         argument result = get_arg(args, args.size() - 1);
 
         visit_all(result, get_arg(args, 0))([&](auto output, auto input) {
-            pointwise(output, input)(ctx, output.get_shape(), 1024, [](auto& y, auto x) { y = x; });
+            pointwise(output, input)(
+                ctx, output.get_shape(), min_grain, [](auto& y, auto x) { y = x; });
         });
 
         return result.reshape(output_shape);
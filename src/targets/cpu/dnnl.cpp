@@ -22,6 +22,9 @@
  * THE SOFTWARE.
  */
 #include <migraphx/cpu/dnnl.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/stringutils.hpp>
+#include <mutex>
 
 #if defined(__GNUC__) && __GNUC__ <= 5
 namespace std {
@@ -64,6 +67,7 @@ dnnl::memory::data_type to_dnnl_memory_data_type(shape::type_t t)
     switch(t)
     {
     case st::half_type: return dt::f16;
+    case st::bf16_type: return dt::bf16;
     case st::float_type: return dt::f32;
     case st::int32_type: return dt::s32;
     case st::int8_type: return dt::s8;
@@ -76,6 +80,29 @@ dnnl::memory::data_type to_dnnl_memory_data_type(shape::type_t t)
 #pragma clang diagnostic pop
 #endif
 
+bool dnnl_has_native_type(shape::type_t t)
+{
+    static std::unordered_map<shape::type_t, bool> cache;
+    static std::mutex m;
+    std::lock_guard<std::mutex> lock(m);
+    if(not contains(cache, t))
+    {
+        try
+        {
+            dnnl::memory::desc md(
+                {64, 64}, to_dnnl_memory_data_type(t), dnnl::memory::format_tag::ab);
+            dnnl::matmul::desc desc{md, md, md};
+            dnnl::matmul::primitive_desc pd{desc, get_dnnl_context().engine};
+            cache[t] = not starts_with(pd.impl_info_str(), "ref");
+        }
+        catch(const dnnl::error&)
+        {
+            cache[t] = false;
+        }
+    }
+    return cache.at(t);
+}
+
 dnnl::memory::format_tag to_dnnl_memory_format_tag(std::size_t n)
 {
     switch(n)
@@ -200,6 +227,53 @@ std::string to_string(const dnnl::algorithm& algo)
     return dnnl_algo_string_map().at(algo);
 }
 
+std::shared_ptr<const dnnl::primitive>
+get_dnnl_primitive(const std::string& key, const std::function<dnnl::primitive()>& make)
+{
+    static std::unordered_map<std::string, std::weak_ptr<const dnnl::primitive>> cache; // NOLINT
+    static std::mutex m;
+    std::lock_guard<std::mutex> lock(m);
+    auto it = cache.find(key);
+    if(it != cache.end())
+    {
+        if(auto result = it->second.lock())
+            return result;
+    }
+    // Drop the primitives of the ops that were destroyed
+    for(auto i = cache.begin(); i != cache.end();)
+    {
+        if(i->second.expired())
+            i = cache.erase(i);
+        else
+            ++i;
+    }
+    auto result = std::make_shared<const dnnl::primitive>(make());
+    cache[key]  = result;
+    return result;
+}
+
+static std::unordered_map<std::string, weights_packer>& weights_packers()
+{
+    static std::unordered_map<std::string, weights_packer> m; // NOLINT
+    return m;
+}
+
+void register_weights_packer(const std::string& name, weights_packer f)
+{
+    weights_packers()[name] = std::move(f);
+}
+
+argument pack_dnnl_weights(const operation& op,
+                           const shape& output,
+                           const std::vector<shape>& inputs,
+                           const argument& weights)
+{
+    auto it = weights_packers().find(op.name());
+    if(it == weights_packers().end())
+        MIGRAPHX_THROW("Weights of " + op.name() + " cannot be packed");
+    return it->second(op, output, inputs, weights);
+}
+
 } // namespace cpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
@@ -23,6 +23,7 @@
  */
 #include <migraphx/config.hpp>
 #include <migraphx/cpu/pointwise.hpp>
+#include <migraphx/permutation.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -49,10 +50,10 @@ struct dnnl_eltwise : dnnl_op<dnnl_eltwise, dnnl::eltwise_forward>
         // Compensate for allocation
         inputs.pop_back();
         check_shapes{this->trim_post_op_inputs(inputs), *this}.has(1).packed();
+        // The eltwise primitive writes the output in the layout of the input, so strided views
+        // such as slices are reordered first and the output keeps the input's permutation
         auto s = inputs.at(0);
-        auto r = s;
-        if(not s.packed())
-            r = shape{s.type(), s.lens()};
+        auto r = shape::from_permutation(s.type(), s.lens(), find_permutation(s));
         // Call to get_primitive to make sure an algo is available
         this->get_primitive(this->to_memory_desc(r, inputs));
         return r;
@@ -49,27 +49,12 @@ struct cpu_gather : auto_register_op<cpu_gather>
     }
 
     argument
-    compute(context& ctx, const shape& output_shape, const std::vector<argument>& args) const
+    compute(context& ctx, const shape&, const std::vector<argument>& args) const
     {
-        std::size_t nelements = output_shape.elements();
-        auto lens             = args[0].get_shape().lens();
-        auto axis_dim_size    = lens[op.axis];
-        lens[op.axis]         = args[1].get_shape().elements();
-        shape out_comp{output_shape.type(), lens};
-
         visit_all(args.back(), args[0])([&](auto output, auto input) {
             args[1].visit([&](auto indices) {
-                const auto* indices_ptr = indices.data();
-                auto* output_ptr        = output.data();
-                ctx.bulk_execute(nelements, 1024, [=](auto start, auto end) {
-                    for(auto i = start; i < end; i++)
-                    {
-                        auto idx      = out_comp.multi(i);
-                        auto in_index = indices_ptr[idx[op.axis]];
-                        in_index      = (in_index < 0) ? in_index + axis_dim_size : in_index;
-                        idx[op.axis]  = in_index;
-                        output_ptr[i] = input(idx.begin(), idx.end());
-                    }
+                op.gather_rows(output, input, indices, [&](auto n, auto grain, auto f) {
+                    ctx.bulk_for(n, grain, f);
                 });
             });
         });
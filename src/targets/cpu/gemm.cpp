@@ -28,12 +28,47 @@
 #include <migraphx/cpu/context.hpp>
 #include <migraphx/cpu/dnnl.hpp>
 #include <migraphx/op/dot.hpp>
+#include <migraphx/op/grouped_dot.hpp>
 #include <migraphx/op/quant_dot.hpp>
+#include <algorithm>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace cpu {
 
+// DNNL broadcasts the batch dimensions of a matmul, so only the matrices need to be in memory
+template <class T>
+void check_matrices_not_broadcasted(const check_shapes<T>& cs)
+{
+    if(cs.any_of([](const shape& s) {
+           auto n = s.lens().size();
+           for(auto i = std::max<std::size_t>(n, 2) - 2; i < n; i++)
+           {
+               if(s.strides()[i] == 0 and s.lens()[i] > 1)
+                   return true;
+           }
+           return false;
+       }))
+        MIGRAPHX_THROW("DNNL_GEMM: matrices cannot be broadcasted");
+}
+
+// Use a dimension of 1 for broadcasted batch dimensions, which DNNL broadcasts itself
+inline shape adjust_batch_shape(const shape& s)
+{
+    if(not s.broadcasted())
+        return s;
+    auto lens    = s.lens();
+    auto strides = s.strides();
+    for(std::size_t i = 0; i < lens.size(); i++)
+    {
+        if(strides[i] != 0)
+            continue;
+        lens[i]    = 1;
+        strides[i] = 1;
+    }
+    return {s.type(), lens, strides};
+}
+
 struct dnnl_gemm : dnnl_extend_op<dnnl_gemm, dnnl::matmul, op::dot>
 {
     std::vector<int> arg_map(int) const
@@ -46,9 +81,34 @@ struct dnnl_gemm : dnnl_extend_op<dnnl_gemm, dnnl::matmul, op::dot>
     template <class T>
     void required(const check_shapes<T>& cs) const
     {
-        cs.not_broadcasted();
+        check_matrices_not_broadcasted(cs);
+    }
+
+    shape adjust_shape(const shape& x, int, const shape&) const { return adjust_batch_shape(x); }
+
+    dnnl::matmul::desc get_desc(const std::unordered_map<int, dnnl::memory::desc>& m) const
+    {
+        return {m.at(MIGRAPHX_DNNL_PREFIX(ARG_SRC)),
+                m.at(MIGRAPHX_DNNL_PREFIX(ARG_WEIGHTS)),
+                m.at(MIGRAPHX_DNNL_PREFIX(ARG_DST))};
+    }
+};
+
+struct dnnl_quant_gemm : dnnl_quant_extend_op<dnnl_quant_gemm, dnnl::matmul, op::quant_dot>
+{
+    std::vector<int> arg_map(int) const
+    {
+        return {MIGRAPHX_DNNL_PREFIX(ARG_SRC), MIGRAPHX_DNNL_PREFIX(ARG_WEIGHTS)};
+    }
+
+    template <class T>
+    void required(const check_shapes<T>& cs) const
+    {
+        check_matrices_not_broadcasted(cs);
     }
 
+    shape adjust_shape(const shape& x, int, const shape&) const { return adjust_batch_shape(x); }
+
     dnnl::matmul::desc get_desc(const std::unordered_map<int, dnnl::memory::desc>& m) const
     {
         return {m.at(MIGRAPHX_DNNL_PREFIX(ARG_SRC)),
@@ -57,6 +117,69 @@ struct dnnl_gemm : dnnl_extend_op<dnnl_gemm, dnnl::matmul, op::dot>
     }
 };
 
+// Every group has the same shapes, so one matmul primitive runs each group on its inputs and its
+// slice of the output in turn
+struct dnnl_grouped_gemm
+{
+    dnnl_gemm gemm;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return migraphx::reflect(self.gemm, f);
+    }
+
+    std::string name() const { return "dnnl::grouped_dot"; }
+
+    static shape group_output(const shape& output)
+    {
+        auto lens = output.lens();
+        lens.erase(lens.begin());
+        return {output.type(), lens};
+    }
+
+    // The shapes of the first group, the inputs include the allocation
+    static std::vector<shape> group_shapes(const shape& output, const std::vector<shape>& inputs)
+    {
+        auto n = (inputs.size() - 1) / 2;
+        return {inputs.front(), inputs.at(n), group_output(output)};
+    }
+
+    shape compute_shape(const std::vector<shape>& inputs) const
+    {
+        // Compensate for allocation
+        auto r = op::grouped_dot{}.compute_shape({inputs.begin(), inputs.end() - 1});
+        gemm.compute_shape(group_shapes(r, inputs));
+        return r;
+    }
+
+    void
+    finalize(migraphx::context& ctx, const shape& output_shape, const std::vector<shape>& inputs)
+    {
+        auto shapes = group_shapes(output_shape, inputs);
+        gemm.finalize(ctx, shapes.back(), shapes);
+    }
+
+    argument compute(migraphx::context& ctx,
+                     const shape& output_shape,
+                     const std::vector<argument>& args) const
+    {
+        auto n      = (args.size() - 1) / 2;
+        auto result = args.back();
+        auto gs     = group_output(output_shape);
+        for(std::size_t i = 0; i < n; i++)
+            gemm.compute(
+                ctx, gs, {args[i], args[n + i], argument{gs, result.data() + i * gs.bytes()}});
+        return result;
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
+    {
+        return shapes.size() - 1;
+    }
+};
+MIGRAPHX_REGISTER_OP(dnnl_grouped_gemm)
+
 } // namespace cpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
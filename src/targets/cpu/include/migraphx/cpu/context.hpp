@@ -25,6 +25,10 @@
 #define MIGRAPHX_GUARD_RTGLIB_CONTEXT_HPP
 
 #include <migraphx/config.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/compile_options.hpp>
+#include <migraphx/env.hpp>
+#include <migraphx/value.hpp>
 #include <migraphx/cpu/dnnl.hpp>
 #include <migraphx/cpu/parallel.hpp>
 #include <migraphx/par_for.hpp>
@@ -34,14 +38,40 @@ namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace cpu {
 
-struct context
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_ENABLE_CPU_REDUCE_FUSION)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_PREPACK_WEIGHTS)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_ENABLE_NHWC)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_ENABLE_BATCH_DOT)
+
+struct MIGRAPHX_CPU_EXPORT context
 {
+    /// NUMA node the context runs on, or -1 when it runs on every node
+    int numa_node              = -1;
+    thread_placement placement = {};
+
     void finish() const {}
 
+    /// The placement, with the DNNL version, the ISA and the compile settings the program was
+    /// compiled for
+    value to_value() const;
+    void from_value(const value& v);
+
+    /// Set the threads and NUMA node from the compile options
+    void set_placement(const compile_options& options);
+
+    /// Allocate an argument on the NUMA node of the context
+    argument allocate(const shape& s) const;
+
+    /// Copy an argument to the NUMA node of the context, when it is bound to one
+    argument to_numa_node(const argument& a) const;
+
+    /// Apply the placement to the OpenMP threads of the calling thread, which DNNL also uses
+    void bind_threads() const;
+
     template <class F>
     void bulk_execute(std::size_t n, std::size_t min_grain, F f)
     {
-        cpu::parallel_for(n, min_grain, f);
+        cpu::parallel_for(n, min_grain, placement, f);
     }
 
     template <class F>
@@ -49,6 +79,16 @@ struct context
     {
         this->bulk_execute(n, 256, f);
     }
+
+    /// Run f(i) for every i in [0, n), in chunks of at least min_grain
+    template <class F>
+    void bulk_for(std::size_t n, std::size_t min_grain, F f)
+    {
+        this->bulk_execute(n, min_grain, [&](auto start, auto end) {
+            for(auto i = start; i < end; i++)
+                f(i);
+        });
+    }
 };
 
 } // namespace cpu
@@ -29,9 +29,12 @@
 #include <migraphx/reflect.hpp>
 #include <migraphx/register_op.hpp>
 #include <migraphx/check_shapes.hpp>
+#include <migraphx/optional.hpp>
 #include <unordered_map>
 #include <migraphx/errors.hpp>
 #include <migraphx/assert.hpp>
+#include <functional>
+#include <sstream>
 #ifdef MIGRAPHX_ENABLE_ZENDNN
 #include <zendnn.hpp>
 #else
@@ -59,8 +62,14 @@ struct dnnl_context
 
 dnnl_context& get_dnnl_context();
 
+// Make the OpenMP threads used by DNNL follow the thread placement of the cpu context
+void bind_dnnl_threads(context& ctx);
+
 dnnl::memory::data_type to_dnnl_memory_data_type(shape::type_t t);
 
+// Check if DNNL has an optimized implementation for the type instead of the reference one
+bool dnnl_has_native_type(shape::type_t t);
+
 dnnl::memory::format_tag to_dnnl_memory_format_tag(std::size_t n);
 
 template <class R>
@@ -79,6 +88,36 @@ dnnl::algorithm to_dnnl_algo(const std::string& name);
 
 std::string to_string(const dnnl::algorithm& algo);
 
+// Get a primitive from a process-wide cache, so identical layers share the same primitive. The
+// cache only holds the primitives that are still used by a compiled op.
+std::shared_ptr<const dnnl::primitive>
+get_dnnl_primitive(const std::string& key, const std::function<dnnl::primitive()>& make);
+
+using weights_packer = std::function<argument(
+    const operation& op, const shape& output, const std::vector<shape>& inputs, const argument& w)>;
+
+void register_weights_packer(const std::string& name, weights_packer f);
+
+// Reorder the constant weights of the op to the layout chosen by its primitive
+argument pack_dnnl_weights(const operation& op,
+                           const shape& output,
+                           const std::vector<shape>& inputs,
+                           const argument& weights);
+
+struct register_weights_packer_action
+{
+    template <class T>
+    static void apply()
+    {
+        register_weights_packer(
+            T{}.name(),
+            [](const operation& op,
+               const shape& output,
+               const std::vector<shape>& inputs,
+               const argument& w) { return any_cast<T>(op).pack_weights(output, inputs, w); });
+    }
+};
+
 struct post_op : reflect_equality<post_op>, reflect_stream<post_op>
 {
     std::string algo;
@@ -91,11 +130,44 @@ struct post_op : reflect_equality<post_op>, reflect_stream<post_op>
     }
 };
 
+// Output scales and zero points of a quantized primitive. The scales are applied to the
+// accumulator before the post ops, so requantization can be folded into the primitive.
+struct quant_params : reflect_equality<quant_params>
+{
+    std::vector<float> scales;
+    // Bit mask of the output dimensions the scales vary along
+    int scale_mask     = 0;
+    int src_zero_point = 0;
+    int dst_zero_point = 0;
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.scales, "scales"),
+                    f(self.scale_mask, "scale_mask"),
+                    f(self.src_zero_point, "src_zero_point"),
+                    f(self.dst_zero_point, "dst_zero_point"));
+    }
+
+    void apply(dnnl::primitive_attr& attr) const
+    {
+        if(not scales.empty())
+            attr.set_output_scales(scale_mask, scales);
+        if(src_zero_point != 0)
+            attr.set_zero_points(MIGRAPHX_DNNL_PREFIX(ARG_SRC), 0, {src_zero_point});
+        if(dst_zero_point != 0)
+            attr.set_zero_points(MIGRAPHX_DNNL_PREFIX(ARG_DST), 0, {dst_zero_point});
+    }
+};
+
 template <class F>
 struct execute_wrapper
 {
     F f;
-    argument operator()(context&, const std::vector<argument>& args) const { return f(args); }
+    argument operator()(context& ctx, const std::vector<argument>& args) const
+    {
+        bind_dnnl_threads(ctx);
+        return f(args);
+    }
 };
 
 template <class F>
@@ -105,15 +177,18 @@ execute_wrapper<F> make_execute_wrapper(F f)
 }
 
 template <class Derived, class Primitive>
-struct dnnl_op : auto_register_op<Derived>
+struct dnnl_op : auto_register_op<Derived>, auto_register<register_weights_packer_action, Derived>
 {
     std::vector<post_op> post_ops;
+    // The shape of constant weights that were reordered at compile time to the layout chosen by
+    // the primitive, the weights input then holds the reordered data
+    optional<shape> packed_weights;
     std::function<argument(context& ctx, const std::vector<argument>& args)> execute;
 
     template <class Self, class F>
     static auto reflect_base(Self& self, F f)
     {
-        return pack(f(self.post_ops, "post_ops"));
+        return pack(f(self.post_ops, "post_ops"), f(self.packed_weights, "packed_weights"));
     }
 
     template <class Self, class F>
@@ -180,6 +255,23 @@ struct dnnl_op : auto_register_op<Derived>
         std::iota(result.begin(), result.end(), MIGRAPHX_DNNL_PREFIX(ARG_SRC_0));
         return result;
     }
+    // Index of the weights input, or -1 when the primitive has no weights
+    int weights_index() const
+    {
+        const auto& self = static_cast<const Derived&>(*this);
+        auto m           = self.arg_map(2);
+        auto it          = std::find(m.begin(), m.end(), MIGRAPHX_DNNL_PREFIX(ARG_WEIGHTS));
+        if(it == m.end())
+            return -1;
+        return it - m.begin();
+    }
+    // Use the shape of the weights before they were reordered
+    std::vector<shape> unpack_weights(std::vector<shape> inputs) const
+    {
+        if(packed_weights.has_value())
+            inputs.at(weights_index()) = *packed_weights;
+        return inputs;
+    }
     shape base_adjust_shape(const shape& s, const shape& output) const
     {
         if(s.broadcasted())
@@ -236,9 +328,10 @@ struct dnnl_op : auto_register_op<Derived>
         return m;
     }
     std::unordered_map<int, dnnl::memory::desc>
-    to_memory_desc(const shape& output_shape, const std::vector<shape>& inputs) const
+    to_memory_desc(const shape& output_shape, const std::vector<shape>& packed_inputs) const
     {
         const auto& self = static_cast<const Derived&>(*this);
+        auto inputs      = unpack_weights(packed_inputs);
         std::unordered_map<int, dnnl::memory::desc> result;
         result[MIGRAPHX_DNNL_PREFIX(ARG_DST)] =
             to_dnnl_memory_desc(self.adjust_shape(output_shape, inputs.size(), output_shape));
@@ -248,6 +341,12 @@ struct dnnl_op : auto_register_op<Derived>
         {
             result[m[i]] = to_dnnl_memory_desc(self.adjust_shape(inputs[i], i, output_shape));
         }
+        // Let the primitive choose the layout of the weights
+        if(packed_weights.has_value() and contains(result, MIGRAPHX_DNNL_PREFIX(ARG_WEIGHTS)))
+        {
+            auto& w = result[MIGRAPHX_DNNL_PREFIX(ARG_WEIGHTS)];
+            w = dnnl::memory::desc(w.dims(), w.data_type(), dnnl::memory::format_tag::any);
+        }
         return result;
     }
     dnnl::primitive_attr
@@ -282,13 +381,16 @@ struct dnnl_op : auto_register_op<Derived>
     {
         return typename Primitive::primitive_desc(desc, attr, get_dnnl_context().engine);
     }
-    Primitive get_primitive(const std::unordered_map<int, dnnl::memory::desc>& m) const
+    auto make_primitive_desc(const std::unordered_map<int, dnnl::memory::desc>& m) const
     {
         const auto& self = static_cast<const Derived&>(*this);
         auto desc        = self.get_desc(m);
-        auto attr        = MIGRAPHX_ASSERT_NO_THROW(this->get_primitive_attr(m));
-        auto pd          = self.get_primitive_desc(desc, attr);
-        return Primitive(pd);
+        auto attr        = MIGRAPHX_ASSERT_NO_THROW(self.get_primitive_attr(m));
+        return self.get_primitive_desc(desc, attr);
+    }
+    Primitive get_primitive(const std::unordered_map<int, dnnl::memory::desc>& m) const
+    {
+        return Primitive(make_primitive_desc(m));
     }
     argument compute(context& ctx, const shape&, const std::vector<argument>& args) const
     {
@@ -299,6 +401,28 @@ struct dnnl_op : auto_register_op<Derived>
     {
         return shapes.size() - 1;
     }
+    // Reorder the weights to the layout of the primitive, the inputs do not include the
+    // allocation
+    argument
+    pack_weights(const shape& output_shape, std::vector<shape> inputs, const argument& w) const
+    {
+        const auto& self = static_cast<const Derived&>(*this);
+        auto i           = weights_index();
+        if(i < 0 or not packed_weights.has_value())
+            MIGRAPHX_THROW(self.name() + ": No weights to pack");
+        inputs.at(i)  = w.get_shape();
+        auto pd       = make_primitive_desc(to_memory_desc(output_shape, inputs));
+        auto desc     = pd.query_md(dnnl::query::weights_md, 0);
+        auto src_desc = to_dnnl_memory_desc(self.adjust_shape(w.get_shape(), i, output_shape));
+        auto type     = w.get_shape().type();
+        argument result{shape{type, {desc.get_size() / shape{type}.type_size()}}};
+        auto& ctx = get_dnnl_context();
+        auto src  = to_dnnl_memory(src_desc, w);
+        auto dst  = to_dnnl_memory(desc, result);
+        dnnl::reorder(src, dst).execute(ctx.stream, src, dst);
+        ctx.stream.wait();
+        return result;
+    }
     value compile(context&, const shape& output_shape, std::vector<shape> inputs)
     {
         // Compensate for allocation
@@ -316,8 +440,23 @@ struct dnnl_op : auto_register_op<Derived>
         const auto& self = static_cast<const Derived&>(*this);
         auto name        = self.name();
         auto md          = to_memory_desc(output_shape, inputs);
-        auto prim        = get_primitive(md);
-        auto arg_lookup  = create_arg_map(inputs.size());
+        auto pd          = make_primitive_desc(md);
+        // The op and the shapes determine the primitive
+        std::stringstream key;
+        key << name << migraphx::to_value(self) << output_shape;
+        for(const auto& input : inputs)
+            key << input;
+        auto prim       = get_dnnl_primitive(key.str(), [&] { return Primitive(pd); });
+        auto arg_lookup = create_arg_map(inputs.size());
+        auto args_md    = md;
+        if(packed_weights.has_value())
+        {
+            auto w = MIGRAPHX_DNNL_PREFIX(ARG_WEIGHTS);
+            // The reordered weights are read with the layout chosen by the primitive
+            args_md[w] = pd.query_md(dnnl::query::weights_md, 0);
+            if(args_md[w].get_size() != inputs.at(weights_index()).bytes())
+                MIGRAPHX_THROW(name + ": Packed weights do not match the layout of the primitive");
+        }
 #ifndef NDEBUG
         auto prim_attr = get_primitive_attr(md);
 #endif
@@ -387,10 +526,10 @@ struct dnnl_op : auto_register_op<Derived>
 #endif
             std::unordered_map<int, dnnl::memory> m;
             m[MIGRAPHX_DNNL_PREFIX(ARG_DST)] =
-                to_dnnl_memory(md.at(MIGRAPHX_DNNL_PREFIX(ARG_DST)), args.back());
+                to_dnnl_memory(args_md.at(MIGRAPHX_DNNL_PREFIX(ARG_DST)), args.back());
             for(int i = 0; i < args.size() - 1; i++)
-                m[arg_lookup[i]] = to_dnnl_memory(md.at(arg_lookup[i]), args[i]);
-            prim.execute(get_dnnl_context().stream, m);
+                m[arg_lookup[i]] = to_dnnl_memory(args_md.at(arg_lookup[i]), args[i]);
+            prim->execute(get_dnnl_context().stream, m);
             return args.back();
         });
     }
@@ -425,6 +564,7 @@ struct dnnl_extend_op : dnnl_op<Derived, Primitive>
         const auto& self = static_cast<const Derived&>(*this);
         // Compensate for allocation
         inputs.pop_back();
+        inputs = this->unpack_weights(inputs);
         self.required(check_shapes(inputs, self));
         auto r = migraphx::compute_shape(op, this->trim_post_op_inputs(inputs));
         // Call to get_primitive to make sure an algo is available
@@ -433,6 +573,45 @@ struct dnnl_extend_op : dnnl_op<Derived, Primitive>
     }
 };
 
+template <class Derived, class Primitive, class Op>
+struct dnnl_quant_extend_op : dnnl_extend_op<Derived, Primitive, Op>
+{
+    quant_params qparams;
+    // The accumulator is int32, but folding dequantizelinear or quantizelinear into the
+    // primitive changes the output to float or int8
+    shape::type_t output_type = shape::int32_type;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack_join(self.reflect_base(self, f),
+                         migraphx::reflect(self.op, f),
+                         pack(f(self.qparams, "qparams"), f(self.output_type, "output_type")));
+    }
+
+    dnnl::primitive_attr
+    get_primitive_attr(const std::unordered_map<int, dnnl::memory::desc>& m) const
+    {
+        auto attr = dnnl_op<Derived, Primitive>::get_primitive_attr(m);
+        qparams.apply(attr);
+        return attr;
+    }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        const auto& self = static_cast<const Derived&>(*this);
+        // Compensate for allocation
+        inputs.pop_back();
+        inputs = this->unpack_weights(inputs);
+        self.required(check_shapes(inputs, self));
+        auto r = migraphx::compute_shape(this->op, this->trim_post_op_inputs(inputs))
+                     .with_type(output_type);
+        // Call to get_primitive to make sure an algo is available
+        this->get_primitive(this->to_memory_desc(r, inputs));
+        return r;
+    }
+};
+
 } // namespace cpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
@@ -27,6 +27,8 @@
 // #define MIGRAPHX_DISABLE_OMP
 #include <cmath>
 #include <migraphx/config.hpp>
+#include <migraphx/numa.hpp>
+#include <vector>
 #ifdef MIGRAPHX_DISABLE_OMP
 #include <migraphx/par_for.hpp>
 #else
@@ -50,11 +52,12 @@ namespace cpu {
 
 inline std::size_t max_threads() { return std::thread::hardware_concurrency(); }
 
-template <class F>
-void parallel_for_impl(std::size_t n, std::size_t threadsize, F f)
+template <class F, class B>
+void parallel_for_impl(std::size_t n, std::size_t threadsize, F f, B bind)
 {
     if(threadsize <= 1)
     {
+        bind(std::size_t{0});
         f(std::size_t{0}, n);
     }
     else
@@ -67,10 +70,14 @@ void parallel_for_impl(std::size_t n, std::size_t threadsize, F f)
             std::size_t grainsize = std::ceil(static_cast<double>(n) / threads.size());
 
         std::size_t work = 0;
-        std::generate(threads.begin(), threads.end(), [=, &work] {
-            auto result =
-                joinable_thread([=]() mutable { f(work, std::min(n, work + grainsize)); });
+        std::size_t tid  = 0;
+        std::generate(threads.begin(), threads.end(), [=, &work, &tid] {
+            auto result = joinable_thread([=]() mutable {
+                bind(tid);
+                f(work, std::min(n, work + grainsize));
+            });
             work += grainsize;
+            tid++;
             return result;
         });
         // cppcheck-suppress unsignedLessThanZero
@@ -81,30 +88,72 @@ void parallel_for_impl(std::size_t n, std::size_t threadsize, F f)
 
 inline std::size_t max_threads() { return omp_get_max_threads(); }
 
-template <class F>
-void parallel_for_impl(std::size_t n, std::size_t threadsize, F f)
+template <class F, class B>
+void parallel_for_impl(std::size_t n, std::size_t threadsize, F f, B bind)
 {
     if(threadsize <= 1)
     {
+        bind(std::size_t{0});
         f(std::size_t{0}, n);
     }
     else
     {
         std::size_t grainsize = std::ceil(static_cast<double>(n) / threadsize);
-#pragma omp parallel for num_threads(threadsize) schedule(static, 1) private(grainsize, n)
+#pragma omp parallel for num_threads(threadsize) schedule(static, 1) firstprivate(grainsize, n)
         for(std::size_t tid = 0; tid < threadsize; tid++)
         {
+            bind(tid);
             std::size_t work = tid * grainsize;
             f(work, std::min(n, work + grainsize));
         }
     }
 }
 #endif
+
+/// The number of threads used by parallel_for and the CPUs they run on
+struct thread_placement
+{
+    /// Number of threads, 0 uses max_threads()
+    std::size_t threads = 0;
+    /// CPUs the threads run on, the threads are left unbound when it is empty
+    std::vector<std::size_t> cpus = {};
+    /// Bind each thread to one CPU instead of letting it run on any of them
+    bool pin = false;
+
+    std::size_t get_threads() const { return threads == 0 ? max_threads() : threads; }
+
+    /// Bind the calling thread, which is skipped when it was already bound to the same CPUs
+    void bind(std::size_t tid) const
+    {
+        if(cpus.empty())
+            return;
+        thread_local std::vector<std::size_t> bound;
+        if(pin)
+        {
+            auto cpu = cpus[tid % cpus.size()];
+            if(bound.size() == 1 and bound.front() == cpu)
+                return;
+            if(set_thread_affinity({cpu}))
+                bound = {cpu};
+        }
+        else if(bound != cpus and set_thread_affinity(cpus))
+        {
+            bound = cpus;
+        }
+    }
+};
+
+template <class F>
+void parallel_for(std::size_t n, std::size_t min_grain, const thread_placement& placement, F f)
+{
+    const auto threadsize = std::min<std::size_t>(placement.get_threads(), n / min_grain);
+    parallel_for_impl(n, threadsize, f, [&](std::size_t tid) { placement.bind(tid); });
+}
+
 template <class F>
 void parallel_for(std::size_t n, std::size_t min_grain, F f)
 {
-    const auto threadsize = std::min<std::size_t>(max_threads(), n / min_grain);
-    parallel_for_impl(n, threadsize, f);
+    parallel_for(n, min_grain, thread_placement{}, f);
 }
 
 template <class F>
@@ -333,11 +333,13 @@ template <class Op>
 struct cpu_unary : reduce_dims_base, auto_register_op<cpu_unary<Op>>
 {
     Op op;
+    // Smallest number of elements run by a thread, selected by cpu::tune_ops
+    std::size_t min_grain = 1024;
 
     template <class Self, class F>
     static auto reflect(Self& self, F f)
     {
-        return migraphx::reflect(self.op, f);
+        return pack_join(migraphx::reflect(self.op, f), pack(f(self.min_grain, "min_grain")));
     }
     std::string name() const { return "cpu::" + op.name(); }
     shape compute_shape(const std::vector<shape>& inputs) const
@@ -354,7 +356,7 @@ struct cpu_unary : reduce_dims_base, auto_register_op<cpu_unary<Op>>
         visit_all(result, get_arg(args, 0))([&](auto output, auto input) {
             auto op2 = op;
             pointwise(output, input)(
-                ctx, output.get_shape(), 1024, [op2](auto& y, auto x) { y = op2.apply()(x); });
+                ctx, output.get_shape(), min_grain, [op2](auto& y, auto x) { y = op2.apply()(x); });
         });
 
         return result.reshape(output_shape);
@@ -370,11 +372,13 @@ template <class Op>
 struct cpu_binary : reduce_dims_base, auto_register_op<cpu_binary<Op>>
 {
     Op op;
+    // Smallest number of elements run by a thread, selected by cpu::tune_ops
+    std::size_t min_grain = 1024;
 
     template <class Self, class F>
     static auto reflect(Self& self, F f)
     {
-        return migraphx::reflect(self.op, f);
+        return pack_join(migraphx::reflect(self.op, f), pack(f(self.min_grain, "min_grain")));
     }
     std::string name() const { return "cpu::" + op.name(); }
     shape compute_shape(const std::vector<shape>& inputs) const
@@ -393,7 +397,7 @@ struct cpu_binary : reduce_dims_base, auto_register_op<cpu_binary<Op>>
             [&](auto output, auto input1, auto input2) {
                 auto op2 = op;
                 pointwise(output, input1, input2)(
-                    ctx, output.get_shape(), 1024, [op2](auto& z, auto x, auto y) {
+                    ctx, output.get_shape(), min_grain, [op2](auto& z, auto x, auto y) {
                         z = op2.apply()(x, y);
                     });
             });
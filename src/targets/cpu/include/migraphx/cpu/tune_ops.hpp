@@ -0,0 +1,60 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_AMDMIGRAPHX_CPU_TUNE_OPS_HPP
+#define MIGRAPHX_GUARD_AMDMIGRAPHX_CPU_TUNE_OPS_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/cpu/export.h>
+#include <migraphx/filesystem.hpp>
+#include <string>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+struct module;
+namespace cpu {
+
+struct context;
+
+/// The tuning database set by MIGRAPHX_CPU_TUNING_DB, else one in the user's cache directory
+MIGRAPHX_CPU_EXPORT fs::path get_tuning_db_path();
+
+/**
+ * Select the convolution algorithm and the grain size of the lowered ops. Layouts are not tuned:
+ * prepack_weights lets DNNL pick the weights layout. The solutions are read from the tuning
+ * database, and when exhaustive is set the missing ones are found by benchmarking every candidate
+ * and are written to the database for later compiles.
+ */
+struct tune_ops
+{
+    context* ctx    = nullptr;
+    bool exhaustive = false;
+    std::string name() const { return "cpu::tune_ops"; }
+    void apply(module& m) const;
+};
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
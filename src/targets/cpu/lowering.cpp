@@ -49,6 +49,9 @@
 #include <migraphx/par_dfor.hpp>
 #include <migraphx/clamp.hpp>
 #include <migraphx/cpu/context.hpp>
+#include <migraphx/cpu/dnnl.hpp>
+#include <migraphx/float_equal.hpp>
+#include <migraphx/optional.hpp>
 #include <migraphx/register_op.hpp>
 #include <migraphx/make_op.hpp>
 #include <migraphx/program.hpp>
@@ -278,6 +281,16 @@ struct cpu_apply
         });
     }
 
+    // DNNL only has int8 primitives for signed weights
+    void extend_quant_op(const std::string& op_name, const std::string& cpu_name)
+    {
+        apply_map.emplace(op_name, [=](instruction_ref ins) {
+            if(ins->inputs().at(1)->get_shape().type() != shape::int8_type)
+                return ins;
+            return replace(ins, make_op(cpu_name, ins->get_operator().to_value()));
+        });
+    }
+
     void extend_dnnl_algos(const std::string& dnnl_name,
                            const std::vector<std::pair<std::string, std::string>>& algos)
     {
@@ -346,11 +359,20 @@ struct cpu_apply
 #ifndef MIGRAPHX_ENABLE_ZENDNN
         extend_op("convolution_backwards", "dnnl::convolution_backwards");
         extend_op("dot", "dnnl::dot");
+        extend_op("grouped_dot", "dnnl::grouped_dot");
+        extend_quant_op("quant_dot", "dnnl::quant_dot");
 #endif
+        extend_quant_op("quant_convolution", "dnnl::quant_convolution");
         extend_op("erf", "cpu::erf");
         extend_op("gather", "cpu::gather");
+        extend_op("layout", "dnnl::layout");
         extend_op("logsoftmax", "dnnl::logsoftmax");
         extend_op("lrn", "dnnl::lrn");
+        for(const std::string reduction : {"add", "max", "min", "mul", "none"})
+        {
+            extend_op("scatter_" + reduction, "cpu::scatter_" + reduction);
+            extend_op("scatternd_" + reduction, "cpu::scatternd_" + reduction);
+        }
         extend_op("softmax", "dnnl::softmax");
         extend_op("sub", "cpu::sub");
 
@@ -398,6 +420,14 @@ struct cpu_apply
             {
                 apply_pooling(it);
             }
+            else if(it->name() == "quantizelinear")
+            {
+                apply_quantizelinear(it);
+            }
+            else if(it->name() == "dequantizelinear")
+            {
+                apply_dequantizelinear(it);
+            }
             else if(apply_map.count(it->name()) > 0)
             {
                 apply_map.at(it->name())(it);
@@ -426,6 +456,141 @@ struct cpu_apply
         return ins;
     }
 
+    static bool is_quant_primitive(instruction_ref ins)
+    {
+        return contains({"dnnl::quant_dot", "dnnl::quant_convolution"}, ins->name()) and
+               ins->outputs().size() == 1;
+    }
+
+    // The output dimension of the per-channel scales supported by DNNL
+    static std::size_t quant_channel_axis(instruction_ref ins)
+    {
+        if(ins->name() == "dnnl::quant_convolution")
+            return 1;
+        return ins->get_shape().lens().size() - 1;
+    }
+
+    // Fold the dequantization of the int32 accumulator into the output scales of the primitive
+    instruction_ref apply_dequantizelinear(instruction_ref ins) const
+    {
+        auto x      = ins->inputs().front();
+        auto scales = read_scales(ins->inputs()[1]);
+        auto zp = ins->inputs().size() == 3 ? read_zero_point(ins->inputs()[2]) : optional<int>{0};
+        if(not scales.has_value() or not zp.has_value())
+            return ins;
+        if(is_quant_primitive(x) and x->get_shape().type() == shape::int32_type and *zp == 0 and
+           (scales->first == 0 or scales->first == (1 << quant_channel_axis(x))))
+        {
+            auto v        = x->get_operator().to_value();
+            auto qp       = from_value<quant_params>(v.at("qparams"));
+            qp.scales     = scales->second;
+            qp.scale_mask = scales->first;
+            return replace_quant_primitive(ins, x, qp);
+        }
+        quant_params qp;
+        qp.scales         = scales->second;
+        qp.scale_mask     = scales->first;
+        qp.src_zero_point = *zp;
+        return replace(ins, make_op("dnnl::quantize", {{"qparams", to_value(qp)}}), {x});
+    }
+
+    // Fold the requantization into a quantized primitive that was already dequantized, so the
+    // int8 output can be passed directly to the next quantized op
+    instruction_ref apply_quantizelinear(instruction_ref ins) const
+    {
+        auto x      = ins->inputs().front();
+        auto scales = read_scales(ins->inputs()[1]);
+        auto zp = ins->inputs().size() == 3 ? read_zero_point(ins->inputs()[2]) : optional<int>{0};
+        if(not scales.has_value() or not zp.has_value())
+            return ins;
+        std::transform(scales->second.begin(),
+                       scales->second.end(),
+                       scales->second.begin(),
+                       [](float s) { return 1.0f / s; });
+        if(is_quant_primitive(x) and x->get_shape().type() == shape::float_type and
+           scales->first == 0)
+        {
+            auto v       = x->get_operator().to_value();
+            auto qp      = from_value<quant_params>(v.at("qparams"));
+            auto y_scale = scales->second.front();
+            std::transform(qp.scales.begin(),
+                           qp.scales.end(),
+                           qp.scales.begin(),
+                           [&](float s) { return s * y_scale; });
+            qp.dst_zero_point = *zp;
+            return replace_quant_primitive(ins, x, qp);
+        }
+        quant_params qp;
+        qp.scales         = scales->second;
+        qp.scale_mask     = scales->first;
+        qp.dst_zero_point = *zp;
+        return replace(ins, make_op("dnnl::quantize", {{"qparams", to_value(qp)}}), {x});
+    }
+
+    // Replace ins with the quantized primitive x using new quantization parameters and the
+    // output type of ins
+    instruction_ref
+    replace_quant_primitive(instruction_ref ins, instruction_ref x, const quant_params& qp) const
+    {
+        auto v           = x->get_operator().to_value();
+        v["qparams"]     = to_value(qp);
+        v["output_type"] = to_value(ins->get_shape().type());
+        auto inputs      = x->inputs();
+        // Drop the allocation for the old output
+        inputs.pop_back();
+        return replace(ins, make_op(x->name(), v), inputs);
+    }
+
+    static bool all_along_axis(const std::vector<float>& v,
+                               const std::vector<float>& axis_values,
+                               std::size_t stride)
+    {
+        for(std::size_t i = 0; i < v.size(); i++)
+        {
+            if(not float_equal(v[i], axis_values[(i / stride) % axis_values.size()]))
+                return false;
+        }
+        return true;
+    }
+
+    // Read constant scales that are either the same everywhere or only vary along a single
+    // axis, returning the DNNL scale mask with the values
+    static optional<std::pair<int, std::vector<float>>> read_scales(instruction_ref ins)
+    {
+        if(ins->get_shape().type() != shape::float_type)
+            return nullopt;
+        auto a = ins->eval();
+        if(a.empty())
+            return nullopt;
+        std::vector<float> v;
+        a.visit([&](auto x) { v.assign(x.begin(), x.end()); });
+        if(std::all_of(v.begin(), v.end(), [&](float x) { return float_equal(x, v.front()); }))
+            return std::make_pair(0, std::vector<float>{v.front()});
+        shape s{shape::float_type, a.get_shape().lens()};
+        for(std::size_t axis = 0; axis < s.ndim(); axis++)
+        {
+            auto stride = s.strides()[axis];
+            std::vector<float> axis_values(s.lens()[axis]);
+            for(std::size_t j = 0; j < axis_values.size(); j++)
+                axis_values[j] = v[j * stride];
+            if(all_along_axis(v, axis_values, stride))
+                return std::make_pair(1 << axis, axis_values);
+        }
+        return nullopt;
+    }
+
+    static optional<int> read_zero_point(instruction_ref ins)
+    {
+        auto a = ins->eval();
+        if(a.empty())
+            return nullopt;
+        std::vector<int> v;
+        a.visit([&](auto x) { v.assign(x.begin(), x.end()); });
+        if(std::all_of(v.begin(), v.end(), [&](int x) { return x == v.front(); }))
+            return v.front();
+        return nullopt;
+    }
+
     template <class T>
     static std::vector<T> read_scalar(instruction_ref ins)
     {
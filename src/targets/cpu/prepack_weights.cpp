@@ -0,0 +1,67 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/cpu/prepack_weights.hpp>
+#include <migraphx/cpu/dnnl.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/serialize.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+void prepack_weights::apply(module& m) const
+{
+    // The weights are the second input of these primitives
+    static const std::vector<std::string> names = {
+        "dnnl::convolution", "dnnl::quant_convolution", "dnnl::dot", "dnnl::quant_dot"};
+    for(auto ins : iterator_for(m))
+    {
+        if(not contains(names, ins->name()))
+            continue;
+        auto w = ins->inputs().at(1);
+        if(w->name() != "@literal")
+            continue;
+        auto v = ins->get_operator().to_value();
+        if(not v.at("packed_weights").is_null())
+            continue;
+        v["packed_weights"] = to_value(w->get_shape());
+        auto op             = make_op(ins->name(), v);
+        auto inputs         = to_shapes(ins->inputs());
+        // Compensate for allocation
+        inputs.pop_back();
+        auto packed =
+            pack_dnnl_weights(op, ins->get_shape(), inputs, w->get_literal().get_argument());
+        auto args = ins->inputs();
+        args[1]   = m.add_literal(literal{packed.get_shape(), packed.data()});
+        m.replace_instruction(ins, op, args);
+    }
+}
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
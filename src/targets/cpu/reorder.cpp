@@ -23,11 +23,31 @@
  */
 #include <migraphx/config.hpp>
 #include <migraphx/cpu/dnnl.hpp>
+#include <migraphx/op/layout.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace cpu {
 
+// Custom desc class since its missing in dnnl
+struct reorder_desc
+{
+    dnnl::memory::desc src;
+    dnnl::memory::desc dst;
+};
+
+static reorder_desc get_reorder_desc(const std::unordered_map<int, dnnl::memory::desc>& m)
+{
+    return {m.at(MIGRAPHX_DNNL_PREFIX(ARG_SRC)), m.at(MIGRAPHX_DNNL_PREFIX(ARG_DST))};
+}
+
+static dnnl::reorder::primitive_desc get_reorder_primitive_desc(const reorder_desc& d,
+                                                                const dnnl::primitive_attr& attr)
+{
+    auto& engine = get_dnnl_context().engine;
+    return dnnl::reorder::primitive_desc(engine, d.src, engine, d.dst, attr);
+}
+
 struct dnnl_reorder : dnnl_op<dnnl_reorder, dnnl::reorder>
 {
     std::string name() const { return "dnnl::reorder"; }
@@ -42,21 +62,36 @@ struct dnnl_reorder : dnnl_op<dnnl_reorder, dnnl::reorder>
         this->get_primitive(this->to_memory_desc(r, inputs));
         return r;
     }
-    // Custom desc class since its missing in dnnl
-    struct desc
+    reorder_desc get_desc(const std::unordered_map<int, dnnl::memory::desc>& m) const
+    {
+        return get_reorder_desc(m);
+    }
+
+    auto get_primitive_desc(const reorder_desc& d, const dnnl::primitive_attr& attr) const
     {
-        dnnl::memory::desc src;
-        dnnl::memory::desc dst;
-    };
-    desc get_desc(const std::unordered_map<int, dnnl::memory::desc>& m) const
+        return get_reorder_primitive_desc(d, attr);
+    }
+};
+
+// The layout op is lowered to its own reorder, since eliminate_contiguous removes the
+// dnnl::reorder of contiguous ops and would undo the layout
+struct dnnl_layout : dnnl_extend_op<dnnl_layout, dnnl::reorder, op::layout>
+{
+    shape adjust_shape(const shape& x, int, const shape&) const { return x; }
+
+    template <class T>
+    void required(const check_shapes<T>&) const
+    {
+    }
+
+    reorder_desc get_desc(const std::unordered_map<int, dnnl::memory::desc>& m) const
     {
-        return {m.at(MIGRAPHX_DNNL_PREFIX(ARG_SRC)), m.at(MIGRAPHX_DNNL_PREFIX(ARG_DST))};
+        return get_reorder_desc(m);
     }
 
-    auto get_primitive_desc(const desc& d, const dnnl::primitive_attr& attr) const
+    auto get_primitive_desc(const reorder_desc& d, const dnnl::primitive_attr& attr) const
     {
-        auto& engine = get_dnnl_context().engine;
-        return dnnl::reorder::primitive_desc(engine, d.src, engine, d.dst, attr);
+        return get_reorder_primitive_desc(d, attr);
     }
 };
 
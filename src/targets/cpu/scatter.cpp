@@ -0,0 +1,115 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/config.hpp>
+#include <migraphx/register_op.hpp>
+#include <migraphx/reflect.hpp>
+#include <migraphx/context.hpp>
+#include <migraphx/cpu/context.hpp>
+#include <migraphx/op/scatter_add.hpp>
+#include <migraphx/op/scatter_max.hpp>
+#include <migraphx/op/scatter_min.hpp>
+#include <migraphx/op/scatter_mul.hpp>
+#include <migraphx/op/scatter_none.hpp>
+#include <migraphx/op/scatternd_add.hpp>
+#include <migraphx/op/scatternd_max.hpp>
+#include <migraphx/op/scatternd_min.hpp>
+#include <migraphx/op/scatternd_mul.hpp>
+#include <migraphx/op/scatternd_none.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+template <class Derived, class Op>
+struct cpu_scatter_base
+{
+    Op op;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return migraphx::reflect(self.op, f);
+    }
+    std::string name() const { return "cpu::" + op.name(); }
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        // Compensate for allocation
+        inputs.pop_back();
+        return migraphx::compute_shape(op, inputs);
+    }
+
+    argument
+    compute(context& ctx, const shape&, const std::vector<argument>& args) const
+    {
+        auto par = [&](auto n, auto grain, auto f) { ctx.bulk_for(n, grain, f); };
+        visit_all(args.back(), args[0], args[2])([&](auto output, auto data, auto updates) {
+            std::copy(data.begin(), data.end(), output.begin());
+            args[1].visit([&](auto indices) {
+                static_cast<const Derived&>(*this).scatter(output, indices, updates, par);
+            });
+        });
+        return args.back();
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
+    {
+        return shapes.size() - 1;
+    }
+};
+
+template <class Op>
+struct cpu_scatter : cpu_scatter_base<cpu_scatter<Op>, Op>, auto_register_op<cpu_scatter<Op>>
+{
+    template <class... Ts>
+    void scatter(Ts&&... xs) const
+    {
+        this->op.scatter_lines(xs...);
+    }
+};
+
+template <class Op>
+struct cpu_scatternd : cpu_scatter_base<cpu_scatternd<Op>, Op>,
+                       auto_register_op<cpu_scatternd<Op>>
+{
+    template <class... Ts>
+    void scatter(Ts&&... xs) const
+    {
+        this->op.scatter_slices(xs...);
+    }
+};
+
+template struct cpu_scatter<op::scatter_add>;
+template struct cpu_scatter<op::scatter_max>;
+template struct cpu_scatter<op::scatter_min>;
+template struct cpu_scatter<op::scatter_mul>;
+template struct cpu_scatter<op::scatter_none>;
+template struct cpu_scatternd<op::scatternd_add>;
+template struct cpu_scatternd<op::scatternd_max>;
+template struct cpu_scatternd<op::scatternd_min>;
+template struct cpu_scatternd<op::scatternd_mul>;
+template struct cpu_scatternd<op::scatternd_none>;
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
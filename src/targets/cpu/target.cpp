@@ -23,6 +23,7 @@
  */
 
 #include <migraphx/auto_contiguous.hpp>
+#include <migraphx/batch_dot.hpp>
 #include <migraphx/adjust_allocation.hpp>
 #include <migraphx/dead_code_elimination.hpp>
 #include <migraphx/eliminate_allocation.hpp>
@@ -33,6 +34,9 @@
 #include <migraphx/eliminate_identity.hpp>
 #include <migraphx/eliminate_pad.hpp>
 #include <migraphx/eliminate_convert.hpp>
+#include <migraphx/env.hpp>
+#include <migraphx/fuse_pointwise.hpp>
+#include <migraphx/fuse_reduce.hpp>
 #include <migraphx/layout_nhwc.hpp>
 #include <migraphx/memory_coloring.hpp>
 #include <migraphx/propagate_constant.hpp>
@@ -45,15 +49,22 @@
 #include <migraphx/simplify_algebra.hpp>
 #include <migraphx/simplify_reshapes.hpp>
 #include <migraphx/preallocate_param.hpp>
+#include <migraphx/cpu/apply_placement.hpp>
 #include <migraphx/cpu/fuse_ops.hpp>
+#include <migraphx/cpu/prepack_weights.hpp>
+#include <migraphx/cpu/tune_ops.hpp>
 #include <migraphx/cpu/write_literals.hpp>
 #include <migraphx/cpu/allocation_model.hpp>
 #include <migraphx/cpu/target.hpp>
 #include <migraphx/cpu/context.hpp>
+#include <migraphx/cpu/dnnl.hpp>
+#include <migraphx/cpu/inline_pointwise.hpp>
 #include <migraphx/cpu/lowering.hpp>
 #include <migraphx/pass.hpp>
 #include <migraphx/generate.hpp>
 #include <migraphx/normalize_ops.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/register_op.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -62,14 +73,103 @@ namespace cpu {
 std::string target::name() const { return "cpu"; }
 
 // cppcheck-suppress constParameterReference
-std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_options&) const
+std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_options& options) const
 {
     auto& ctx = any_cast<context>(gctx);
+    // The quantized ops are lowered to DNNL int8 primitives, so keep the int8 tensors and the
+    // int32 accumulators instead of converting them to float
+    std::set<shape::type_t> int8_types = {
+        shape::type_t::int8_type, shape::type_t::uint8_type, shape::type_t::int32_type};
     std::set<shape::type_t> unsupported_types(shape::types().begin(), shape::types().end());
     unsupported_types.erase(shape::type_t::float_type);
-    return {normalize_ops{},
-            rewrite_quantization{},
+    for(auto t : int8_types)
+        unsupported_types.erase(t);
+    // Keep fp16/bf16 when DNNL has native support for them, the primitives accumulate in fp32
+    std::set<shape::type_t> half_types;
+    for(auto t : {shape::type_t::half_type, shape::type_t::bf16_type})
+    {
+        if(dnnl_has_native_type(t))
+            half_types.insert(t);
+    }
+    for(auto t : half_types)
+        unsupported_types.erase(t);
+    // Ops lowered to DNNL primitives with fp16/bf16 support, along with the ops that only move
+    // data or pass the types through to submodules. All other ops are computed in float.
+    std::set<std::string> half_ops = {"abs",
+                                      "add",
+                                      "broadcast",
+                                      "concat",
+                                      "contiguous",
+                                      "convert",
+                                      "convolution",
+                                      "div",
+                                      "dot",
+                                      "elu",
+                                      "exp",
+                                      "flatten",
+                                      "get_tuple_elem",
+                                      "identity",
+                                      "if",
+                                      "log",
+                                      "logsoftmax",
+                                      "loop",
+                                      "max",
+                                      "min",
+                                      "mul",
+                                      "multibroadcast",
+                                      "pooling",
+                                      "reduce_max",
+                                      "reduce_mean",
+                                      "reduce_min",
+                                      "reduce_sum",
+                                      "relu",
+                                      "reshape",
+                                      "select_module",
+                                      "slice",
+                                      "softmax",
+                                      "sqrt",
+                                      "squeeze",
+                                      "tanh",
+                                      "transpose",
+                                      "unsqueeze"};
+    std::set<std::string> unsupported_half_ops;
+    for(const auto& name : get_operators())
+    {
+        if(not contains(half_ops, name))
+            unsupported_half_ops.insert(name);
+    }
+    // Ops lowered to DNNL primitives that only run in float
+    std::set<std::string> unsupported_int8_ops = {"abs",
+                                                  "add",
+                                                  "convolution",
+                                                  "convolution_backwards",
+                                                  "div",
+                                                  "dot",
+                                                  "elu",
+                                                  "erf",
+                                                  "exp",
+                                                  "log",
+                                                  "logsoftmax",
+                                                  "lrn",
+                                                  "max",
+                                                  "min",
+                                                  "mul",
+                                                  "pow",
+                                                  "reduce_max",
+                                                  "reduce_mean",
+                                                  "reduce_min",
+                                                  "reduce_sum",
+                                                  "relu",
+                                                  "softmax",
+                                                  "sqrt",
+                                                  "sub",
+                                                  "tanh"};
+    return {apply_placement{&ctx, options},
+            normalize_ops{},
+            rewrite_quantization{int8_types},
             dead_code_elimination{},
+            eliminate_data_type{int8_types, shape::type_t::float_type, unsupported_int8_ops},
+            eliminate_data_type{half_types, shape::type_t::float_type, unsupported_half_ops},
             eliminate_data_type{unsupported_types, shape::type_t::float_type},
             dead_code_elimination{},
             simplify_reshapes{},
@@ -89,12 +189,30 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
             eliminate_convert{},
             dead_code_elimination{},
             simplify_algebra{},
+            // Run independent dots with the same shapes as one batched dot. It is opt-in since
+            // one large dot is not always faster than the separate ones.
+            enable_pass(enabled(MIGRAPHX_ENABLE_BATCH_DOT{}), batch_dot{}),
+            dead_code_elimination{},
+            // Keep the activations of convolutions, pooling and pointwise ops in nhwc, which has
+            // faster DNNL kernels, so reorders are only needed where the layout changes. It is
+            // opt-in as on the gpu target.
+            enable_pass(enabled(MIGRAPHX_ENABLE_NHWC{}), layout_nhwc{}),
+            dead_code_elimination{},
             auto_contiguous{},
             simplify_reshapes{},
             eliminate_convert{},
             dead_code_elimination{},
             propagate_constant{},
             dead_code_elimination{},
+            // Fusing reductions with the pointwise ops around them bypasses the DNNL reductions
+            // and layernorm, so it is opt-in. The pointwise ops left outside of a reduction are
+            // inlined again so they still lower to DNNL primitives.
+            enable_pass(enabled(MIGRAPHX_ENABLE_CPU_REDUCE_FUSION{}), fuse_pointwise{}),
+            dead_code_elimination{},
+            enable_pass(enabled(MIGRAPHX_ENABLE_CPU_REDUCE_FUSION{}), fuse_reduce{}),
+            dead_code_elimination{},
+            enable_pass(enabled(MIGRAPHX_ENABLE_CPU_REDUCE_FUSION{}), inline_pointwise{}),
+            dead_code_elimination{},
             lowering{},
             eliminate_contiguous{"dnnl::reorder"},
             dead_code_elimination{},
@@ -104,6 +222,10 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
             dead_code_elimination{},
             fuse_ops{&ctx},
             dead_code_elimination{},
+            tune_ops{&ctx, options.exhaustive_tune},
+            // After tuning, since the layout of the weights depends on the primitive
+            enable_pass(not enabled(MIGRAPHX_DISABLE_PREPACK_WEIGHTS{}), prepack_weights{}),
+            dead_code_elimination{},
             write_literals{},
             dead_code_elimination{},
             memory_coloring{"cpu::allocate"},
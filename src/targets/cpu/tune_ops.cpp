@@ -0,0 +1,225 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/cpu/tune_ops.hpp>
+#include <migraphx/cpu/context.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/serialize.hpp>
+#include <migraphx/tuning_db.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/time.hpp>
+#include <migraphx/env.hpp>
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_CPU_TUNING_DB)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_CPU_TUNING)
+
+using tuning_space = std::vector<std::pair<std::string, std::vector<value>>>;
+
+// The cache directory of the current user, or empty when it cannot be found
+static fs::path get_user_cache_dir()
+{
+#ifdef _WIN32
+    auto local = string_value_of("LOCALAPPDATA");
+    if(not local.empty())
+        return fs::path{local} / "migraphx";
+#else
+    auto xdg = string_value_of("XDG_CACHE_HOME");
+    if(not xdg.empty())
+        return fs::path{xdg} / "migraphx";
+    auto home = string_value_of("HOME");
+    if(not home.empty())
+        return fs::path{home} / ".cache" / "migraphx";
+#endif
+    return {};
+}
+
+fs::path get_tuning_db_path()
+{
+    auto p = string_value_of(MIGRAPHX_CPU_TUNING_DB{});
+    if(not p.empty())
+        return p;
+    auto dir = get_user_cache_dir();
+    if(dir.empty())
+        return {};
+    return dir / "cpu_tuning.db";
+}
+
+// The attributes of the op that can be tuned, with the values to try for each
+static tuning_space get_tuning_space(const std::string& name, const value& v)
+{
+    tuning_space space;
+    if(v.contains("min_grain"))
+        space.emplace_back("min_grain", std::vector<value>{256, 1024, 4096, 16384});
+    if(name == "dnnl::convolution")
+        space.emplace_back(
+            "algo",
+            std::vector<value>{"convolution_auto", "convolution_direct", "convolution_winograd"});
+    return space;
+}
+
+static std::vector<value> get_solutions(const tuning_space& space)
+{
+    std::vector<value> solutions = {value::object{}};
+    for(const auto& [key, candidates] : space)
+    {
+        std::vector<value> next;
+        for(const auto& solution : solutions)
+        {
+            for(const auto& x : candidates)
+            {
+                auto s = solution;
+                s[key] = x;
+                next.push_back(s);
+            }
+        }
+        solutions = next;
+    }
+    return solutions;
+}
+
+static value apply_solution(value v, const value& solution)
+{
+    for(const auto& x : solution)
+        v[x.get_key()] = x.without_key();
+    return v;
+}
+
+using milliseconds = std::chrono::duration<double, std::milli>;
+static double time_op(context& ictx, operation op, const std::vector<shape>& inputs, int n)
+{
+    migraphx::context ctx = ictx;
+    auto output           = op.compute_shape(inputs);
+    op.finalize(ctx, output, inputs);
+    std::vector<argument> args;
+    unsigned long seed = 0;
+    std::transform(inputs.begin(), inputs.end(), std::back_inserter(args), [&](const auto& s) {
+        return generate_argument(s, seed++);
+    });
+    auto run = [&] { op.compute(ctx, output, args); };
+    run();
+    auto t = time<milliseconds>([&] {
+        for(auto i : range(n))
+        {
+            (void)i;
+            run();
+        }
+    });
+    return t / n;
+}
+
+static value benchmark(context& ctx, instruction_ref ins, const value& v, const tuning_space& space)
+{
+    auto inputs    = to_shapes(ins->inputs());
+    auto solutions = get_solutions(space);
+    std::vector<double> times;
+    times.reserve(solutions.size());
+    std::transform(solutions.begin(),
+                   solutions.end(),
+                   std::back_inserter(times),
+                   [&](const auto& solution) {
+                       try
+                       {
+                           auto op = make_op(ins->name(), apply_solution(v, solution));
+                           return time_op(ctx, op, inputs, 20);
+                       }
+                       catch(...)
+                       {
+                           // DNNL has no implementation of the algorithm for this problem
+                           return std::numeric_limits<double>::max();
+                       }
+                   });
+    auto i = std::distance(times.begin(), std::min_element(times.begin(), times.end()));
+    if(enabled(MIGRAPHX_TRACE_CPU_TUNING{}))
+    {
+        std::cout << "Benchmarking " << ins->name() << ": " << solutions.size() << " configs"
+                  << std::endl;
+        for(auto j : range(solutions.size()))
+            std::cout << "    " << solutions[j] << ": " << times[j] << "ms" << std::endl;
+        std::cout << "Fastest solution: " << solutions.at(i) << std::endl;
+    }
+    if(times.at(i) == std::numeric_limits<double>::max())
+        MIGRAPHX_THROW("No valid tuning configs for " + ins->name());
+    return solutions.at(i);
+}
+
+void tune_ops::apply(module& m) const
+{
+    auto path = get_tuning_db_path();
+    std::error_code ec;
+    tuning_db db;
+    if(not exhaustive)
+    {
+        // Without tuning the database is only read, so skip the ops when it was never written
+        if(path.empty() or not fs::exists(path, ec))
+            return;
+        db = tuning_db::read(path);
+    }
+    else if(path.empty() or
+            (path.has_parent_path() and not fs::create_directories(path.parent_path(), ec) and ec))
+    {
+        // Still tune, but keep the solutions for this compile only
+        if(enabled(MIGRAPHX_TRACE_CPU_TUNING{}))
+            std::cout << "Cannot create the tuning database " << path << std::endl;
+        db = tuning_db::open(":memory:");
+    }
+    else
+    {
+        db = tuning_db::open(path);
+    }
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->get_shape().dynamic())
+            continue;
+        auto v     = ins->get_operator().to_value();
+        auto space = get_tuning_space(ins->name(), v);
+        if(space.empty())
+            continue;
+        value problem = {{"op", v}, {"inputs", to_value(to_shapes(ins->inputs()))}};
+        auto solution = db.get(ins->name(), problem);
+        if(not solution.has_value())
+        {
+            if(not exhaustive)
+                continue;
+            assert(ctx != nullptr);
+            solution = benchmark(*ctx, ins, v, space);
+            db.insert(ins->name(), problem, *solution);
+        }
+        m.replace_instruction(
+            ins, make_op(ins->name(), apply_solution(v, *solution)), ins->inputs());
+    }
+}
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -26,6 +26,7 @@
 #include <migraphx/instruction.hpp>
 #include <migraphx/iterator_for.hpp>
 #include <migraphx/register_op.hpp>
+#include <migraphx/cpu/context.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -47,6 +48,12 @@ struct cpu_literal
 
     argument compute(const shape&, const std::vector<argument>&) const { return data; }
 
+    // Move the literal to the NUMA node the program runs on
+    void finalize(context& ctx, const shape&, const std::vector<shape>&)
+    {
+        data = ctx.to_numa_node(data);
+    }
+
     friend std::ostream& operator<<(std::ostream& os, const cpu_literal& x)
     {
         os << x.name();
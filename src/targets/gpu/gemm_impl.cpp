@@ -59,6 +59,7 @@ rocblas_datatype get_type(shape::type_t type)
     case shape::double_type: return rocblas_datatype_f64_r;
     case shape::float_type: return rocblas_datatype_f32_r;
     case shape::half_type: return rocblas_datatype_f16_r;
+    case shape::bf16_type: return rocblas_datatype_bf16_r;
     case shape::int8_type: return rocblas_datatype_i8_r;
     case shape::uint8_type: return rocblas_datatype_u8_r;
     case shape::int32_type: return rocblas_datatype_i32_r;
@@ -166,6 +167,10 @@ struct gemm_impl
             beta = 0;
         }
 
+        // rocBLAS has no bf16 compute type, so bf16 always accumulates in fp32
+        if(output_shape.type() == shape::bf16_type)
+            compute_fp32 = true;
+
         // Create lambdas that will cast alpha, beta to the output shape's type
         // and retain the values being pointed to
         output_shape.visit_type([&](auto as) {
@@ -203,7 +208,7 @@ struct gemm_impl
         compute_type = rb_compute_type{output_type};
         if(compute_fp32)
         {
-            if(arg_type == rocblas_datatype_f16_r)
+            if(arg_type == rocblas_datatype_f16_r or arg_type == rocblas_datatype_bf16_r)
                 compute_type = rocblas_datatype_f32_r;
         }
         if(arg_type == rocblas_datatype_f8_r)
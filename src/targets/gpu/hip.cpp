@@ -58,6 +58,15 @@ bool is_device_ptr(const void* ptr)
     return attr.type == hipMemoryTypeDevice;
 }
 
+int get_device_of(const void* ptr)
+{
+    hipPointerAttribute_t attr;
+    auto status = hipPointerGetAttributes(&attr, ptr);
+    if(status != hipSuccess or attr.type != hipMemoryTypeDevice)
+        return -1;
+    return attr.device;
+}
+
 std::size_t get_available_gpu_memory()
 {
     size_t free;
@@ -40,6 +40,9 @@ struct context;
 
 MIGRAPHX_GPU_EXPORT std::string hip_error(int error);
 
+// Returns the device that owns the memory, or -1 when it is not device memory
+MIGRAPHX_GPU_EXPORT int get_device_of(const void* ptr);
+
 MIGRAPHX_GPU_EXPORT argument allocate_gpu(const shape& s, bool host = false);
 
 MIGRAPHX_GPU_EXPORT argument register_on_gpu(const argument& arg);
@@ -49,6 +49,7 @@
 #include <migraphx/rewrite_pooling.hpp>
 #include <migraphx/rewrite_reduce.hpp>
 #include <migraphx/rewrite_quantization.hpp>
+#include <migraphx/rewrite_resize.hpp>
 #include <migraphx/rewrite_rnn.hpp>
 #include <migraphx/schedule.hpp>
 #include <migraphx/simplify_dyn_ops.hpp>
@@ -144,6 +145,7 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
         dead_code_elimination{},
         inline_module{},
         rewrite_pooling{},
+        rewrite_resize{},
         dead_code_elimination{},
         rewrite_gelu{options.fast_math},
         optimize_module{},
@@ -82,14 +82,12 @@ struct op_parser : auto_register<register_op_parser_action, Derived>
         auto& self = static_cast<const Derived&>(*this);
         if(self.transpose())
         {
-            result = implicit_multi_op(self.parse(opd, parser, info, parser.to_nchw(args)));
-            std::transform(result.begin(), result.end(), result.begin(), [&](auto ins) {
-                return parser.to_nhwc(ins);
-            });
+            result = parser.keep_nchw(
+                implicit_multi_op(self.parse(opd, parser, info, parser.to_nchw(args))));
         }
         else
         {
-            result = implicit_multi_op(self.parse(opd, parser, info, args));
+            result = implicit_multi_op(self.parse(opd, parser, info, parser.to_nhwc(args)));
         }
         return result;
     }
@@ -30,6 +30,7 @@
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <graph.pb.h>
 #include <unordered_map>
+#include <unordered_set>
 #include <functional>
 #include <utility>
 #include <vector>
@@ -97,15 +98,22 @@ struct tf_parser
     std::unordered_map<std::string, std::vector<std::size_t>> map_input_dims;
 
     std::unordered_map<std::string, op_func> ops;
+    // The 4D instructions of layout sensitive ops are kept in NCHW, and are only transposed to
+    // the NHWC layout of tf when an op that uses the tf layout reads them
+    mutable std::unordered_set<instruction_ref> nchw_instructions;
+    // Maps an instruction to its transpose in the other layout, so each is only added once
+    mutable std::unordered_map<instruction_ref, instruction_ref> layout_transposes;
 
     tf_parser();
     operation load(const std::string& name, const node_info& info) const;
     bool should_transpose(instruction_ref ins) const;
+    instruction_ref keep_nchw(instruction_ref ins) const;
     instruction_ref to_nhwc(instruction_ref ins) const;
     instruction_ref to_nchw(instruction_ref ins) const;
     instruction_ref to_kcxy(instruction_ref ins) const;
     std::vector<instruction_ref> to_nchw(const std::vector<instruction_ref>& args) const;
     std::vector<instruction_ref> to_nhwc(const std::vector<instruction_ref>& args) const;
+    std::vector<instruction_ref> keep_nchw(const std::vector<instruction_ref>& args) const;
     int64_t parse_axis(int64_t dim, size_t num_dims) const;
     // tf stores certain attributes such as strides, dilations, as a 4D input.
     // The first and last dims are equal to 1, and the relevant data is in dims 2 and 3.
@@ -55,18 +55,38 @@ bool tf_parser::should_transpose(instruction_ref ins) const
     return is_nhwc and ins->get_shape().lens().size() == 4;
 }
 
-instruction_ref tf_parser::to_nhwc(instruction_ref ins) const
+instruction_ref tf_parser::keep_nchw(instruction_ref ins) const
 {
     if(should_transpose(ins))
-        return mm->add_instruction(make_op("transpose", {{"permutation", {0, 2, 3, 1}}}), ins);
+        nchw_instructions.insert(ins);
     return ins;
 }
 
+static instruction_ref add_layout_transpose(module* mm,
+                                            std::unordered_map<instruction_ref, instruction_ref>& m,
+                                            instruction_ref ins,
+                                            const std::vector<int64_t>& permutation)
+{
+    if(contains(m, ins))
+        return m.at(ins);
+    auto t = mm->add_instruction(make_op("transpose", {{"permutation", permutation}}), ins);
+    m[ins] = t;
+    m[t]   = ins;
+    return t;
+}
+
+instruction_ref tf_parser::to_nhwc(instruction_ref ins) const
+{
+    if(not contains(nchw_instructions, ins))
+        return ins;
+    return add_layout_transpose(mm, layout_transposes, ins, {0, 2, 3, 1});
+}
+
 instruction_ref tf_parser::to_nchw(instruction_ref ins) const
 {
-    if(should_transpose(ins))
-        return mm->add_instruction(make_op("transpose", {{"permutation", {0, 3, 1, 2}}}), ins);
-    return ins;
+    if(not should_transpose(ins) or contains(nchw_instructions, ins))
+        return ins;
+    return keep_nchw(add_layout_transpose(mm, layout_transposes, ins, {0, 3, 1, 2}));
 }
 
 instruction_ref tf_parser::to_kcxy(instruction_ref ins) const
@@ -90,6 +110,14 @@ std::vector<instruction_ref> tf_parser::to_nhwc(const std::vector<instruction_re
     return result;
 }
 
+std::vector<instruction_ref> tf_parser::keep_nchw(const std::vector<instruction_ref>& args) const
+{
+    std::vector<instruction_ref> result(args.size());
+    std::transform(
+        args.begin(), args.end(), result.begin(), [&](auto ins) { return this->keep_nchw(ins); });
+    return result;
+}
+
 instruction_ref tf_parser::node_info::make_contiguous(instruction_ref ins) const
 {
     if(ins->get_shape().standard())
@@ -292,7 +320,7 @@ void tf_parser::parse_graph(const tensorflow::GraphDef& graph)
         }
 
         shape s            = shape{shape_type, dims};
-        instructions[name] = to_nhwc(mm->add_parameter(name, s));
+        instructions[name] = keep_nchw(mm->add_parameter(name, s));
     }
     for(auto&& p : nodes)
     {
@@ -0,0 +1,72 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/tuning_db.hpp>
+#include <migraphx/json.hpp>
+#include <migraphx/stringutils.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+static std::string quote(const std::string& s)
+{
+    return "'" + replace_string(s, "'", "''") + "'";
+}
+
+tuning_db tuning_db::open(const fs::path& p)
+{
+    tuning_db r;
+    r.db = sqlite::write(p);
+    r.db.execute("CREATE TABLE IF NOT EXISTS tuning ("
+                 "name TEXT NOT NULL, "
+                 "problem TEXT NOT NULL, "
+                 "solution TEXT NOT NULL, "
+                 "PRIMARY KEY (name, problem));");
+    return r;
+}
+
+tuning_db tuning_db::read(const fs::path& p)
+{
+    tuning_db r;
+    r.db = sqlite::read(p);
+    return r;
+}
+
+optional<value> tuning_db::get(const std::string& name, const value& problem)
+{
+    auto rows = db.execute("SELECT solution FROM tuning WHERE name = " + quote(name) +
+                           " AND problem = " + quote(to_json_string(problem)) + ";");
+    if(rows.empty())
+        return nullopt;
+    return from_json_string(rows.front().at("solution"));
+}
+
+void tuning_db::insert(const std::string& name, const value& problem, const value& solution)
+{
+    db.execute("INSERT OR REPLACE INTO tuning (name, problem, solution) VALUES (" + quote(name) +
+               ", " + quote(to_json_string(problem)) + ", " + quote(to_json_string(solution)) +
+               ");");
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
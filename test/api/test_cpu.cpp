@@ -23,6 +23,7 @@
  */
 #include <migraphx/migraphx.h>
 #include <migraphx/migraphx.hpp>
+#include <filesystem>
 #include "test.hpp"
 
 TEST_CASE(load_and_run)
@@ -223,4 +224,72 @@ TEST_CASE(set_loop_limit_iterations2)
     EXPECT(out_shapes[1].lengths() == out_lens1);
 }
 
+struct counting_allocator
+{
+    std::size_t allocations = 0;
+    std::size_t bytes       = 0;
+
+    static void* allocate(void* ctx, size_t n)
+    {
+        auto* self = static_cast<counting_allocator*>(ctx);
+        self->allocations++;
+        self->bytes += n;
+        return new char[n]; // NOLINT
+    }
+
+    static void deallocate(void* ctx, void* p, size_t n)
+    {
+        auto* self = static_cast<counting_allocator*>(ctx);
+        self->bytes -= n;
+        delete[] static_cast<char*>(p); // NOLINT
+    }
+};
+
+TEST_CASE(host_allocator)
+{
+    auto p = migraphx::parse_onnx("conv_relu_maxpool_test.onnx");
+    p.compile(migraphx::target("ref"));
+    migraphx::program_parameters pp;
+    auto param_shapes = p.get_parameter_shapes();
+    for(auto&& name : param_shapes.names())
+        pp.add(name, migraphx::argument::generate(param_shapes[name]));
+
+    counting_allocator a;
+    migraphx::set_host_allocator(
+        &a, &counting_allocator::allocate, &counting_allocator::deallocate);
+    {
+        auto outputs = p.eval(pp);
+        CHECK(a.allocations > 0);
+        CHECK(a.bytes > 0);
+    }
+    CHECK(a.bytes == 0);
+    migraphx::reset_host_allocator();
+
+    p.eval(pp);
+    auto before = migraphx::get_host_allocation_stats();
+    p.eval(pp);
+    auto after = migraphx::get_host_allocation_stats();
+    CHECK(after.allocations > before.allocations);
+    CHECK(after.reused > before.reused);
+    migraphx::release_host_buffers();
+    CHECK(migraphx::get_host_allocation_stats().bytes_cached == 0);
+}
+
+TEST_CASE(compile_onnx_cache)
+{
+    namespace fs = std::filesystem;
+    auto dir     = fs::temp_directory_path() / "migraphx-api-program-cache";
+    fs::remove_all(dir);
+    migraphx::target t("ref");
+    migraphx::compile_options options;
+    migraphx::onnx_options onnx_options;
+    auto p1 = migraphx::compile_onnx(
+        "conv_relu_maxpool_test.onnx", t, options, onnx_options, dir.string().c_str());
+    auto p2 = migraphx::compile_onnx(
+        "conv_relu_maxpool_test.onnx", t, options, onnx_options, dir.string().c_str());
+    CHECK(std::distance(fs::directory_iterator{dir}, fs::directory_iterator{}) == 1);
+    CHECK(bool{p1.get_output_shapes().front() == p2.get_output_shapes().front()});
+    fs::remove_all(dir);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -231,4 +231,41 @@ TEST_CASE(argument_share)
     EXPECT(a4.data() == a3.data());
 }
 
+TEST_CASE(argument_share_pointer)
+{
+    migraphx::shape s{migraphx::shape::int64_type, {3}};
+    migraphx::argument a1{s};
+    auto a2 = a1; // NOLINT
+    EXPECT(a1.data() == a2.data());
+    auto a3 = a1.share();
+    EXPECT(a1.data() == a3.data());
+}
+
+TEST_CASE(argument_null_pointer)
+{
+    migraphx::shape s{migraphx::shape::float_type, {0}};
+    float* p = nullptr;
+    migraphx::argument a{s, p};
+    EXPECT(not a.empty());
+    EXPECT(a.data() == nullptr);
+}
+
+TEST_CASE(argument_tuple_owner)
+{
+    migraphx::shape s{{migraphx::shape{migraphx::shape::int32_type, {2}},
+                       migraphx::shape{migraphx::shape::float_type, {3}}}};
+    std::vector<migraphx::argument> subs;
+    {
+        migraphx::argument a{s};
+        subs = a.get_sub_objects();
+    }
+    EXPECT(subs.size() == 2);
+    std::vector<int> x   = {1, 2};
+    std::vector<float> y = {3, 4, 5};
+    subs[0].fill(x.begin(), x.end());
+    subs[1].fill(y.begin(), y.end());
+    EXPECT(subs[0].at<int>(1) == 2);
+    EXPECT(subs[1].at<float>(2) == 5);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,284 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/batch_dot.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/module.hpp>
+
+#include <test.hpp>
+
+static void run_pass(migraphx::module& m)
+{
+    migraphx::run_passes(m, {migraphx::batch_dot{}, migraphx::dead_code_elimination{}});
+}
+
+static migraphx::instruction_ref grouped_dot(migraphx::module& m,
+                                             std::vector<migraphx::instruction_ref> as,
+                                             const std::vector<migraphx::instruction_ref>& bs)
+{
+    as.insert(as.end(), bs.begin(), bs.end());
+    return m.add_instruction(migraphx::make_op("grouped_dot"), as);
+}
+
+static std::vector<migraphx::instruction_ref> unstack(migraphx::module& m,
+                                                      migraphx::instruction_ref x,
+                                                      std::size_t n)
+{
+    std::vector<migraphx::instruction_ref> result;
+    for(std::size_t i = 0; i < n; i++)
+    {
+        auto slice = m.add_instruction(
+            migraphx::make_op("slice", {{"axes", {0}}, {"starts", {i}}, {"ends", {i + 1}}}), x);
+        result.push_back(m.add_instruction(migraphx::make_op("squeeze", {{"axes", {0}}}), slice));
+    }
+    return result;
+}
+
+TEST_CASE(batch_shared_input)
+{
+    migraphx::shape as{migraphx::shape::float_type, {4, 8}};
+    migraphx::shape bs{migraphx::shape::float_type, {8, 16}};
+    auto l1 = migraphx::generate_literal(bs, 1);
+    auto l2 = migraphx::generate_literal(bs, 2);
+    auto l3 = migraphx::generate_literal(bs, 3);
+    migraphx::module m1;
+    {
+        auto x  = m1.add_parameter("x", as);
+        auto w1 = m1.add_literal(l1);
+        auto w2 = m1.add_literal(l2);
+        auto w3 = m1.add_literal(l3);
+        auto d1 = m1.add_instruction(migraphx::make_op("dot"), x, w1);
+        auto d2 = m1.add_instruction(migraphx::make_op("dot"), x, w2);
+        auto d3 = m1.add_instruction(migraphx::make_op("dot"), x, w3);
+        m1.add_return({d1, d2, d3});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto x   = m2.add_parameter("x", as);
+        auto w1  = m2.add_literal(l1);
+        auto w2  = m2.add_literal(l2);
+        auto w3  = m2.add_literal(l3);
+        auto dot = grouped_dot(m2, {x, x, x}, {w1, w2, w3});
+        m2.add_return(unstack(m2, dot, 3));
+    }
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(batch_batched_dots)
+{
+    migraphx::shape as{migraphx::shape::float_type, {2, 4, 8}};
+    migraphx::shape bs{migraphx::shape::float_type, {2, 8, 16}};
+    auto l1 = migraphx::generate_literal(bs, 1);
+    auto l2 = migraphx::generate_literal(bs, 2);
+    migraphx::module m1;
+    {
+        auto x  = m1.add_parameter("x", as);
+        auto w1 = m1.add_literal(l1);
+        auto w2 = m1.add_literal(l2);
+        auto d1 = m1.add_instruction(migraphx::make_op("dot"), x, w1);
+        auto d2 = m1.add_instruction(migraphx::make_op("dot"), x, w2);
+        m1.add_return({d1, d2});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto x   = m2.add_parameter("x", as);
+        auto w1  = m2.add_literal(l1);
+        auto w2  = m2.add_literal(l2);
+        auto dot = grouped_dot(m2, {x, x}, {w1, w2});
+        m2.add_return(unstack(m2, dot, 2));
+    }
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(batch_independent_dots)
+{
+    // Separate runtime inputs are read where they are instead of being copied into a batch
+    migraphx::shape as{migraphx::shape::float_type, {4, 8}};
+    migraphx::shape bs{migraphx::shape::float_type, {8, 16}};
+    migraphx::module m1;
+    {
+        auto x1 = m1.add_parameter("x1", as);
+        auto x2 = m1.add_parameter("x2", as);
+        auto x3 = m1.add_parameter("x3", as);
+        auto w1 = m1.add_parameter("w1", bs);
+        auto w2 = m1.add_parameter("w2", bs);
+        auto w3 = m1.add_parameter("w3", bs);
+        auto d1 = m1.add_instruction(migraphx::make_op("dot"), x1, w1);
+        auto d2 = m1.add_instruction(migraphx::make_op("dot"), x2, w2);
+        auto d3 = m1.add_instruction(migraphx::make_op("dot"), x3, w3);
+        m1.add_return({d1, d2, d3});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto x1  = m2.add_parameter("x1", as);
+        auto x2  = m2.add_parameter("x2", as);
+        auto x3  = m2.add_parameter("x3", as);
+        auto w1  = m2.add_parameter("w1", bs);
+        auto w2  = m2.add_parameter("w2", bs);
+        auto w3  = m2.add_parameter("w3", bs);
+        auto dot = grouped_dot(m2, {x1, x2, x3}, {w1, w2, w3});
+        m2.add_return(unstack(m2, dot, 3));
+    }
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(batch_dependent_dots)
+{
+    // The second dot uses the first, so they can't be batched
+    migraphx::shape s{migraphx::shape::float_type, {8, 8}};
+    migraphx::module m1;
+    {
+        auto x  = m1.add_parameter("x", s);
+        auto w1 = m1.add_parameter("w1", s);
+        auto w2 = m1.add_parameter("w2", s);
+        auto d1 = m1.add_instruction(migraphx::make_op("dot"), x, w1);
+        auto d2 = m1.add_instruction(migraphx::make_op("dot"), d1, w2);
+        m1.add_return({d2});
+    }
+    migraphx::module m2 = m1;
+    run_pass(m1);
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(batch_dots_later_input)
+{
+    // The input of the last dot is computed after the first dot, so only the first two are batched
+    migraphx::shape s{migraphx::shape::float_type, {8, 8}};
+    auto l1 = migraphx::generate_literal(s, 1);
+    auto l2 = migraphx::generate_literal(s, 2);
+    auto l3 = migraphx::generate_literal(s, 3);
+    migraphx::module m1;
+    {
+        auto x  = m1.add_parameter("x", s);
+        auto w1 = m1.add_literal(l1);
+        auto w2 = m1.add_literal(l2);
+        auto w3 = m1.add_literal(l3);
+        auto d1 = m1.add_instruction(migraphx::make_op("dot"), x, w1);
+        auto d2 = m1.add_instruction(migraphx::make_op("dot"), x, w2);
+        auto r  = m1.add_instruction(migraphx::make_op("relu"), d1);
+        auto d3 = m1.add_instruction(migraphx::make_op("dot"), r, w3);
+        m1.add_return({d2, d3});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto x   = m2.add_parameter("x", s);
+        auto w1  = m2.add_literal(l1);
+        auto w2  = m2.add_literal(l2);
+        auto w3  = m2.add_literal(l3);
+        auto dot = grouped_dot(m2, {x, x}, {w1, w2});
+        auto ds  = unstack(m2, dot, 2);
+        auto r   = m2.add_instruction(migraphx::make_op("relu"), ds[0]);
+        auto d3  = m2.add_instruction(migraphx::make_op("dot"), r, w3);
+        m2.add_return({ds[1], d3});
+    }
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(batch_dots_interleaved_inputs)
+{
+    // The transpose of the second head comes after the first dot and its user, so they are moved
+    migraphx::shape s{migraphx::shape::float_type, {1, 16, 8}};
+    auto l1 = migraphx::generate_literal(s, 1);
+    auto l2 = migraphx::generate_literal(s, 2);
+    migraphx::module m1;
+    {
+        auto q   = m1.add_parameter("q", s);
+        auto k1  = m1.add_literal(l1);
+        auto k2  = m1.add_literal(l2);
+        auto kt1 = m1.add_instruction(
+            migraphx::make_op("transpose", {{"permutation", {0, 2, 1}}}), k1);
+        auto d1  = m1.add_instruction(migraphx::make_op("dot"), q, kt1);
+        auto r1  = m1.add_instruction(migraphx::make_op("relu"), d1);
+        auto kt2 = m1.add_instruction(
+            migraphx::make_op("transpose", {{"permutation", {0, 2, 1}}}), k2);
+        auto d2  = m1.add_instruction(migraphx::make_op("dot"), q, kt2);
+        m1.add_return({r1, d2});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto q   = m2.add_parameter("q", s);
+        auto k1  = m2.add_literal(l1);
+        auto k2  = m2.add_literal(l2);
+        auto kt1 = m2.add_instruction(
+            migraphx::make_op("transpose", {{"permutation", {0, 2, 1}}}), k1);
+        auto kt2 = m2.add_instruction(
+            migraphx::make_op("transpose", {{"permutation", {0, 2, 1}}}), k2);
+        auto dot = grouped_dot(m2, {q, q}, {kt1, kt2});
+        auto ds  = unstack(m2, dot, 2);
+        auto r1  = m2.add_instruction(migraphx::make_op("relu"), ds[0]);
+        m2.add_return({r1, ds[1]});
+    }
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(batch_dots_different_strides)
+{
+    // One GEMM kernel runs every group, so the layouts must match too
+    migraphx::shape s{migraphx::shape::float_type, {8, 8}};
+    migraphx::module m1;
+    {
+        auto x  = m1.add_parameter("x", s);
+        auto w1 = m1.add_parameter("w1", s);
+        auto w2 = m1.add_parameter("w2", s);
+        auto wt = m1.add_instruction(migraphx::make_op("transpose", {{"permutation", {1, 0}}}), w2);
+        auto d1 = m1.add_instruction(migraphx::make_op("dot"), x, w1);
+        auto d2 = m1.add_instruction(migraphx::make_op("dot"), x, wt);
+        m1.add_return({d1, d2});
+    }
+    migraphx::module m2 = m1;
+    run_pass(m1);
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(batch_dots_different_shapes)
+{
+    migraphx::shape as{migraphx::shape::float_type, {4, 8}};
+    migraphx::module m1;
+    {
+        auto x  = m1.add_parameter("x", as);
+        auto w1 = m1.add_parameter("w1", {migraphx::shape::float_type, {8, 16}});
+        auto w2 = m1.add_parameter("w2", {migraphx::shape::float_type, {8, 4}});
+        auto d1 = m1.add_instruction(migraphx::make_op("dot"), x, w1);
+        auto d2 = m1.add_instruction(migraphx::make_op("dot"), x, w2);
+        m1.add_return({d1, d2});
+    }
+    migraphx::module m2 = m1;
+    run_pass(m1);
+    EXPECT(m1.sort() == m2.sort());
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,129 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <cmath>
+#include <migraphx/float_equal.hpp>
+#include <migraphx/bf16.hpp>
+#include <migraphx/half.hpp>
+#include <migraphx/shape.hpp>
+#include <migraphx/literal.hpp>
+#include "test.hpp"
+
+#include <limits>
+
+TEST_CASE(test_bf16_cast_to_float)
+{
+    std::unordered_map<uint16_t, float> test_vals = {{0x0000, 0.0f},
+                                                     {0x3f80, 1.0f},
+                                                     {0xbf80, -1.0f},
+                                                     {0x4000, 2.0f},
+                                                     {0x3e80, 0.25f},
+                                                     {0x4120, 10.0f},
+                                                     {0x7f7f, 3.38953139e38f},
+                                                     {0x0080, 1.17549435e-38f}};
+    EXPECT(bool{std::all_of(test_vals.begin(), test_vals.end(), [](const auto sample) {
+        migraphx::bf16 x(sample.first, migraphx::bf16::from_bits());
+        return migraphx::float_equal(float(x), sample.second);
+    })});
+}
+
+TEST_CASE(test_bf16_cast_from_float)
+{
+    std::unordered_map<float, uint16_t> test_vals = {{1.0f, 0x3f80},
+                                                     {-1.0f, 0xbf80},
+                                                     {0.1f, 0x3dcd},
+                                                     {-0.1f, 0xbdcd},
+                                                     {3.14159f, 0x4049},
+                                                     {1e+10f, 0x5015},
+                                                     {65504.0f, 0x4780},
+                                                     {1.00390625f, 0x3f80},
+                                                     {1.01171875f, 0x3f82}};
+    EXPECT(bool{std::all_of(test_vals.begin(), test_vals.end(), [](const auto sample) {
+        return migraphx::bf16(sample.first).data == sample.second;
+    })});
+}
+
+TEST_CASE(test_bf16_zero)
+{
+    migraphx::bf16 pzero(0.0f);
+    migraphx::bf16 nzero(-0.0f);
+    EXPECT(pzero.is_zero());
+    EXPECT(nzero.is_zero());
+    EXPECT(pzero == nzero);
+}
+
+TEST_CASE(test_bf16_nan)
+{
+    migraphx::bf16 x(std::numeric_limits<float>::quiet_NaN());
+    EXPECT(x.is_nan());
+    EXPECT(std::isnan(x));
+    EXPECT(std::numeric_limits<migraphx::bf16>::quiet_NaN().is_nan());
+    EXPECT(not(x == x));
+}
+
+TEST_CASE(test_bf16_infinity)
+{
+    migraphx::bf16 x(std::numeric_limits<float>::infinity());
+    EXPECT(x.is_inf());
+    EXPECT(not std::isfinite(x));
+    EXPECT(std::numeric_limits<migraphx::bf16>::infinity().is_inf());
+    // Values past max round to infinity
+    EXPECT(migraphx::bf16(std::numeric_limits<float>::max()).is_inf());
+}
+
+TEST_CASE(test_bf16_limits)
+{
+    auto max    = std::numeric_limits<migraphx::bf16>::max();
+    auto lowest = std::numeric_limits<migraphx::bf16>::lowest();
+    EXPECT(migraphx::float_equal(float(max), -float(lowest)));
+    EXPECT(std::isfinite(max));
+    EXPECT(max > migraphx::bf16(1.0f));
+    EXPECT(lowest < migraphx::bf16(-1.0f));
+    EXPECT(migraphx::float_equal(float(std::numeric_limits<migraphx::bf16>::epsilon()),
+                                 0.0078125f));
+}
+
+TEST_CASE(test_bf16_ops)
+{
+    migraphx::bf16 x(2.0f);
+    x *= migraphx::bf16(3.0f);
+    EXPECT(migraphx::float_equal(float(x), 6.0f));
+    x += 1.0f;
+    EXPECT(migraphx::float_equal(float(x), 7.0f));
+    EXPECT(migraphx::float_equal(float(migraphx::fabs(migraphx::bf16(-7.0f))), 7.0f));
+    auto y = x + migraphx::half(1.0f);
+    EXPECT(bool{std::is_same<decltype(y), float>{}});
+}
+
+TEST_CASE(test_bf16_literal)
+{
+    migraphx::shape s{migraphx::shape::bf16_type, {3}};
+    migraphx::literal l{s, std::vector<float>{1.0f, 0.5f, -2.0f}};
+    std::vector<float> result;
+    l.visit([&](auto v) { result.assign(v.begin(), v.end()); });
+    EXPECT(result == std::vector<float>{1.0f, 0.5f, -2.0f});
+    EXPECT(s.type_size() == 2);
+    EXPECT(migraphx::shape::parse_type("bf16_type") == migraphx::shape::bf16_type);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,167 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/calibration.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/float_equal.hpp>
+#include <migraphx/shape.hpp>
+#include <migraphx/tmp_dir.hpp>
+#include <cmath>
+#include <numeric>
+#include "test.hpp"
+
+static migraphx::argument make_arg(std::vector<float> data)
+{
+    migraphx::shape s{migraphx::shape::float_type, {data.size()}};
+    return migraphx::argument{s, data.data()}.share();
+}
+
+static migraphx::calibration_observer make_observer(migraphx::calibration_method method)
+{
+    migraphx::calibration_options options;
+    options.method = method;
+    options.bins   = 256;
+    return migraphx::calibration_observer{options};
+}
+
+TEST_CASE(method_names)
+{
+    for(auto method : {migraphx::calibration_method::max_abs,
+                       migraphx::calibration_method::moving_average,
+                       migraphx::calibration_method::percentile,
+                       migraphx::calibration_method::entropy})
+    {
+        EXPECT(migraphx::to_calibration_method(migraphx::to_string(method)) == method);
+    }
+    EXPECT(test::throws([] { migraphx::to_calibration_method("kl"); }));
+}
+
+TEST_CASE(max_abs)
+{
+    auto obs = make_observer(migraphx::calibration_method::max_abs);
+    EXPECT(obs.empty());
+    obs.observe(make_arg({1.0f, -3.0f, 2.0f}));
+    obs.observe(make_arg({0.5f, 2.5f}));
+    EXPECT(not obs.empty());
+    EXPECT(migraphx::float_equal(obs.threshold(127), 3.0f));
+    // Only the percentile and entropy methods need a histogram
+    EXPECT(obs.histogram().empty());
+}
+
+TEST_CASE(moving_average)
+{
+    migraphx::calibration_options options;
+    options.method             = migraphx::calibration_method::moving_average;
+    options.averaging_constant = 0.5f;
+    migraphx::calibration_observer obs{options};
+    obs.observe(make_arg({-1.0f, 2.0f}));
+    obs.observe(make_arg({-1.0f, 6.0f}));
+    EXPECT(migraphx::float_equal(obs.threshold(127), 4.0f));
+    EXPECT(migraphx::float_equal(obs.max_abs(), 6.0f));
+}
+
+TEST_CASE(histogram_grows)
+{
+    auto obs = make_observer(migraphx::calibration_method::percentile);
+    obs.observe(make_arg({1.0f, -1.0f, 0.5f}));
+    EXPECT(migraphx::float_equal(obs.histogram_range(), 1.0f));
+    obs.observe(make_arg({3.0f}));
+    EXPECT(migraphx::float_equal(obs.histogram_range(), 4.0f));
+    const auto& hist = obs.histogram();
+    EXPECT(hist.size() == 256);
+    // Values observed before the range grew are kept
+    EXPECT(migraphx::float_equal(std::accumulate(hist.begin(), hist.end(), 0.0), 4.0));
+}
+
+TEST_CASE(histogram_zero_first_batch)
+{
+    auto obs = make_observer(migraphx::calibration_method::percentile);
+    obs.observe(make_arg({0.0f, 0.0f, 0.0f}));
+    EXPECT(migraphx::float_equal(obs.histogram_range(), 0.0f));
+    obs.observe(make_arg({2.0f}));
+    EXPECT(migraphx::float_equal(obs.histogram_range(), 2.0f));
+    obs.observe(make_arg({5.0f}));
+    EXPECT(migraphx::float_equal(obs.histogram_range(), 8.0f));
+    const auto& hist = obs.histogram();
+    // The zeros observed before the range was known are kept in the first bin
+    EXPECT(migraphx::float_equal(hist.front(), 3.0));
+    EXPECT(migraphx::float_equal(std::accumulate(hist.begin(), hist.end(), 0.0), 5.0));
+}
+
+TEST_CASE(percentile_clips_outliers)
+{
+    migraphx::calibration_options options;
+    options.method     = migraphx::calibration_method::percentile;
+    options.percentile = 99.0f;
+    options.bins       = 1024;
+    migraphx::calibration_observer obs{options};
+    std::vector<float> data(1000);
+    std::iota(data.begin(), data.end(), 0.0f);
+    std::transform(data.begin(), data.end(), data.begin(), [](float x) { return x / 1000.0f; });
+    data.back() = 100.0f;
+    obs.observe(make_arg(data));
+    EXPECT(migraphx::float_equal(obs.max_abs(), 100.0f));
+    EXPECT(obs.threshold(127) < 1.1f);
+    EXPECT(obs.threshold(127) > 0.9f);
+}
+
+TEST_CASE(entropy_clips_outliers)
+{
+    migraphx::calibration_options options;
+    options.method = migraphx::calibration_method::entropy;
+    migraphx::calibration_observer obs{options};
+    // Exponentially distributed values with a single large outlier
+    std::vector<float> data(4096);
+    std::iota(data.begin(), data.end(), 0.0f);
+    std::transform(data.begin(), data.end(), data.begin(), [&](float x) {
+        return -0.1f * std::log(1.0f - (x + 0.5f) / data.size());
+    });
+    data.back() = 16.0f;
+    obs.observe(make_arg(data));
+    auto threshold = obs.threshold(127);
+    EXPECT(threshold < 4.0f);
+    EXPECT(threshold > 0.3f);
+}
+
+TEST_CASE(zero_tensor)
+{
+    auto obs = make_observer(migraphx::calibration_method::entropy);
+    obs.observe(make_arg({0.0f, 0.0f}));
+    EXPECT(not obs.empty());
+    EXPECT(migraphx::float_equal(obs.threshold(127), 0.0f));
+}
+
+TEST_CASE(calibration_table)
+{
+    auto tmp      = migraphx::tmp_dir{};
+    auto filename = (tmp.path / "calibration.json").string();
+    std::vector<std::pair<float, float>> params = {{127.0f, 0.0f}, {42.5f, 0.0f}};
+    migraphx::save_calibration_table(filename, migraphx::shape::int8_type, params);
+    auto loaded = migraphx::load_calibration_table(filename, migraphx::shape::int8_type);
+    EXPECT(bool{loaded == params});
+    EXPECT(test::throws([&] {
+        migraphx::load_calibration_table(filename, migraphx::shape::fp8e4m3fnuz_type);
+    }));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
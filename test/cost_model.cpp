@@ -0,0 +1,128 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/cost_model.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/op/pooling.hpp>
+
+#include <test.hpp>
+
+TEST_CASE(dot)
+{
+    migraphx::module m;
+    auto a   = m.add_parameter("a", {migraphx::shape::float_type, {2, 4, 8}});
+    auto b   = m.add_parameter("b", {migraphx::shape::float_type, {2, 8, 16}});
+    auto dot = m.add_instruction(migraphx::make_op("dot"), a, b);
+    auto c   = migraphx::estimate_cost(dot);
+    EXPECT(c.flops == 2.0 * 2 * 4 * 16 * 8);
+    EXPECT(c.bytes == 4.0 * (2 * 4 * 8 + 2 * 8 * 16 + 2 * 4 * 16));
+}
+
+TEST_CASE(convolution)
+{
+    migraphx::module m;
+    auto x    = m.add_parameter("x", {migraphx::shape::float_type, {1, 8, 16, 16}});
+    auto w    = m.add_parameter("w", {migraphx::shape::float_type, {4, 2, 3, 3}});
+    auto conv = m.add_instruction(
+        migraphx::make_op("convolution", {{"padding", {1, 1}}, {"group", 4}}), x, w);
+    auto c = migraphx::estimate_cost(conv);
+    EXPECT(c.flops == 2.0 * (4 * 16 * 16) * (2 * 3 * 3));
+    EXPECT(c.arithmetic_intensity() > 0);
+}
+
+TEST_CASE(pooling)
+{
+    migraphx::module m;
+    auto x    = m.add_parameter("x", {migraphx::shape::float_type, {1, 8, 16, 16}});
+    auto pool = m.add_instruction(migraphx::make_op("pooling",
+                                                    {{"mode", migraphx::op::pooling_mode::max},
+                                                     {"lengths", {2, 2}},
+                                                     {"stride", {2, 2}}}),
+                                  x);
+    EXPECT(migraphx::estimate_cost(pool).flops == 8.0 * 8 * 8 * 4);
+}
+
+TEST_CASE(reduce)
+{
+    migraphx::module m;
+    auto x = m.add_parameter("x", {migraphx::shape::float_type, {4, 32}});
+    auto r = m.add_instruction(migraphx::make_op("reduce_sum", {{"axes", {1}}}), x);
+    auto c = migraphx::estimate_cost(r);
+    EXPECT(c.flops == 4.0 * 32);
+    EXPECT(c.bytes == 4.0 * (4 * 32 + 4));
+}
+
+TEST_CASE(pointwise_module)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    auto x   = mm->add_parameter("x", s);
+    auto y   = mm->add_parameter("y", s);
+    auto* pm = p.create_module("pointwise");
+    {
+        auto px  = pm->add_parameter("x0", migraphx::shape{migraphx::shape::float_type});
+        auto py  = pm->add_parameter("x1", migraphx::shape{migraphx::shape::float_type});
+        auto add = pm->add_instruction(migraphx::make_op("add"), px, py);
+        auto mul = pm->add_instruction(migraphx::make_op("mul"), add, py);
+        pm->add_return({mul});
+    }
+    pm->set_bypass();
+    auto pw = mm->add_instruction(migraphx::make_op("pointwise"), {x, y}, {pm});
+    auto c  = migraphx::estimate_cost(pw);
+    EXPECT(c.flops == 2.0 * 6);
+    EXPECT(c.bytes == 3.0 * s.bytes());
+
+    auto relu = mm->add_instruction(migraphx::make_op("relu"), pw);
+    EXPECT(migraphx::estimate_cost(relu).flops == 6.0);
+}
+
+TEST_CASE(data_movement)
+{
+    migraphx::module m;
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    auto x  = m.add_parameter("x", s);
+    auto t  = m.add_instruction(migraphx::make_op("transpose", {{"permutation", {1, 0}}}), x);
+    auto ct = m.add_instruction(migraphx::make_op("contiguous"), t);
+    auto tc = migraphx::estimate_cost(t);
+    EXPECT(tc.flops == 0);
+    EXPECT(tc.bytes == 0);
+    auto cc = migraphx::estimate_cost(ct);
+    EXPECT(cc.flops == 0);
+    EXPECT(cc.bytes == 2.0 * s.bytes());
+    EXPECT(migraphx::estimate_cost(x).bytes == 0);
+}
+
+TEST_CASE(roofline)
+{
+    migraphx::roofline r{1000, 100};
+    EXPECT(r.ridge_point() == 10);
+    EXPECT(r.classify({100, 100}) == "memory");
+    EXPECT(r.classify({2000, 100}) == "compute");
+    EXPECT(migraphx::roofline{}.ridge_point() > 0);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,98 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/cpu/inline_pointwise.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/fuse_pointwise.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/ranges.hpp>
+
+#include <test.hpp>
+
+static void run_pass(migraphx::program& p)
+{
+    migraphx::run_passes(p,
+                         {migraphx::fuse_pointwise{},
+                          migraphx::dead_code_elimination{},
+                          migraphx::cpu::inline_pointwise{},
+                          migraphx::dead_code_elimination{}});
+}
+
+static std::vector<std::string> get_names(const migraphx::module& m)
+{
+    std::vector<std::string> result;
+    std::transform(m.begin(), m.end(), std::back_inserter(result), [](const auto& ins) {
+        return ins.name();
+    });
+    return result;
+}
+
+TEST_CASE(inline_fused)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    migraphx::program p1;
+    {
+        auto* mm = p1.get_main_module();
+        auto x   = mm->add_parameter("x", s);
+        auto y   = mm->add_parameter("y", s);
+        auto two = mm->add_literal(migraphx::literal{migraphx::shape{s.type(), {1}}, {2.0f}});
+        auto b = mm->add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}),
+                                     two);
+        auto add = mm->add_instruction(migraphx::make_op("add"), x, y);
+        auto mul = mm->add_instruction(migraphx::make_op("mul"), add, b);
+        mm->add_return({mul});
+    }
+    migraphx::program p2 = p1;
+    run_pass(p2);
+
+    auto names = get_names(*p2.get_main_module());
+    EXPECT(not migraphx::contains(names, "pointwise"));
+    EXPECT(migraphx::contains(names, "add"));
+    EXPECT(migraphx::contains(names, "mul"));
+
+    migraphx::parameter_map params;
+    params["x"] = migraphx::generate_argument(s, 0);
+    params["y"] = migraphx::generate_argument(s, 1);
+    EXPECT(p1.eval(params).back() == p2.eval(params).back());
+}
+
+TEST_CASE(inline_single)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    migraphx::program p1;
+    {
+        auto* mm = p1.get_main_module();
+        auto x   = mm->add_parameter("x", s);
+        auto r   = mm->add_instruction(migraphx::make_op("relu"), x);
+        mm->add_return({r});
+    }
+    migraphx::program p2 = p1;
+    run_pass(p2);
+    EXPECT(p1 == p2);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
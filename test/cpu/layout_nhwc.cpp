@@ -0,0 +1,89 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/compile_options.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/permutation.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/register_target.hpp>
+#include <algorithm>
+#include <cstdlib>
+
+#include <test.hpp>
+
+// Run the passes of the cpu target up to and including eliminate_contiguous
+static void run_cpu_passes(migraphx::program& p)
+{
+    auto t      = migraphx::make_target("cpu");
+    auto ctx    = t.get_context();
+    auto passes = t.get_passes(ctx, migraphx::compile_options{});
+    auto last   = std::find_if(passes.begin(), passes.end(), [](const auto& x) {
+        return x.name() == "eliminate_contiguous";
+    });
+    EXPECT(bool{last != passes.end()});
+    passes.erase(std::next(last), passes.end());
+    migraphx::run_passes(p, passes);
+}
+
+TEST_CASE(conv_relu_conv)
+{
+    // The pass is opt-in, and the variable is read when the passes are created
+    setenv("MIGRAPHX_ENABLE_NHWC", "1", 1); // NOLINT
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::float_type, {1, 8, 16, 16}});
+    auto w1 =
+        mm->add_literal(migraphx::generate_literal({migraphx::shape::float_type, {16, 8, 3, 3}}));
+    auto w2 =
+        mm->add_literal(migraphx::generate_literal({migraphx::shape::float_type, {16, 16, 3, 3}}));
+    auto conv1 =
+        mm->add_instruction(migraphx::make_op("convolution", {{"padding", {1, 1}}}), x, w1);
+    auto relu  = mm->add_instruction(migraphx::make_op("relu"), conv1);
+    auto conv2 =
+        mm->add_instruction(migraphx::make_op("convolution", {{"padding", {1, 1}}}), relu, w2);
+    mm->add_return({conv2});
+    run_cpu_passes(p);
+
+    // The layouts are kept by eliminate_contiguous, so the convolutions still run in nhwc
+    EXPECT(std::any_of(mm->begin(), mm->end(), [](const auto& ins) {
+        return ins.name() == "dnnl::layout";
+    }));
+    std::vector<migraphx::instruction_ref> convs;
+    for(auto ins : migraphx::iterator_for(*mm))
+    {
+        if(ins->name() == "dnnl::convolution")
+            convs.push_back(ins);
+    }
+    EXPECT(convs.size() == 2);
+    for(auto conv : convs)
+    {
+        EXPECT(migraphx::find_permutation(conv->get_shape()) ==
+               std::vector<int64_t>{0, 2, 3, 1});
+    }
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
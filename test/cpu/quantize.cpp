@@ -0,0 +1,82 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/register_target.hpp>
+
+#include <test.hpp>
+
+static std::vector<std::string> get_names(const migraphx::program& p)
+{
+    const auto* mm = p.get_main_module();
+    std::vector<std::string> result;
+    std::transform(mm->begin(), mm->end(), std::back_inserter(result), [](const auto& ins) {
+        return ins.name();
+    });
+    return result;
+}
+
+TEST_CASE(quantizelinear)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    migraphx::program p;
+    auto* mm   = p.get_main_module();
+    auto x     = mm->add_parameter("x", s);
+    auto scale = mm->add_literal(migraphx::literal{s, std::vector<float>(s.elements(), 0.5f)});
+    auto zp    = mm->add_literal(migraphx::literal{
+        migraphx::shape{migraphx::shape::int8_type, s.lens()}, std::vector<int8_t>(6, 0)});
+    auto q = mm->add_instruction(migraphx::make_op("quantizelinear"), x, scale, zp);
+    mm->add_return({q});
+    p.compile(migraphx::make_target("cpu"));
+
+    auto names = get_names(p);
+    EXPECT(migraphx::contains(names, "dnnl::quantize"));
+    EXPECT(not migraphx::contains(names, "quantizelinear"));
+}
+
+TEST_CASE(quant_dot_dequantizelinear)
+{
+    migraphx::shape as{migraphx::shape::int8_type, {2, 4}};
+    migraphx::shape bs{migraphx::shape::int8_type, {4, 3}};
+    migraphx::shape ds{migraphx::shape::float_type, {2, 3}};
+    migraphx::program p;
+    auto* mm   = p.get_main_module();
+    auto a     = mm->add_parameter("a", as);
+    auto b     = mm->add_literal(migraphx::literal{bs, std::vector<int8_t>(bs.elements(), 1)});
+    auto dot   = mm->add_instruction(migraphx::make_op("quant_dot"), a, b);
+    auto scale = mm->add_literal(migraphx::literal{ds, std::vector<float>(ds.elements(), 0.25f)});
+    auto dq    = mm->add_instruction(migraphx::make_op("dequantizelinear"), dot, scale);
+    mm->add_return({dq});
+    p.compile(migraphx::make_target("cpu"));
+
+    // The dequantization is folded into the output scales of the int8 matmul
+    auto names = get_names(p);
+    EXPECT(migraphx::contains(names, "dnnl::quant_dot"));
+    EXPECT(not migraphx::contains(names, "dnnl::quantize"));
+    EXPECT(not migraphx::contains(names, "dequantizelinear"));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,156 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/host_allocator.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/register_target.hpp>
+#include <algorithm>
+
+#include <test.hpp>
+
+TEST_CASE(arena_reuse)
+{
+    migraphx::host_arena arena;
+    auto* p = arena.allocate(100);
+    arena.deallocate(p, 100);
+    EXPECT(arena.stats().bytes_cached >= 100);
+    // Same size class
+    auto* q = arena.allocate(110);
+    EXPECT(p == q);
+    EXPECT(arena.stats().reused == 1);
+    EXPECT(arena.stats().system_allocations == 1);
+    EXPECT(arena.stats().bytes_cached == 0);
+    arena.deallocate(q, 110);
+    // Different size class
+    auto* r = arena.allocate(1000);
+    EXPECT(arena.stats().system_allocations == 2);
+    arena.deallocate(r, 1000);
+    arena.release();
+    EXPECT(arena.stats().bytes_cached == 0);
+}
+
+TEST_CASE(arena_max_cached)
+{
+    migraphx::host_arena_options options;
+    options.max_cached_bytes = 64;
+    migraphx::host_arena arena{options};
+    auto* p = arena.allocate(64);
+    auto* q = arena.allocate(64);
+    arena.deallocate(p, 64);
+    arena.deallocate(q, 64);
+    EXPECT(arena.stats().bytes_cached == 64);
+}
+
+TEST_CASE(arena_huge_pages)
+{
+    migraphx::host_arena_options options;
+    options.huge_pages = true;
+    options.numa_local = true;
+    migraphx::host_arena arena{options};
+    std::size_t n = 4 * 1024 * 1024;
+    auto* p       = arena.allocate(n);
+    std::fill(p, p + n, 1);
+    arena.deallocate(p, n);
+    EXPECT(arena.allocate(n) == p);
+    arena.deallocate(p, n);
+}
+
+TEST_CASE(argument_zero_initialized)
+{
+    migraphx::shape s{migraphx::shape::float_type, {64}};
+    {
+        migraphx::argument a{s};
+        a.visit([](auto v) { std::fill(v.begin(), v.end(), 1); });
+    }
+    migraphx::argument b{s};
+    b.visit([](auto v) { EXPECT(std::all_of(v.begin(), v.end(), [](auto x) { return x == 0; })); });
+}
+
+TEST_CASE(fill_argument_reused)
+{
+    migraphx::shape s{migraphx::shape::float_type, {64}};
+    migraphx::fill_argument(s, 3);
+    auto a = migraphx::fill_argument(s, 0);
+    a.visit([](auto v) { EXPECT(std::all_of(v.begin(), v.end(), [](auto x) { return x == 0; })); });
+    auto b = migraphx::fill_argument(s, 2);
+    b.visit([](auto v) { EXPECT(std::all_of(v.begin(), v.end(), [](auto x) { return x == 2; })); });
+}
+
+TEST_CASE(custom_allocator)
+{
+    std::size_t allocated   = 0;
+    std::size_t deallocated = 0;
+    migraphx::set_host_allocator({[&](std::size_t n) {
+                                      allocated += n;
+                                      return new char[n]; // NOLINT
+                                  },
+                                  [&](char* p, std::size_t n) {
+                                      deallocated += n;
+                                      delete[] p; // NOLINT
+                                  }});
+    auto before = migraphx::get_host_allocation_stats();
+    {
+        migraphx::argument a{migraphx::shape{migraphx::shape::float_type, {4}}};
+        EXPECT(allocated == 16);
+        EXPECT(deallocated == 0);
+        auto stats = migraphx::get_host_allocation_stats();
+        EXPECT(stats.allocations == before.allocations + 1);
+        EXPECT(stats.bytes_in_use == before.bytes_in_use + 16);
+    }
+    EXPECT(deallocated == 16);
+    migraphx::reset_host_allocator();
+    // Buffers are released to the allocator that created them
+    auto buffer = migraphx::allocate_host_buffer(8);
+    EXPECT(allocated == 16);
+}
+
+TEST_CASE(invalid_allocator)
+{
+    EXPECT(test::throws([] { migraphx::set_host_allocator({}); }));
+}
+
+TEST_CASE(eval_reuses_buffers)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {1024}};
+    auto x = mm->add_parameter("x", s);
+    auto y = mm->add_instruction(migraphx::make_op("neg"), x);
+    mm->add_instruction(migraphx::make_op("exp"), y);
+    p.compile(migraphx::make_target("ref"));
+
+    migraphx::parameter_map params;
+    params["x"] = migraphx::generate_argument(s);
+    p.eval(params);
+    auto before = migraphx::get_host_allocation_stats();
+    p.eval(params);
+    auto after = migraphx::get_host_allocation_stats();
+    EXPECT(after.allocations > before.allocations);
+    EXPECT(after.system_allocations == before.system_allocations);
+    EXPECT(after.reused - before.reused == after.allocations - before.allocations);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -29,6 +29,8 @@
 #include <migraphx/instruction.hpp>
 #include <basic_ops.hpp>
 #include <migraphx/make_op.hpp>
+#include <migraphx/permutation.hpp>
+#include <migraphx/op/pooling.hpp>
 
 #include <test.hpp>
 
@@ -123,4 +125,37 @@ TEST_CASE(conv_add)
     EXPECT(m1.sort() == m2.sort());
 }
 
+TEST_CASE(conv_pool_conv)
+{
+    migraphx::module m;
+    auto x  = m.add_parameter("x", {migraphx::shape::float_type, {1, 8, 16, 16}});
+    auto w1 =
+        m.add_literal(migraphx::generate_literal({migraphx::shape::float_type, {16, 8, 3, 3}}));
+    auto w2 =
+        m.add_literal(migraphx::generate_literal({migraphx::shape::float_type, {16, 16, 3, 3}}));
+    auto conv1 = m.add_instruction(migraphx::make_op("convolution", {{"padding", {1, 1}}}), x, w1);
+    auto relu  = m.add_instruction(migraphx::make_op("relu"), conv1);
+    auto pool  = m.add_instruction(migraphx::make_op("pooling",
+                                                    {{"mode", migraphx::op::pooling_mode::max},
+                                                     {"lengths", {2, 2}},
+                                                     {"stride", {2, 2}}}),
+                                  relu);
+    m.add_instruction(migraphx::make_op("convolution", {{"padding", {1, 1}}}), pool, w2);
+    run_pass(m);
+
+    // The activations stay in nhwc between the convolutions, so the only layouts are at the
+    // input, the output and on the weights
+    auto is_layout            = [](const auto& ins) { return ins.name() == "layout"; };
+    auto is_activation_layout = [](const auto& ins) {
+        return ins.name() == "layout" and ins.inputs().front()->name() != "@literal";
+    };
+    EXPECT(std::count_if(m.begin(), m.end(), is_layout) == 4);
+    EXPECT(std::count_if(m.begin(), m.end(), is_activation_layout) == 2);
+    auto p = std::find_if(m.begin(), m.end(), [](const auto& ins) {
+        return ins.name() == "pooling";
+    });
+    EXPECT(bool{p != m.end()});
+    EXPECT(migraphx::find_permutation(p->get_shape()) == std::vector<int64_t>{0, 2, 3, 1});
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
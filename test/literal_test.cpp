@@ -183,4 +183,23 @@ TEST_CASE(literal_to_string_float_precision)
     EXPECT(x.to_string() != "127");
 }
 
+TEST_CASE(literal_lazy)
+{
+    migraphx::shape s{migraphx::shape::int64_type, {3}};
+    std::size_t loads = 0;
+    migraphx::literal l1{s, [&](char* buffer) {
+                             loads++;
+                             std::vector<int64_t> x = {1, 2, 3};
+                             std::copy(x.begin(), x.end(), reinterpret_cast<int64_t*>(buffer));
+                         }};
+    auto l2 = l1;
+    EXPECT(not l1.empty());
+    EXPECT(loads == 0);
+    EXPECT(l1 == migraphx::literal{s, {1, 2, 3}});
+    EXPECT(loads == 1);
+    EXPECT(l2.data() == l1.data());
+    EXPECT(l2.get_argument() == migraphx::literal{s, {1, 2, 3}}.get_argument());
+    EXPECT(loads == 1);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
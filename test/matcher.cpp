@@ -23,6 +23,7 @@
  */
 #include <migraphx/matcher.hpp>
 #include <migraphx/iterator_for.hpp>
+#include <migraphx/dead_code_elimination.hpp>
 #include <test.hpp>
 #include <basic_ops.hpp>
 
@@ -1191,4 +1192,238 @@ TEST_CASE(match_finder)
     match::find_matches(mm, match_find_sum{sum}, match_find_literal{sum});
 }
 
+template <class M>
+static bool has_root_names(M m, const std::unordered_set<std::string>& names)
+{
+    auto result = match::get_root_names(m);
+    return result.has_value() and *result == names;
+}
+
+TEST_CASE(match_root_names)
+{
+    EXPECT(has_root_names(match::name("sum"), {"sum"}));
+    EXPECT(has_root_names(match::name("sum", "pass"), {"sum", "pass"}));
+    EXPECT(has_root_names(match::name("sum")(match::standard_shape()), {"sum"}));
+    EXPECT(has_root_names(match::name("sum").bind("x"), {"sum"}));
+    EXPECT(has_root_names(match::any_of(match::name("sum"), match::name("pass")), {"sum", "pass"}));
+    EXPECT(has_root_names(match::all_of(match::name("sum", "pass"),
+                                        match::name("pass", "minus"),
+                                        match::standard_shape()),
+                          {"pass"}));
+    EXPECT(not match::get_root_names(match::standard_shape()).has_value());
+    EXPECT(not match::get_root_names(match::arg(0)(match::name("sum"))).has_value());
+    EXPECT(not match::get_root_names(match::any_of(match::name("sum"), match::standard_shape()))
+                   .has_value());
+    EXPECT(not match::get_root_names(match::none_of(match::name("sum"))).has_value());
+}
+
+struct match_find_any
+{
+    auto matcher() const { return match::standard_shape(); }
+
+    void apply(migraphx::module&, const match::matcher_result&) const {}
+};
+
+TEST_CASE(match_index)
+{
+    migraphx::module mm;
+    auto one = mm.add_literal(1);
+    match::matcher_index index{match_find_sum{one}, match_find_any{}, match_find_literal{one}};
+    EXPECT(index["sum"] == std::vector<bool>{true, true, false});
+    EXPECT(index["@literal"] == std::vector<bool>{false, true, true});
+    EXPECT(index["pass"] == std::vector<bool>{false, true, false});
+}
+
+struct match_find_double_pass
+{
+    std::size_t* count;
+    auto matcher() const
+    {
+        return match::name("pass")(match::arg(0)(match::name("pass").bind("x")));
+    }
+
+    void apply(migraphx::module& m, const match::matcher_result& r) const
+    {
+        (*count)++;
+        m.replace_instruction(r.result, r.instructions["x"]);
+    }
+};
+
+// Run the matchers the way passes did before the worklist: a fixed number of
+// full sweeps, each followed by dead code elimination
+template <class... Ms>
+static void find_matches_sweeps(std::size_t sweeps, migraphx::module& m, Ms&&... ms)
+{
+    for(std::size_t i = 0; i < sweeps; i++)
+    {
+        match::find_matches(m, ms...);
+        migraphx::dead_code_elimination{}.apply(m);
+    }
+}
+
+template <class F, class... Ms>
+static bool worklist_parity(F create_module, std::size_t sweeps, Ms... ms)
+{
+    migraphx::module m1 = create_module();
+    find_matches_sweeps(sweeps, m1, ms...);
+    migraphx::module m2 = create_module();
+    match::find_matches_worklist(sweeps, m2, ms...);
+    return m1.sort() == m2.sort();
+}
+
+TEST_CASE(match_worklist)
+{
+    auto create_module = [] {
+        migraphx::module mm;
+        auto one = mm.add_literal(1);
+        auto two = mm.add_literal(2);
+        auto sum = mm.add_instruction(sum_op{}, one, two);
+        auto x   = mm.add_instruction(pass_op{}, sum);
+        for(int i = 0; i < 4; i++)
+            x = mm.add_instruction(pass_op{}, x);
+        mm.add_return({x});
+        return mm;
+    };
+    migraphx::module m1 = create_module();
+    std::size_t count1  = 0;
+    find_matches_sweeps(4, m1, match_find_double_pass{&count1});
+
+    migraphx::module m2 = create_module();
+    std::size_t count2  = 0;
+    match::find_matches_worklist(4, m2, match_find_double_pass{&count2});
+    EXPECT(m1.sort() == m2.sort());
+    EXPECT(count1 == count2);
+    EXPECT(std::count_if(m2.begin(), m2.end(), [](const auto& ins) {
+               return ins.name() == "pass";
+           }) == 1);
+}
+
+// Turns the sum feeding a pass into a minus in place, keeping its inputs and address
+struct match_find_sum_to_minus
+{
+    auto matcher() const
+    {
+        return match::name("pass")(match::arg(0)(match::name("sum").bind("x")));
+    }
+
+    void apply(migraphx::module& m, const match::matcher_result& r) const
+    {
+        auto x = r.instructions["x"];
+        m.replace_instruction(x, minus_op{}, x->inputs());
+    }
+};
+
+// Replaces a minus by its first input
+struct match_find_minus
+{
+    std::size_t* count;
+    auto matcher() const { return match::name("minus"); }
+
+    void apply(migraphx::module& m, const match::matcher_result& r) const
+    {
+        (*count)++;
+        m.replace_instruction(r.result, r.result->inputs().front());
+    }
+};
+
+TEST_CASE(match_worklist_inplace_change)
+{
+    auto create_module = [] {
+        migraphx::module mm;
+        auto one = mm.add_literal(1);
+        auto two = mm.add_literal(2);
+        auto sum = mm.add_instruction(sum_op{}, one, two);
+        auto x   = mm.add_instruction(pass_op{}, sum);
+        mm.add_return({x});
+        return mm;
+    };
+    std::size_t count1 = 0;
+    std::size_t count2 = 0;
+    EXPECT(
+        worklist_parity(create_module, 8, match_find_sum_to_minus{}, match_find_minus{&count1}));
+    migraphx::module m = create_module();
+    match::find_matches_worklist(8, m, match_find_sum_to_minus{}, match_find_minus{&count2});
+    // Once in each of the two runs compared by worklist_parity
+    EXPECT(count1 == 2);
+    EXPECT(count2 == 1);
+    EXPECT(std::none_of(m.begin(), m.end(), [](const auto& ins) {
+        return migraphx::contains({"sum", "minus"}, ins.name());
+    }));
+}
+
+// Turns a sum with a single use into a minus in place
+struct match_find_sum_used_once
+{
+    auto matcher() const { return match::name("sum")(match::used_once()); }
+
+    void apply(migraphx::module& m, const match::matcher_result& r) const
+    {
+        m.replace_instruction(r.result, minus_op{}, r.result->inputs());
+    }
+};
+
+TEST_CASE(match_worklist_after_dead_code)
+{
+    // The first sweep finds nothing since the sum has two uses, but once the
+    // unused pass is removed the second sweep matches it
+    auto create_module = [] {
+        migraphx::module mm;
+        auto one = mm.add_literal(1);
+        auto two = mm.add_literal(2);
+        auto sum = mm.add_instruction(sum_op{}, one, two);
+        mm.add_instruction(pass_op{}, sum);
+        auto x = mm.add_instruction(pass_op{}, sum);
+        mm.add_return({x});
+        return mm;
+    };
+    EXPECT(worklist_parity(create_module, 8, match_find_sum_used_once{}));
+    migraphx::module m = create_module();
+    match::find_matches_worklist(8, m, match_find_sum_used_once{});
+    EXPECT(std::any_of(m.begin(), m.end(), [](const auto& ins) { return ins.name() == "minus"; }));
+}
+
+TEST_CASE(match_worklist_copied_module)
+{
+    // Copied instructions are new, even though they are equal to the originals
+    migraphx::module m1;
+    auto one = m1.add_literal(1);
+    auto two = m1.add_literal(2);
+    auto sum = m1.add_instruction(sum_op{}, one, two);
+    m1.add_return({sum});
+    match::match_worklist worklist;
+    worklist.start();
+    migraphx::module m2 = m1;
+    worklist.update(m1);
+    EXPECT(worklist.empty());
+    worklist.update(m2);
+    for(auto ins : migraphx::iterator_for(m2))
+        EXPECT(worklist.contains(ins));
+}
+
+TEST_CASE(match_worklist_changed_in_sweep)
+{
+    // A change during a sweep selects the users that come after it in the same sweep, like a
+    // full sweep would visit them
+    migraphx::module m;
+    auto one   = m.add_literal(1);
+    auto two   = m.add_literal(2);
+    auto three = m.add_literal(3);
+    auto sum   = m.add_instruction(sum_op{}, one, two);
+    auto x     = m.add_instruction(pass_op{}, sum);
+    auto y     = m.add_instruction(pass_op{}, x);
+    auto z     = m.add_instruction(pass_op{}, three);
+    m.add_return({y, z});
+    match::match_worklist worklist;
+    worklist.start();
+    worklist.update(m);
+    EXPECT(worklist.empty());
+    worklist.start();
+    EXPECT(not worklist.next(three));
+    m.replace_instruction(sum, minus_op{}, sum->inputs());
+    EXPECT(worklist.next(sum));
+    EXPECT(worklist.next(x));
+    EXPECT(worklist.next(y));
+    EXPECT(not worklist.next(z));
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
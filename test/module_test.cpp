@@ -146,6 +146,19 @@ TEST_CASE(module_name)
     EXPECT(m3.name() == "name");
 }
 
+TEST_CASE(module_id)
+{
+    migraphx::module m1("name");
+    migraphx::module m2("name");
+    EXPECT(m1.id() != m2.id());
+
+    auto m3 = m1; // NOLINT
+    EXPECT(m3.id() != m1.id());
+    auto id = m1.id();
+    migraphx::module m4 = std::move(m1);
+    EXPECT(m4.id() == id);
+}
+
 TEST_CASE(module_name_main)
 {
     migraphx::program p;
@@ -332,6 +345,26 @@ TEST_CASE(insert_instructions_module)
     EXPECT(not contains(m1.get_parameter_shapes(), "x2"));
 }
 
+TEST_CASE(insert_instructions_normalized)
+{
+    // The normalized flag is only kept when the copy has the same input shapes
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    migraphx::module m1("m1");
+    auto x1 = m1.add_parameter("x1", s);
+    auto y1 = m1.add_parameter("y1", {migraphx::shape::float_type, {4, 2, 3}});
+    m1.add_return({x1, y1});
+
+    migraphx::module m2("m2");
+    auto x2 = m2.add_parameter("x2", s);
+    auto r  = m2.add_instruction(migraphx::make_op("reduce_sum", {{"axes", {1}}}), x2);
+    r->set_normalized();
+
+    auto same = m1.insert_instructions(std::prev(m1.end()), &m2, {{x2, x1}});
+    EXPECT(same.front()->is_normalized());
+    auto other = m1.insert_instructions(std::prev(m1.end()), &m2, {{x2, y1}});
+    EXPECT(not other.front()->is_normalized());
+}
+
 TEST_CASE(add_instructions_module)
 {
     migraphx::shape s{migraphx::shape::int32_type, {1}};
@@ -0,0 +1,78 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/numa.hpp>
+#include <migraphx/host_allocator.hpp>
+#include <migraphx/ranges.hpp>
+#include <algorithm>
+#include <cstring>
+
+#include <test.hpp>
+
+TEST_CASE(node_count) { EXPECT(migraphx::get_numa_node_count() >= 1); }
+
+TEST_CASE(node_cpus)
+{
+    auto all = migraphx::get_numa_node_cpus(-1);
+    EXPECT(not all.empty());
+    EXPECT(std::is_sorted(all.begin(), all.end()));
+    auto nodes = static_cast<int>(migraphx::get_numa_node_count());
+    for(int node = 0; node < nodes; node++)
+    {
+        auto cpus = migraphx::get_numa_node_cpus(node);
+        EXPECT(std::all_of(
+            cpus.begin(), cpus.end(), [&](auto cpu) { return migraphx::contains(all, cpu); }));
+    }
+}
+
+TEST_CASE(current_node)
+{
+    auto node = migraphx::get_current_numa_node();
+    EXPECT(node >= 0);
+    EXPECT(node < static_cast<int>(migraphx::get_numa_node_count()));
+}
+
+TEST_CASE(thread_affinity)
+{
+    auto all = migraphx::get_numa_node_cpus(-1);
+    EXPECT(migraphx::set_thread_affinity({all.front()}));
+    EXPECT(migraphx::set_thread_affinity(all));
+}
+
+TEST_CASE(numa_buffer)
+{
+    std::size_t n = 4 * 1024 * 1024;
+    auto* p       = [&] {
+        auto buffer = migraphx::allocate_host_buffer(n, 0);
+        EXPECT(buffer != nullptr);
+        std::memset(buffer.get(), 1, n);
+        return buffer.get();
+    }();
+    // The buffer is returned to the pool of the node
+    auto before = migraphx::get_host_allocation_stats();
+    auto buffer = migraphx::allocate_host_buffer(n, 0);
+    EXPECT(buffer.get() == p);
+    EXPECT(migraphx::get_host_allocation_stats().reused == before.reused + 1);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
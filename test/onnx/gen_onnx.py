@@ -4082,6 +4082,27 @@ def initializer_not_an_input():
     return ([node], [x], [y], [w])
 
 
+@onnx_test()
+def initializer_truncated_raw_data_test():
+    # The raw data holds 3 of the 8 values
+    w = helper.make_tensor(name='w',
+                           data_type=TensorProto.FLOAT,
+                           dims=[2, 4],
+                           vals=np.array([1, 2, 3], dtype=np.float32).tobytes(),
+                           raw=True)
+
+    x = helper.make_tensor_value_info('x', TensorProto.FLOAT, [2, 4])
+    y = helper.make_tensor_value_info('y', TensorProto.FLOAT, [2, 4])
+
+    node = onnx.helper.make_node(
+        'Add',
+        inputs=['x', 'w'],
+        outputs=['y'],
+    )
+
+    return ([node], [x], [y], [w])
+
+
 @onnx_test()
 def instance_norm_test():
     x = helper.make_tensor_value_info('0', TensorProto.FLOAT, [1, 2, 3, 3])
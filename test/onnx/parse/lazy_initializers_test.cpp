@@ -0,0 +1,73 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <onnx_test.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/file_buffer.hpp>
+#include <migraphx/tmp_dir.hpp>
+
+static std::vector<migraphx::literal> get_literals(const migraphx::program& p)
+{
+    std::vector<migraphx::literal> result;
+    for(auto ins : migraphx::iterator_for(*p.get_main_module()))
+    {
+        if(ins->name() == "@literal")
+            result.push_back(ins->get_literal());
+    }
+    return result;
+}
+
+TEST_CASE(lazy_initializers_test)
+{
+    for(const std::string name : {"external_data_test.onnx", "initializer_not_an_input.onnx"})
+    {
+        migraphx::onnx_options options;
+        options.lazy_initializers = true;
+        auto p                    = migraphx::parse_onnx(name);
+        auto prog                 = migraphx::parse_onnx(name, options);
+        EXPECT(p == prog);
+        EXPECT(get_literals(p) == get_literals(prog));
+    }
+}
+
+TEST_CASE(lazy_initializers_truncated_raw_data_test)
+{
+    migraphx::onnx_options options;
+    options.lazy_initializers = true;
+    EXPECT(test::throws(
+        [&] { migraphx::parse_onnx("initializer_truncated_raw_data_test.onnx", options); }));
+}
+
+TEST_CASE(lazy_initializers_truncated_external_data_test)
+{
+    // The weights need 10 * 11 * 11 floats
+    migraphx::tmp_dir td{"lazy_initializers"};
+    migraphx::fs::copy_file("external_data_test.onnx", td.path / "external_data_test.onnx");
+    migraphx::write_buffer(td.path / "conv.weight", std::vector<char>(100));
+    migraphx::onnx_options options;
+    options.lazy_initializers = true;
+    EXPECT(test::throws([&] {
+        migraphx::parse_onnx((td.path / "external_data_test.onnx").string(), options);
+    }));
+}
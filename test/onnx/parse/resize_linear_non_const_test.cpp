@@ -26,7 +26,19 @@
 
 TEST_CASE(resize_linear_non_const_test)
 {
-    // runtime (non-constant) input is only supported in "nearest" mode
-    migraphx::onnx_options options;
-    EXPECT(test::throws([&] { parse_onnx("resize_linear_non_const_test.onnx", options); }));
+    // runtime (non-constant) scales are read by the resize operator
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("X", migraphx::shape{migraphx::shape::float_type, {1, 1, 2, 4}});
+    auto scales = mm->add_parameter("scales", migraphx::shape{migraphx::shape::float_type, {4}});
+    mm->add_instruction(migraphx::make_op("undefined"));
+    auto r = mm->add_instruction(
+        migraphx::make_op("resize",
+                          {{"mode", "linear"}, {"coordinate_transformation_mode", "half_pixel"}}),
+        x,
+        scales);
+    mm->add_return({r});
+
+    auto prog = migraphx::parse_onnx("resize_linear_non_const_test.onnx");
+    EXPECT(p == prog);
 }
@@ -0,0 +1,64 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <onnx_test.hpp>
+#include <migraphx/iterator_for.hpp>
+
+static std::vector<migraphx::literal> get_literals(const migraphx::program& p)
+{
+    std::vector<migraphx::literal> result;
+    for(auto ins : migraphx::iterator_for(*p.get_main_module()))
+    {
+        if(ins->name() == "@literal")
+            result.push_back(ins->get_literal());
+    }
+    return result;
+}
+
+TEST_CASE(stream_initializers_test)
+{
+    for(const std::string name : {"sum_type_test.onnx",
+                                  "external_data_test.onnx",
+                                  "ext_path/external_data_test.onnx",
+                                  "if_then_test.onnx"})
+    {
+        for(bool lazy : {false, true})
+        {
+            migraphx::onnx_options options;
+            options.stream_initializers = true;
+            options.lazy_initializers   = lazy;
+            auto p                      = migraphx::parse_onnx(name);
+            auto prog                   = migraphx::parse_onnx(name, options);
+            EXPECT(p == prog);
+            EXPECT(get_literals(p) == get_literals(prog));
+        }
+    }
+}
+
+TEST_CASE(stream_initializers_missing_file_test)
+{
+    migraphx::onnx_options options;
+    options.stream_initializers = true;
+    EXPECT(test::throws([&] { migraphx::parse_onnx("missing_file.onnx", options); }));
+}
@@ -0,0 +1,84 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <migraphx/register_target.hpp>
+#include <migraphx/file_buffer.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/tmp_dir.hpp>
+#include <onnx_test.hpp>
+#include <algorithm>
+#include <chrono>
+
+static std::size_t count_programs(const migraphx::fs::path& dir)
+{
+    auto it = migraphx::fs::directory_iterator{dir};
+    return std::distance(begin(it), end(it));
+}
+
+TEST_CASE(compile_onnx_cache_test)
+{
+    migraphx::tmp_dir td{"compile_onnx"};
+    migraphx::program_cache cache{td.path.string()};
+    auto t  = migraphx::make_target("ref");
+    auto p1 = migraphx::compile_onnx("conv_relu_maxpool_test.onnx", t, {}, {}, cache);
+    EXPECT(count_programs(td.path) == 1);
+    auto p2 = migraphx::compile_onnx("conv_relu_maxpool_test.onnx", t, {}, {}, cache);
+    EXPECT(count_programs(td.path) == 1);
+    EXPECT(p2.is_compiled());
+
+    migraphx::parameter_map pp;
+    for(auto&& [name, s] : p1.get_parameter_shapes())
+        pp[name] = migraphx::generate_argument(s);
+    EXPECT(p1.eval(pp).back() == p2.eval(pp).back());
+
+    migraphx::onnx_options options;
+    options.skip_unknown_operators = true;
+    migraphx::compile_onnx("conv_relu_maxpool_test.onnx", t, {}, options, cache);
+    EXPECT(count_programs(td.path) == 2);
+}
+
+TEST_CASE(compile_onnx_cache_external_data_test)
+{
+    // The key changes when the external data is rewritten, even though the onnx file does not
+    migraphx::tmp_dir model_dir{"compile_onnx_model"};
+    migraphx::fs::copy_file("ext_path/external_data_test.onnx",
+                            model_dir.path / "external_data_test.onnx");
+    migraphx::fs::copy_file("ext_path/conv.weight", model_dir.path / "conv.weight");
+    auto model = (model_dir.path / "external_data_test.onnx").string();
+
+    migraphx::tmp_dir td{"compile_onnx"};
+    migraphx::program_cache cache{td.path.string()};
+    auto t = migraphx::make_target("ref");
+    migraphx::compile_onnx(model, t, {}, {}, cache);
+    migraphx::compile_onnx(model, t, {}, {}, cache);
+    EXPECT(count_programs(td.path) == 1);
+
+    auto weights = migraphx::read_buffer(model_dir.path / "conv.weight");
+    std::fill(weights.begin(), weights.end(), 0);
+    migraphx::write_buffer(model_dir.path / "conv.weight", weights);
+    auto time = migraphx::fs::last_write_time(model_dir.path / "conv.weight");
+    migraphx::fs::last_write_time(model_dir.path / "conv.weight", time + std::chrono::seconds{1});
+    migraphx::compile_onnx(model, t, {}, {}, cache);
+    EXPECT(count_programs(td.path) == 2);
+}
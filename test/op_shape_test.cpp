@@ -1240,6 +1240,31 @@ TEST_CASE(get_tuple_elem_test)
     throws_shape(migraphx::make_op("get_tuple_elem", {{"index", 0}}), s2);
 }
 
+TEST_CASE(grouped_dot)
+{
+    migraphx::shape a{migraphx::shape::float_type, {4, 8}};
+    migraphx::shape b{migraphx::shape::float_type, {8, 16}};
+    expect_shape(migraphx::shape{migraphx::shape::float_type, {3, 4, 16}},
+                 migraphx::make_op("grouped_dot"),
+                 a,
+                 a,
+                 a,
+                 b,
+                 b,
+                 b);
+}
+
+TEST_CASE(grouped_dot_error)
+{
+    migraphx::shape a{migraphx::shape::float_type, {4, 8}};
+    migraphx::shape a2{migraphx::shape::float_type, {4, 6}};
+    migraphx::shape b{migraphx::shape::float_type, {8, 16}};
+    migraphx::shape bh{migraphx::shape::half_type, {8, 16}};
+    throws_shape(migraphx::make_op("grouped_dot"), a, a, b);
+    throws_shape(migraphx::make_op("grouped_dot"), a, a2, b, b);
+    throws_shape(migraphx::make_op("grouped_dot"), a, a, b, bh);
+}
+
 TEST_CASE(gru)
 {
     {
@@ -0,0 +1,166 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/pass_profiler.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/simplify_algebra.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/serialize.hpp>
+#include <migraphx/ranges.hpp>
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+#include <test.hpp>
+
+static const migraphx::pass_record* find_record(const migraphx::pass_profiler& profiler,
+                                                const std::string& name)
+{
+    const auto& records = profiler.get_records();
+    auto it             = std::find_if(
+        records.begin(), records.end(), [&](const auto& r) { return r.pass == name; });
+    if(it == records.end())
+        return nullptr;
+    return &*it;
+}
+
+TEST_CASE(disabled)
+{
+    migraphx::pass_profiler profiler;
+    EXPECT(not profiler.enabled());
+    profiler.add({"pass", "main"});
+    EXPECT(profiler.get_records().empty());
+}
+
+TEST_CASE(copies_share_records)
+{
+    auto profiler = migraphx::pass_profiler::create();
+    auto copy     = profiler;
+    copy.add({"pass", "main"});
+    EXPECT(profiler.get_records().size() == 1);
+    EXPECT(profiler.get_records().front().pass == "pass");
+}
+
+TEST_CASE(record_passes)
+{
+    migraphx::module m;
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    auto x   = m.add_parameter("x", s);
+    auto one = m.add_literal(migraphx::literal{s, {1, 1, 1, 1, 1, 1}});
+    auto two = m.add_literal(migraphx::literal{s, {2, 2, 2, 2, 2, 2}});
+    auto a   = m.add_instruction(migraphx::make_op("add"), x, one);
+    auto b   = m.add_instruction(migraphx::make_op("add"), a, two);
+    m.add_instruction(migraphx::make_op("neg"), x);
+    m.add_return({b});
+
+    auto profiler = migraphx::pass_profiler::create();
+    migraphx::run_passes(
+        m, {migraphx::dead_code_elimination{}, migraphx::simplify_algebra{}}, {}, profiler);
+
+    EXPECT(profiler.get_records().size() >= 2);
+    const auto* simplify = find_record(profiler, "simplify_algebra");
+    EXPECT(simplify != nullptr);
+    EXPECT(simplify->matcher_hits > 0);
+    EXPECT(simplify->inserted_instructions > 0);
+    EXPECT(simplify->instructions_before == 6);
+    EXPECT(simplify->instructions_after == m.size());
+
+    const auto* dce = find_record(profiler, "dead_code_elimination");
+    EXPECT(dce != nullptr);
+    EXPECT(dce->instructions_after < dce->instructions_before);
+    EXPECT(dce->matcher_hits == 0);
+    EXPECT(dce->inserted_instructions == 0);
+    EXPECT(dce->depth == 0);
+    EXPECT(dce->instructions_before == 7);
+}
+
+struct insert_pass
+{
+    std::size_t n = 1;
+    std::chrono::milliseconds delay{0};
+    std::string name() const { return "insert" + std::to_string(n); }
+    void apply(migraphx::module& m) const
+    {
+        std::this_thread::sleep_for(delay);
+        for(std::size_t i = 0; i < n; i++)
+            m.add_literal(migraphx::literal{float(i)});
+    }
+};
+
+struct nested_pass
+{
+    std::string name() const { return "nested"; }
+    void apply(migraphx::module_pass_manager& mpm) const
+    {
+        mpm.get_module().add_literal(migraphx::literal{1.0f});
+        mpm.run_pass(insert_pass{2, std::chrono::milliseconds{50}});
+    }
+};
+
+TEST_CASE(nested_passes_are_exclusive)
+{
+    migraphx::module m;
+    auto profiler = migraphx::pass_profiler::create();
+    migraphx::run_passes(m, {nested_pass{}, insert_pass{3}}, {}, profiler);
+
+    const auto* nested = find_record(profiler, "nested");
+    const auto* inner  = find_record(profiler, "insert2");
+    const auto* outer  = find_record(profiler, "insert3");
+    EXPECT(nested != nullptr);
+    EXPECT(inner != nullptr);
+    EXPECT(outer != nullptr);
+    EXPECT(nested->depth == 0);
+    EXPECT(inner->depth == 1);
+    EXPECT(outer->depth == 0);
+    EXPECT(nested->inserted_instructions == 1);
+    EXPECT(inner->inserted_instructions == 2);
+    EXPECT(outer->inserted_instructions == 3);
+    // The time spent sleeping in the nested pass is only attributed to it
+    EXPECT(inner->ms >= 50);
+    EXPECT(nested->ms < 50);
+    EXPECT(migraphx::get_pass_counters().depth == 0);
+}
+
+TEST_CASE(to_value)
+{
+    auto profiler = migraphx::pass_profiler::create();
+    profiler.add({"pass", "main", 1.5, 4, 3, 2, 1, 1});
+    auto v = profiler.to_value();
+    EXPECT(v.is_array());
+    EXPECT(v.size() == 1);
+    EXPECT(v[0].at("pass").to<std::string>() == "pass");
+    EXPECT(v[0].at("module").to<std::string>() == "main");
+    EXPECT(v[0].at("instructions_before").to<std::size_t>() == 4);
+    EXPECT(v[0].at("inserted_instructions").to<std::size_t>() == 1);
+    auto r = migraphx::from_value<migraphx::pass_record>(v[0]);
+    EXPECT(r.matcher_hits == 2);
+    EXPECT(r.depth == 1);
+
+    std::stringstream ss;
+    profiler.print(ss);
+    EXPECT(migraphx::contains(ss.str(), "Total time"));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
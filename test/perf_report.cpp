@@ -45,6 +45,9 @@ TEST_CASE(perf_report)
     EXPECT(migraphx::contains(output, "Rate:"));
     EXPECT(migraphx::contains(output, "Total time:"));
     EXPECT(migraphx::contains(output, "Total instructions time:"));
+    EXPECT(migraphx::contains(output, "Total work:"));
+    EXPECT(migraphx::contains(output, "Throughput:"));
+    EXPECT(migraphx::contains(output, "GB/s"));
     EXPECT(migraphx::contains(output, "Overhead time:"));
     EXPECT(migraphx::contains(output, "Overhead:"));
     EXPECT(not migraphx::contains(output, "fast"));
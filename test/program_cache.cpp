@@ -0,0 +1,167 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/program_cache.hpp>
+#include <migraphx/file_buffer.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/tmp_dir.hpp>
+
+#include <test.hpp>
+
+static migraphx::program create_program(std::size_t n = 4)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {n}};
+    auto x = mm->add_parameter("x", s);
+    auto y = mm->add_literal(migraphx::generate_literal(s));
+    auto z = mm->add_instruction(migraphx::make_op("add"), x, y);
+    mm->add_instruction(migraphx::make_op("relu"), z);
+    return p;
+}
+
+static std::size_t count_programs(const migraphx::fs::path& dir)
+{
+    std::size_t n = 0;
+    for(const auto& e : migraphx::fs::directory_iterator{dir})
+    {
+        if(e.path().extension() == ".mxr")
+            n++;
+    }
+    return n;
+}
+
+TEST_CASE(disabled)
+{
+    migraphx::program_cache cache;
+    EXPECT(not cache.enabled());
+    std::size_t parsed = 0;
+    auto parse         = [&] {
+        parsed++;
+        return create_program();
+    };
+    auto t = migraphx::make_target("ref");
+    cache.compile({{"model", "add_relu"}}, parse, t);
+    cache.compile({{"model", "add_relu"}}, parse, t);
+    EXPECT(parsed == 2);
+}
+
+TEST_CASE(compile_once)
+{
+    migraphx::tmp_dir td{"program_cache"};
+    migraphx::program_cache cache{td.path.string()};
+    std::size_t parsed = 0;
+    auto parse         = [&] {
+        parsed++;
+        return create_program();
+    };
+    auto t  = migraphx::make_target("ref");
+    auto p1 = cache.compile({{"model", "add_relu"}}, parse, t);
+    auto p2 = cache.compile({{"model", "add_relu"}}, parse, t);
+    EXPECT(parsed == 1);
+    EXPECT(p2.is_compiled());
+    EXPECT(count_programs(td.path) == 1);
+
+    migraphx::parameter_map params;
+    params["x"] = migraphx::generate_argument(p1.get_parameter_shape("x"));
+    EXPECT(p1.eval(params).back() == p2.eval(params).back());
+}
+
+TEST_CASE(keys)
+{
+    migraphx::program_cache cache{"unused"};
+    auto t   = migraphx::make_target("ref");
+    auto key = cache.get_key({{"model", "a"}}, t);
+    // The target name followed by the hex SHA-256 digest
+    EXPECT(key.size() == 4 + 64);
+    EXPECT(key == cache.get_key({{"model", "a"}}, t));
+    EXPECT(key != cache.get_key({{"model", "b"}}, t));
+    migraphx::compile_options options;
+    options.offload_copy = true;
+    EXPECT(key != cache.get_key({{"model", "a"}}, t, options));
+    options               = {};
+    options.profiler      = migraphx::pass_profiler::create();
+    EXPECT(key == cache.get_key({{"model", "a"}}, t, options));
+}
+
+TEST_CASE(evict)
+{
+    migraphx::tmp_dir td{"program_cache"};
+    migraphx::program_cache cache{td.path.string()};
+    auto t  = migraphx::make_target("ref");
+    auto p1 = create_program(1024);
+    p1.compile(t);
+    cache.store("a", p1);
+    auto size = migraphx::fs::file_size(td.path / "a.mxr");
+
+    // Room for two programs
+    cache.max_size = 2 * size + size / 2;
+    cache.store("b", p1);
+    cache.store("c", p1);
+    EXPECT(count_programs(td.path) == 2);
+    EXPECT(not cache.load("a").has_value());
+    EXPECT(cache.load("b").has_value());
+    EXPECT(cache.load("c").has_value());
+}
+
+TEST_CASE(corrupt)
+{
+    migraphx::tmp_dir td{"program_cache"};
+    migraphx::program_cache cache{td.path.string()};
+    std::string data = "not a program";
+    migraphx::write_buffer(td.path / "a.mxr", data.data(), data.size());
+    EXPECT(not cache.load("a").has_value());
+    EXPECT(not migraphx::fs::exists(td.path / "a.mxr"));
+}
+
+TEST_CASE(hash_file)
+{
+    migraphx::tmp_dir td{"program_cache"};
+    std::vector<char> data(3 * 1024 * 1024, 'a');
+    migraphx::write_buffer(td.path / "a.bin", data);
+    data.back() = 'b';
+    migraphx::write_buffer(td.path / "b.bin", data);
+    EXPECT(migraphx::hash_file(td.path / "a.bin") == migraphx::hash_file(td.path / "a.bin"));
+    EXPECT(migraphx::hash_file(td.path / "a.bin") != migraphx::hash_file(td.path / "b.bin"));
+}
+
+TEST_CASE(file_stamp)
+{
+    migraphx::tmp_dir td{"program_cache"};
+    std::vector<char> data(1024, 'a');
+    migraphx::write_buffer(td.path / "a.bin", data);
+    auto stamp = migraphx::file_stamp(td.path / "a.bin");
+    EXPECT(stamp == migraphx::file_stamp(td.path / "a.bin"));
+    EXPECT(stamp.at("size").to<std::size_t>() == 1024);
+
+    data.push_back('b');
+    migraphx::write_buffer(td.path / "a.bin", data);
+    EXPECT(stamp != migraphx::file_stamp(td.path / "a.bin"));
+
+    auto missing = migraphx::file_stamp(td.path / "missing.bin");
+    EXPECT(not missing.contains("size"));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -26,6 +26,10 @@
 #include <migraphx/pass_manager.hpp>
 #include <basic_ops.hpp>
 #include <migraphx/make_op.hpp>
+#include <migraphx/file_buffer.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/tmp_dir.hpp>
 
 #include <test.hpp>
 
@@ -207,4 +211,86 @@ TEST_CASE(skip_ops)
     EXPECT(m1 == m2);
 }
 
+static migraphx::module create_two_constants()
+{
+    migraphx::module m;
+    migraphx::shape s{migraphx::shape::float_type, {64}};
+    auto x   = m.add_parameter("x", s);
+    auto one = m.add_literal(migraphx::literal{s, std::vector<float>(64, 1.0f)});
+    auto two = m.add_literal(migraphx::literal{s, std::vector<float>(64, 2.0f)});
+    auto a   = m.add_instruction(migraphx::make_op("add"), one, two);
+    auto b   = m.add_instruction(migraphx::make_op("mul"), two, two);
+    auto c   = m.add_instruction(migraphx::make_op("add"), b, one);
+    auto y   = m.add_instruction(migraphx::make_op("add"), x, a);
+    m.add_instruction(migraphx::make_op("mul"), y, c);
+    return m;
+}
+
+TEST_CASE(max_memory)
+{
+    migraphx::module m1 = create_two_constants();
+    // Each wave only fits one constant
+    migraphx::propagate_constant pc;
+    pc.max_memory = 1;
+    migraphx::run_passes(m1, {pc});
+
+    migraphx::module m2 = create_two_constants();
+    run_pass(m2);
+
+    EXPECT(m1.sort() == m2.sort());
+    // The folded instructions were already removed by the pass
+    EXPECT(std::count_if(m1.begin(), m1.end(), [](const auto& ins) {
+               return ins.name() == "@literal";
+           }) == 2);
+}
+
+TEST_CASE(cache_dir)
+{
+    migraphx::tmp_dir td{"propagate_constant"};
+    migraphx::propagate_constant pc;
+    pc.cache_dir = td.path.string();
+
+    migraphx::module m1 = create_two_constants();
+    migraphx::run_passes(m1, {pc, migraphx::dead_code_elimination{}});
+    std::vector<migraphx::fs::path> files;
+    for(const auto& entry : migraphx::fs::directory_iterator(td.path))
+        files.push_back(entry.path());
+    EXPECT(files.size() == 2);
+
+    migraphx::module m2 = create_two_constants();
+    run_pass(m2);
+    EXPECT(m1.sort() == m2.sort());
+
+    // Change the cached results to check they are used instead of evaluating again
+    std::vector<float> cached(64, 7.0f);
+    for(const auto& file : files)
+        migraphx::write_buffer(file, reinterpret_cast<const char*>(cached.data()), 64 * 4);
+    migraphx::module m3 = create_two_constants();
+    migraphx::run_passes(m3, {pc, migraphx::dead_code_elimination{}});
+    for(auto ins : migraphx::iterator_for(m3))
+    {
+        if(ins->name() != "@literal")
+            continue;
+        std::vector<float> result;
+        ins->get_literal().visit([&](auto v) { result.assign(v.begin(), v.end()); });
+        EXPECT(result == cached);
+    }
+}
+
+TEST_CASE(cache_dir_unavailable)
+{
+    migraphx::tmp_dir td{"propagate_constant"};
+    // A file where the directory should be, so the directory cannot be created
+    auto file = td.path / "file";
+    migraphx::write_buffer(file, std::vector<char>{'x'});
+    migraphx::propagate_constant pc;
+    pc.cache_dir = (file / "cache").string();
+
+    migraphx::module m1 = create_two_constants();
+    migraphx::run_passes(m1, {pc, migraphx::dead_code_elimination{}});
+    migraphx::module m2 = create_two_constants();
+    run_pass(m2);
+    EXPECT(m1.sort() == m2.sort());
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,109 @@
+#####################################################################################
+# The MIT License (MIT)
+#
+# Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#####################################################################################
+import migraphx, threading
+
+
+def create_program():
+    p = migraphx.program()
+    mm = p.get_main_module()
+    s = migraphx.shape(type="float_type", lens=[2, 3])
+    x = mm.add_parameter("x", s)
+    y = mm.add_instruction(migraphx.op("add"), [x, x])
+    mm.add_return([y])
+    p.compile(migraphx.get_target("ref"))
+    return p
+
+
+def test_outputs():
+    p = create_program()
+    s = p.get_parameter_shapes()["x"]
+    x = migraphx.generate_argument(s)
+    out = migraphx.fill_argument(p.get_output_shapes()[0], 0)
+    r = p.run({"x": x}, outputs=[out])
+    assert r[0].data_ptr() == out.data_ptr()
+    assert out.tolist() == [2 * v for v in x.tolist()]
+
+
+def test_dlpack():
+    s = migraphx.shape(type="float_type", lens=[2, 3])
+    x = migraphx.generate_argument(s)
+    y = migraphx.from_dlpack(x)
+    assert y.data_ptr() == x.data_ptr()
+    assert y.get_shape() == x.get_shape()
+    assert x.__dlpack_device__() == (1, 0)
+
+    p = create_program()
+    r = p.run({"x": x.__dlpack__()})
+    assert r[0].tolist() == [2 * v for v in x.tolist()]
+
+
+def test_threads():
+    programs = [create_program() for i in range(4)]
+    s = programs[0].get_parameter_shapes()["x"]
+    results = [None] * len(programs)
+
+    def run(i):
+        x = migraphx.generate_argument(s, i)
+        r = programs[i].run({"x": x})[0]
+        results[i] = r.tolist() == [2 * v for v in x.tolist()]
+
+    threads = [
+        threading.Thread(target=run, args=(i, )) for i in range(len(programs))
+    ]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    assert all(results)
+
+
+def test_threads_same_program():
+    p = create_program()
+    s = p.get_parameter_shapes()["x"]
+    results = [None] * 8
+
+    def run(i):
+        x = migraphx.generate_argument(s, i)
+        for _ in range(16):
+            r = p.run({"x": x})[0]
+            if r.tolist() != [2 * v for v in x.tolist()]:
+                results[i] = False
+                return
+        results[i] = True
+
+    threads = [
+        threading.Thread(target=run, args=(i, )) for i in range(len(results))
+    ]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    assert all(results)
+
+
+if __name__ == "__main__":
+    test_outputs()
+    test_dlpack()
+    test_threads()
+    test_threads_same_program()
@@ -44,6 +44,7 @@
 #include <migraphx/argument.hpp>
 #include <migraphx/program.hpp>
 #include <migraphx/shape.hpp>
+#include <migraphx/tmp_dir.hpp>
 #include "test.hpp"
 #include <migraphx/half.hpp>
 
@@ -130,6 +131,82 @@ TEST_CASE(param_add)
     }
 }
 
+TEST_CASE(param_add_bf16)
+{
+    auto create_program_float = [] {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+        auto p1  = mm->add_parameter("x", s);
+        auto p2  = mm->add_parameter("y", s);
+        auto sum = mm->add_instruction(migraphx::make_op("add"), p1, p2);
+        mm->add_return({sum});
+        return p;
+    };
+
+    auto create_program_bf16 = [] {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+        auto p1  = mm->add_parameter("x", s);
+        auto p2  = mm->add_parameter("y", s);
+        auto bp1 = mm->add_instruction(
+            migraphx::make_op("convert", {{"target_type", migraphx::shape::bf16_type}}), p1);
+        auto bp2 = mm->add_instruction(
+            migraphx::make_op("convert", {{"target_type", migraphx::shape::bf16_type}}), p2);
+        auto bs = mm->add_instruction(migraphx::make_op("add"), bp1, bp2);
+        auto fs = mm->add_instruction(
+            migraphx::make_op("convert", {{"target_type", migraphx::shape::float_type}}), bs);
+        mm->add_return({fs});
+        return p;
+    };
+
+    auto p1 = create_program_float();
+    auto p2 = create_program_bf16();
+    migraphx::quantize_bf16(p1);
+    EXPECT(p1 == p2);
+
+    p1.compile(migraphx::make_target("ref"));
+    std::vector<float> x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+    migraphx::parameter_map m;
+    m["x"] = migraphx::argument{{migraphx::shape::float_type, {2, 3}}, x.data()};
+    m["y"] = m["x"];
+    std::vector<float> result;
+    p1.eval(m).back().visit([&](auto v) { result.assign(v.begin(), v.end()); });
+    EXPECT(result == std::vector<float>{2.0f, 4.0f, 6.0f, 8.0f, 10.0f, 12.0f});
+}
+
+TEST_CASE(dot_bf16_accuracy)
+{
+    // Compare a bf16 program against the fp32 program it was quantized from
+    auto create_program = [] {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        auto x   = mm->add_parameter("x", {migraphx::shape::float_type, {8, 64}});
+        auto w   = mm->add_literal(
+            migraphx::generate_literal({migraphx::shape::float_type, {64, 32}}, 1));
+        auto dot  = mm->add_instruction(migraphx::make_op("dot"), x, w);
+        auto relu = mm->add_instruction(migraphx::make_op("relu"), dot);
+        mm->add_return({relu});
+        return p;
+    };
+    migraphx::parameter_map m;
+    m["x"] = migraphx::generate_argument({migraphx::shape::float_type, {8, 64}}, 2);
+    auto run = [&](migraphx::program p) {
+        p.compile(migraphx::make_target("ref"));
+        std::vector<float> result;
+        p.eval(m).back().visit([&](auto v) { result.assign(v.begin(), v.end()); });
+        return result;
+    };
+
+    auto p_bf16 = create_program();
+    migraphx::quantize_bf16(p_bf16);
+    auto fp32_result = run(create_program());
+    auto bf16_result = run(p_bf16);
+    auto error       = migraphx::verify::rms_range(bf16_result, fp32_result);
+    EXPECT(error < 1e-2);
+}
+
 TEST_CASE(param_add_sub)
 {
     auto create_program_float = [] {
@@ -1314,6 +1391,90 @@ TEST_CASE(int8_subgraph)
     EXPECT(p1 == p2);
 }
 
+TEST_CASE(int8_quantization_dot_per_channel)
+{
+    auto create_program = [] {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape sa{migraphx::shape::float_type, {2, 16}};
+        migraphx::shape sb{migraphx::shape::float_type, {16, 8}};
+        auto pa = mm->add_parameter("a", sa);
+        // Give each output column a different range
+        std::vector<float> b(sb.elements());
+        for(std::size_t i = 0; i < b.size(); i++)
+            b[i] = static_cast<float>(i % 8 + 1) * (static_cast<float>(i % 5) - 2.0f);
+        auto pb = mm->add_literal(migraphx::literal{sb, b});
+        auto r  = mm->add_instruction(migraphx::make_op("dot"), pa, pb);
+        mm->add_return({r});
+        return p;
+    };
+
+    migraphx::parameter_map m;
+    m["a"] = migraphx::generate_argument({migraphx::shape::float_type, {2, 16}},
+                                         get_hash(std::string("a")));
+    migraphx::target ref_t = migraphx::make_target("ref");
+    auto run_prog          = [&](migraphx::program p) {
+        p.compile(ref_t);
+        std::vector<float> res;
+        p.eval(m).back().visit([&](auto v) { res.assign(v.begin(), v.end()); });
+        return res;
+    };
+
+    auto p = create_program();
+    migraphx::calibration_options options;
+    options.per_channel = true;
+    migraphx::quantize_int8(p, ref_t, {m}, {"dot", "convolution"}, options);
+    auto* mm = p.get_main_module();
+    EXPECT(std::any_of(mm->begin(), mm->end(), [](const auto& ins) {
+        return ins.name() == "quant_dot";
+    }));
+    // The weight scales are per column of b
+    EXPECT(std::any_of(mm->begin(), mm->end(), [](const auto& ins) {
+        return ins.name() == "@literal" and ins.get_shape().lens() == std::vector<std::size_t>{8};
+    }));
+
+    EXPECT(migraphx::verify::verify_range_with_tolerance(
+        run_prog(p),
+        migraphx::verify::expected{run_prog(create_program())},
+        migraphx::verify::tolerance{0.01}));
+}
+
+TEST_CASE(int8_quantization_calibration_table)
+{
+    auto create_program = [] {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape sa{migraphx::shape::float_type, {2, 16}};
+        migraphx::shape sb{migraphx::shape::float_type, {16, 8}};
+        auto pa = mm->add_parameter("a", sa);
+        auto pb = mm->add_parameter("b", sb);
+        auto r  = mm->add_instruction(migraphx::make_op("dot"), pa, pb);
+        mm->add_return({r});
+        return p;
+    };
+
+    migraphx::parameter_map m;
+    m["a"] = migraphx::generate_argument({migraphx::shape::float_type, {2, 16}},
+                                         get_hash(std::string("a")));
+    m["b"] = migraphx::generate_argument({migraphx::shape::float_type, {16, 8}},
+                                         get_hash(std::string("b")));
+    migraphx::target ref_t = migraphx::make_target("ref");
+    auto tmp               = migraphx::tmp_dir{};
+
+    migraphx::calibration_options save_options;
+    save_options.method     = migraphx::calibration_method::entropy;
+    save_options.save_table = (tmp.path / "table.json").string();
+    auto p1                 = create_program();
+    migraphx::quantize_int8(p1, ref_t, {m}, {"dot", "convolution"}, save_options);
+
+    // Loading the table does not need any calibration data
+    migraphx::calibration_options load_options;
+    load_options.load_table = save_options.save_table;
+    auto p2                 = create_program();
+    migraphx::quantize_int8(p2, ref_t, {}, {"dot", "convolution"}, load_options);
+    EXPECT(p1 == p2);
+}
+
 TEST_CASE(test_op_capture)
 {
     migraphx::program p;
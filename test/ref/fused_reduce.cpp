@@ -0,0 +1,127 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/fuse_pointwise.hpp>
+#include <migraphx/fuse_reduce.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/normalize_ops.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+
+#include <test.hpp>
+
+static std::vector<float> eval_fused(migraphx::program p, const migraphx::parameter_map& m)
+{
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval(m).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    return results_vector;
+}
+
+// Compare the fused program against the same program without the fusions
+static void verify_fused(const migraphx::program& p)
+{
+    auto fused = p;
+    migraphx::run_passes(fused,
+                         {migraphx::normalize_ops{},
+                          migraphx::fuse_pointwise{},
+                          migraphx::dead_code_elimination{},
+                          migraphx::fuse_reduce{},
+                          migraphx::dead_code_elimination{}});
+    const auto* mm = fused.get_main_module();
+    EXPECT(std::any_of(
+        mm->begin(), mm->end(), [](const auto& ins) { return ins.name() == "fused_reduce"; }));
+
+    migraphx::parameter_map m;
+    for(auto&& [name, s] : p.get_parameter_shapes())
+        m[name] = migraphx::generate_argument(s, m.size());
+    auto gold   = eval_fused(p, m);
+    auto result = eval_fused(fused, m);
+    EXPECT(migraphx::verify::verify_rms_range(result, gold));
+}
+
+TEST_CASE(fused_reduce_softmax_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {4, 3, 100}};
+    auto x    = mm->add_parameter("x", s);
+    auto rmax = mm->add_instruction(migraphx::make_op("reduce_max", {{"axes", {2}}}), x);
+    auto mb   = mm->add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}),
+                                  rmax);
+    auto sub  = mm->add_instruction(migraphx::make_op("sub"), x, mb);
+    auto exp  = mm->add_instruction(migraphx::make_op("exp"), sub);
+    auto rsum = mm->add_instruction(migraphx::make_op("reduce_sum", {{"axes", {2}}}), exp);
+    auto sb   = mm->add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}),
+                                  rsum);
+    mm->add_instruction(migraphx::make_op("div"), exp, sb);
+    verify_fused(p);
+}
+
+TEST_CASE(fused_reduce_layernorm_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {2, 5, 64}};
+    migraphx::shape ws{migraphx::shape::float_type, {64}};
+    auto x     = mm->add_parameter("x", s);
+    auto y     = mm->add_parameter("y", s);
+    auto w     = mm->add_parameter("w", ws);
+    auto add   = mm->add_instruction(migraphx::make_op("add"), x, y);
+    auto mean  = mm->add_instruction(migraphx::make_op("reduce_mean", {{"axes", {2}}}), add);
+    auto meanb = mm->add_instruction(
+        migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}), mean);
+    auto sub   = mm->add_instruction(migraphx::make_op("sub"), add, meanb);
+    auto sq    = mm->add_instruction(migraphx::make_op("mul"), sub, sub);
+    auto var   = mm->add_instruction(migraphx::make_op("reduce_mean", {{"axes", {2}}}), sq);
+    auto varb  = mm->add_instruction(
+        migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}), var);
+    auto rsqrt = mm->add_instruction(migraphx::make_op("rsqrt"), varb);
+    auto norm  = mm->add_instruction(migraphx::make_op("mul"), sub, rsqrt);
+    auto wb =
+        mm->add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}), w);
+    mm->add_instruction(migraphx::make_op("mul"), norm, wb);
+    verify_fused(p);
+}
+
+TEST_CASE(fused_reduce_transposed_test)
+{
+    // Reduce over a non-contiguous axis of a transposed input
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {8, 6, 5}};
+    auto x  = mm->add_parameter("x", s);
+    auto tx = mm->add_instruction(migraphx::make_op("transpose", {{"permutation", {0, 2, 1}}}), x);
+    auto neg  = mm->add_instruction(migraphx::make_op("neg"), tx);
+    auto rsum = mm->add_instruction(migraphx::make_op("reduce_sum", {{"axes", {1}}}), neg);
+    auto exp  = mm->add_instruction(migraphx::make_op("exp"), rsum);
+    mm->add_return({exp});
+    verify_fused(p);
+}
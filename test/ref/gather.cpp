@@ -284,3 +284,52 @@ TEST_CASE(gather_dyn_test1)
     migraphx::shape sfinal{migraphx::shape::int32_type, {1, 2, 4}};
     EXPECT(result.get_shape() == sfinal);
 }
+
+TEST_CASE(gather_rows_test)
+{
+    // embedding lookup: whole rows of a standard table, with repeated and negative indices
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+
+    migraphx::shape s{migraphx::shape::float_type, {16, 8}};
+    std::vector<float> data(s.elements());
+    std::iota(data.begin(), data.end(), 0.5);
+    auto a0 = mm->add_literal(migraphx::literal{s, data});
+    migraphx::shape s_indices{migraphx::shape::int64_type, {2, 3}};
+    std::vector<int64_t> indices{3, 15, -1, 0, 3, -16};
+    auto a1 = mm->add_literal(migraphx::literal{s_indices, indices});
+    mm->add_instruction(migraphx::make_op("gather", {{"axis", 0}}), a0, a1);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+
+    std::vector<float> golden;
+    for(auto i : indices)
+    {
+        auto row = (i < 0) ? i + 16 : i;
+        golden.insert(golden.end(), data.begin() + row * 8, data.begin() + (row + 1) * 8);
+    }
+    std::vector<float> res_data;
+    result.visit([&](auto output) { res_data.assign(output.begin(), output.end()); });
+    EXPECT(res_data == golden);
+}
+
+TEST_CASE(gather_rows_inner_axis_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+
+    migraphx::shape s{migraphx::shape::int32_type, {2, 4, 3}};
+    std::vector<int> data(s.elements());
+    std::iota(data.begin(), data.end(), 0);
+    auto a0 = mm->add_literal(migraphx::literal{s, data});
+    migraphx::shape s_indices{migraphx::shape::int32_type, {2}};
+    auto a1 = mm->add_literal(migraphx::literal{s_indices, {2, 0}});
+    mm->add_instruction(migraphx::make_op("gather", {{"axis", 1}}), a0, a1);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+
+    std::vector<int> golden = {6, 7, 8, 0, 1, 2, 18, 19, 20, 12, 13, 14};
+    std::vector<int> res_data;
+    result.visit([&](auto output) { res_data.assign(output.begin(), output.end()); });
+    EXPECT(res_data == golden);
+}
@@ -0,0 +1,87 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/instruction.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/verify.hpp>
+
+#include <test.hpp>
+
+static std::vector<float> run(migraphx::program p)
+{
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    return results_vector;
+}
+
+TEST_CASE(grouped_dot_test)
+{
+    migraphx::shape as{migraphx::shape::float_type, {3, 4}};
+    migraphx::shape bs{migraphx::shape::float_type, {5, 4}};
+    std::vector<migraphx::literal> a = {migraphx::generate_literal(as, 1),
+                                        migraphx::generate_literal(as, 2)};
+    std::vector<migraphx::literal> b = {migraphx::generate_literal(bs, 3),
+                                        migraphx::generate_literal(bs, 4)};
+
+    // The second B is transposed so the groups read strided inputs in place
+    auto add_inputs = [&](migraphx::module& m) {
+        std::vector<migraphx::instruction_ref> inputs;
+        std::transform(a.begin(), a.end(), std::back_inserter(inputs), [&](const auto& l) {
+            return m.add_literal(l);
+        });
+        std::transform(b.begin(), b.end(), std::back_inserter(inputs), [&](const auto& l) {
+            return m.add_instruction(migraphx::make_op("transpose", {{"permutation", {1, 0}}}),
+                                     m.add_literal(l));
+        });
+        return inputs;
+    };
+
+    migraphx::program p1;
+    {
+        auto* mm    = p1.get_main_module();
+        auto inputs = add_inputs(*mm);
+        mm->add_instruction(migraphx::make_op("grouped_dot"), inputs);
+    }
+
+    migraphx::program p2;
+    {
+        auto* mm    = p2.get_main_module();
+        auto inputs = add_inputs(*mm);
+        auto d1     = mm->add_instruction(migraphx::make_op("dot"), inputs[0], inputs[2]);
+        auto d2     = mm->add_instruction(migraphx::make_op("dot"), inputs[1], inputs[3]);
+        auto u1     = mm->add_instruction(migraphx::make_op("unsqueeze", {{"axes", {0}}}), d1);
+        auto u2     = mm->add_instruction(migraphx::make_op("unsqueeze", {{"axes", {0}}}), d2);
+        mm->add_instruction(migraphx::make_op("concat", {{"axis", 0}}), u1, u2);
+    }
+
+    auto results_vector = run(p1);
+    auto gold           = run(p2);
+    EXPECT(results_vector.size() == 2 * 3 * 5);
+    EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
+}
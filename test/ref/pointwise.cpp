@@ -27,8 +27,11 @@
 #include <migraphx/program.hpp>
 #include <migraphx/register_target.hpp>
 #include <migraphx/verify.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/pointwise_executor.hpp>
 
 #include <test.hpp>
+#include <pointwise.hpp>
 
 TEST_CASE(pointwise_test)
 {
@@ -49,3 +52,181 @@ TEST_CASE(pointwise_test)
     std::vector<float> gold = {0, 2, 4};
     EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
 }
+
+TEST_CASE(pointwise_executor_cache_test)
+{
+    migraphx::module pm;
+    auto x1  = pm.add_parameter("x1", {migraphx::shape::float_type});
+    auto x2  = pm.add_parameter("x2", {migraphx::shape::float_type});
+    auto add = pm.add_instruction(migraphx::make_op("add"), x1, x2);
+    pm.add_return({add});
+
+    migraphx::shape s{migraphx::shape::float_type, {3}};
+    std::vector<float> a = {-1, 0, 1};
+    std::vector<float> b = {1, 2, 3};
+    std::vector<migraphx::argument> args = {migraphx::argument{s, a.data()},
+                                            migraphx::argument{s, b.data()}};
+    auto execute = [&](const migraphx::pointwise_executor& e) {
+        std::vector<float> results_vector;
+        e.execute(s, args).visit(
+            [&](auto output) { results_vector.assign(output.begin(), output.end()); });
+        return results_vector;
+    };
+
+    migraphx::pointwise_executor_cache cache;
+    auto e1 = cache.get(pm);
+    EXPECT(cache.get(pm) == e1);
+    EXPECT(execute(*e1) == std::vector<float>{0, 2, 4});
+
+    // A copy does not share the translation
+    auto copy = cache;
+    EXPECT(copy.get(pm) != e1);
+
+    // The module is translated again after it is edited
+    pm.replace_instruction(add, migraphx::make_op("mul"), x1, x2);
+    auto e2 = cache.get(pm);
+    EXPECT(e2 != e1);
+    EXPECT(execute(*e2) == std::vector<float>{-1, 0, 3});
+}
+
+TEST_CASE(pointwise_literal_after_step_test)
+{
+    // The literal comes after the add frees the register of x1, but every parameter and literal
+    // is loaded before the steps run, so the add must still read x1
+    migraphx::module pm;
+    auto x1  = pm.add_parameter("x1", {migraphx::shape::float_type});
+    auto x2  = pm.add_parameter("x2", {migraphx::shape::float_type});
+    auto add = pm.add_instruction(migraphx::make_op("add"), x1, x2);
+    auto ret = pm.add_return({add});
+    auto l   = pm.insert_literal(ret, migraphx::literal{{migraphx::shape::float_type}, {100}});
+    auto mul = pm.insert_instruction(ret, migraphx::make_op("mul"), add, l);
+    pm.replace_return({mul});
+
+    migraphx::shape s{migraphx::shape::float_type, {3}};
+    std::vector<float> a = {1, 2, 3};
+    std::vector<float> b = {10, 20, 30};
+    std::vector<float> results_vector;
+    migraphx::pointwise_executor::translate(pm)
+        .execute(s, {migraphx::argument{s, a.data()}, migraphx::argument{s, b.data()}})
+        .visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    EXPECT(results_vector == std::vector<float>{1100, 2200, 3300});
+}
+
+static std::vector<float> eval_pointwise(migraphx::program p, const migraphx::parameter_map& m)
+{
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval(m).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    return results_vector;
+}
+
+TEST_CASE(pointwise_blocks_test)
+{
+    // Larger than a single block, with a literal and several intermediate values
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {3, 1000}};
+    auto x = mm->add_parameter("x", s);
+    auto y = mm->add_parameter("y", s);
+    add_pointwise(p, "main:pointwise0", {x, y}, [](auto* pm, const auto& inputs) {
+        auto two  = pm->add_literal(2.0f);
+        auto add  = pm->add_instruction(migraphx::make_op("add"), inputs[0], inputs[1]);
+        auto mul  = pm->add_instruction(migraphx::make_op("mul"), add, two);
+        auto sub  = pm->add_instruction(migraphx::make_op("sub"), mul, inputs[0]);
+        auto relu = pm->add_instruction(migraphx::make_op("relu"), sub);
+        return pm->add_instruction(migraphx::make_op("mul"), relu, add);
+    });
+    auto xa = migraphx::generate_argument(s, 0);
+    auto ya = migraphx::generate_argument(s, 1);
+    auto results_vector = eval_pointwise(p, {{"x", xa}, {"y", ya}});
+
+    auto xv = xa.get<float>();
+    auto yv = ya.get<float>();
+    std::vector<float> gold(s.elements());
+    for(std::size_t i = 0; i < gold.size(); i++)
+    {
+        auto add = xv[i] + yv[i];
+        gold[i]  = std::max(add * 2.0f - xv[i], 0.0f) * add;
+    }
+    EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
+}
+
+TEST_CASE(pointwise_layout_test)
+{
+    // Transposed and broadcasted inputs are gathered in the order of the output
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {40, 50}};
+    migraphx::shape bs{migraphx::shape::float_type, {50}};
+    auto x  = mm->add_parameter("x", s);
+    auto y  = mm->add_parameter("y", s);
+    auto b  = mm->add_parameter("b", bs);
+    auto xt = mm->add_instruction(migraphx::make_op("transpose", {{"permutation", {1, 0}}}), x);
+    auto bb = mm->add_instruction(
+        migraphx::make_op("broadcast", {{"axis", 0}, {"out_lens", {50, 40}}}), b);
+    auto yt = mm->add_instruction(migraphx::make_op("transpose", {{"permutation", {1, 0}}}), y);
+    auto yc = mm->add_instruction(migraphx::make_op("contiguous"), yt);
+    add_pointwise(p, "main:pointwise0", {xt, bb, yc}, [](auto* pm, const auto& inputs) {
+        auto add = pm->add_instruction(migraphx::make_op("add"), inputs[0], inputs[1]);
+        return pm->add_instruction(migraphx::make_op("mul"), add, inputs[2]);
+    });
+    auto xa = migraphx::generate_argument(s, 0);
+    auto ya = migraphx::generate_argument(s, 1);
+    auto ba = migraphx::generate_argument(bs, 2);
+    auto results_vector = eval_pointwise(p, {{"x", xa}, {"y", ya}, {"b", ba}});
+
+    auto xv = xa.get<float>();
+    auto yv = ya.get<float>();
+    auto bv = ba.get<float>();
+    std::vector<float> gold(s.elements());
+    for(std::size_t i = 0; i < 50; i++)
+    {
+        for(std::size_t j = 0; j < 40; j++)
+            gold[i * 40 + j] = (xv[j * 50 + i] + bv[i]) * yv[j * 50 + i];
+    }
+    EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
+}
+
+TEST_CASE(pointwise_slice_test)
+{
+    // Sliced and broadcasted views are read with their strides, over the rows of several blocks,
+    // and the output is written in its transposed layout
+    migraphx::program p;
+    auto* pm = p.create_module("pointwise");
+    auto x1  = pm->add_parameter("x1", {migraphx::shape::float_type});
+    auto x2  = pm->add_parameter("x2", {migraphx::shape::float_type});
+    auto x3  = pm->add_parameter("x3", {migraphx::shape::float_type});
+    auto add = pm->add_instruction(migraphx::make_op("add"), x1, x2);
+    pm->add_instruction(migraphx::make_op("mul"), add, x3);
+
+    migraphx::shape s{migraphx::shape::float_type, {2, 30, 300}};
+    migraphx::shape slice_shape{migraphx::shape::float_type, {2, 30, 100}, {9000, 300, 1}};
+    migraphx::shape bcast_shape{migraphx::shape::float_type, {2, 30, 100}, {9000, 0, 1}};
+    migraphx::shape output_shape{migraphx::shape::float_type, {2, 30, 100}, {3000, 1, 30}};
+    auto xa = migraphx::generate_argument(s, 0);
+    auto* x = reinterpret_cast<float*>(xa.data());
+    std::vector<migraphx::argument> args = {{slice_shape, x},
+                                            {slice_shape, x + 100},
+                                            {bcast_shape, x + 10 * 300 + 200}};
+    auto executor = migraphx::pointwise_executor::translate(*pm);
+    auto result   = executor.execute(output_shape, args);
+    EXPECT(result.get_shape() == output_shape);
+
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    std::vector<float> gold(output_shape.elements());
+    for(std::size_t i = 0; i < 2; i++)
+    {
+        for(std::size_t j = 0; j < 30; j++)
+        {
+            for(std::size_t k = 0; k < 100; k++)
+            {
+                auto base = i * 9000 + j * 300;
+                gold[i * 3000 + j * 100 + k] =
+                    (x[base + k] + x[base + 100 + k]) * x[i * 9000 + 10 * 300 + 200 + k];
+            }
+        }
+    }
+    EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
+}
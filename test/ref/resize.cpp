@@ -342,6 +342,134 @@ TEST_CASE(resize_upsample_test_4_1_input)
     EXPECT(migraphx::verify::verify_rms_range(res_data, golden));
 }
 
+TEST_CASE(resize_linear_test)
+{
+    // resize 3x4 to 5x3: upsample one axis and downsample the other
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+
+    std::vector<float> data(3 * 4);
+    std::iota(data.begin(), data.end(), 0.5);
+    migraphx::shape s{migraphx::shape::float_type, {1, 1, 3, 4}};
+    auto a0 = mm->add_literal(migraphx::literal{s, data});
+
+    mm->add_instruction(
+        migraphx::make_op("resize",
+                          {{"sizes", {1, 1, 5, 3}},
+                           {"mode", "linear"},
+                           {"coordinate_transformation_mode", "half_pixel"}}),
+        a0);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+
+    std::vector<float> res_data(1 * 1 * 5 * 3);
+    // clang-format off
+    std::vector<float> golden = {
+        0.666667f, 2.0f,  3.333333f,
+        2.266667f, 3.6f,  4.933333f,
+        4.666667f, 6.0f,  7.333333f,
+        7.066667f, 8.4f,  9.733333f,
+        8.666667f, 10.0f, 11.333333f};
+    // clang-format on
+    result.visit([&](auto output) { res_data.assign(output.begin(), output.end()); });
+    EXPECT(migraphx::verify::verify_rms_range(res_data, golden));
+}
+
+TEST_CASE(resize_linear_align_corners_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+
+    std::vector<float> data(2 * 3);
+    std::iota(data.begin(), data.end(), 1);
+    migraphx::shape s{migraphx::shape::float_type, {1, 1, 2, 3}};
+    auto a0 = mm->add_literal(migraphx::literal{s, data});
+    migraphx::shape scale_input{migraphx::shape::float_type, {4}};
+    auto a1 = mm->add_literal(migraphx::literal{scale_input, {1, 1, 2, 2}});
+
+    mm->add_instruction(migraphx::make_op("resize",
+                                          {{"mode", "linear"},
+                                           {"coordinate_transformation_mode", "align_corners"}}),
+                        a0,
+                        a1);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+
+    std::vector<float> res_data(1 * 1 * 4 * 6);
+    // clang-format off
+    std::vector<float> golden = {
+        1.0f, 1.4f, 1.8f, 2.2f, 2.6f, 3.0f,
+        2.0f, 2.4f, 2.8f, 3.2f, 3.6f, 4.0f,
+        3.0f, 3.4f, 3.8f, 4.2f, 4.6f, 5.0f,
+        4.0f, 4.4f, 4.8f, 5.2f, 5.6f, 6.0f};
+    // clang-format on
+    result.visit([&](auto output) { res_data.assign(output.begin(), output.end()); });
+    EXPECT(migraphx::verify::verify_rms_range(res_data, golden));
+}
+
+TEST_CASE(resize_cubic_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+
+    std::vector<float> data(3 * 3);
+    std::iota(data.begin(), data.end(), 1);
+    migraphx::shape s{migraphx::shape::float_type, {1, 1, 3, 3}};
+    auto a0 = mm->add_literal(migraphx::literal{s, data});
+
+    mm->add_instruction(
+        migraphx::make_op("resize",
+                          {{"scales", {1.0, 1.0, 1.5, 1.5}},
+                           {"mode", "cubic"},
+                           {"coordinate_transformation_mode", "asymmetric"}}),
+        a0);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+
+    std::vector<float> res_data(1 * 1 * 4 * 4);
+    // clang-format off
+    std::vector<float> golden = {
+        1.0f,      1.574074f, 2.425926f, 3.0f,
+        2.722222f, 3.296296f, 4.148148f, 4.722222f,
+        5.277778f, 5.851852f, 6.703704f, 7.277778f,
+        7.0f,      7.574074f, 8.425926f, 9.0f};
+    // clang-format on
+    result.visit([&](auto output) { res_data.assign(output.begin(), output.end()); });
+    EXPECT(migraphx::verify::verify_rms_range(res_data, golden));
+}
+
+TEST_CASE(resize_cubic_exclude_outside_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+
+    std::vector<float> data(4 * 4);
+    std::iota(data.begin(), data.end(), 1);
+    migraphx::shape s{migraphx::shape::float_type, {1, 1, 4, 4}};
+    auto a0 = mm->add_literal(migraphx::literal{s, data});
+
+    mm->add_instruction(
+        migraphx::make_op("resize",
+                          {{"sizes", {1, 1, 3, 3}},
+                           {"mode", "cubic"},
+                           {"cubic_coeff_a", -0.5},
+                           {"exclude_outside", true},
+                           {"coordinate_transformation_mode", "half_pixel"}}),
+        a0);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+
+    std::vector<float> res_data(1 * 1 * 3 * 3);
+    // clang-format off
+    std::vector<float> golden = {
+        1.514223f,  2.911379f,  4.308534f,
+        7.102845f,  8.5f,       9.897155f,
+        12.691466f, 14.088621f, 15.485777f};
+    // clang-format on
+    result.visit([&](auto output) { res_data.assign(output.begin(), output.end()); });
+    EXPECT(migraphx::verify::verify_rms_range(res_data, golden));
+}
+
 TEST_CASE(resize_fail_test_1)
 {
     // invalid resize mode
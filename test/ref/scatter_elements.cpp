@@ -375,3 +375,37 @@ TEST_CASE(scatter_elements_max_axis_0_3x3_duplicate_index_test)
 
     EXPECT(migraphx::verify::verify_rms_range(results, gold));
 }
+
+TEST_CASE(scatter_elements_add_duplicate_lines_test)
+{
+    // duplicates along the axis within every line, and negative indices
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape sd{migraphx::shape::float_type, {4, 5}};
+    migraphx::shape si{migraphx::shape::int32_type, {6, 3}};
+    migraphx::shape su{migraphx::shape::float_type, {6, 3}};
+    std::vector<float> vd(sd.elements(), 1);
+    std::vector<int> vi{0, 3, -1, 2, 3, 1, 0, 0, 3, -4, 1, 2, 3, 3, 3, 1, 0, 2};
+    std::vector<float> vu(su.elements());
+    std::iota(vu.begin(), vu.end(), 1);
+
+    auto ld = mm->add_literal(migraphx::literal{sd, vd});
+    auto li = mm->add_literal(migraphx::literal{si, vi});
+    auto lu = mm->add_literal(migraphx::literal{su, vu});
+    mm->add_instruction(migraphx::make_op("scatter_add", {{"axis", 0}}), ld, li, lu);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+
+    auto gold = vd;
+    for(std::size_t i = 0; i < 6; ++i)
+    {
+        for(std::size_t j = 0; j < 3; ++j)
+        {
+            auto row = (vi[i * 3 + j] < 0) ? vi[i * 3 + j] + 4 : vi[i * 3 + j];
+            gold[row * 5 + j] += vu[i * 3 + j];
+        }
+    }
+    EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
+}
@@ -104,3 +104,36 @@ TEST_CASE(scatternd_reduction_dyn_test)
                             8, 7, 6, 5, 4,  3,  2,  1,  1,  2,  3,  4,  5,  6,  7,  8};
     EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
 }
+
+TEST_CASE(scatternd_add_duplicate_slices_test)
+{
+    // many updates land on the same rows; they must all be accumulated
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape ds{migraphx::shape::float_type, {6, 4}};
+    migraphx::shape is{migraphx::shape::int64_type, {10, 1}};
+    migraphx::shape us{migraphx::shape::float_type, {10, 4}};
+
+    std::vector<float> data_vec(ds.elements(), 1);
+    std::vector<int64_t> ind_vec{0, 5, 2, 0, -1, 2, 2, 3, 0, 1};
+    std::vector<float> upd_vec(us.elements());
+    std::iota(upd_vec.begin(), upd_vec.end(), 0);
+
+    auto data    = mm->add_literal(migraphx::literal{ds, data_vec});
+    auto indices = mm->add_literal(migraphx::literal{is, ind_vec});
+    auto updates = mm->add_literal(migraphx::literal{us, upd_vec});
+    mm->add_instruction(migraphx::make_op("scatternd_add"), data, indices, updates);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+
+    auto gold = data_vec;
+    for(std::size_t u = 0; u < ind_vec.size(); ++u)
+    {
+        auto row = (ind_vec[u] < 0) ? ind_vec[u] + 6 : ind_vec[u];
+        for(std::size_t e = 0; e < 4; ++e)
+            gold[row * 4 + e] += upd_vec[u * 4 + e];
+    }
+    EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
+}
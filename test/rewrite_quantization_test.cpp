@@ -120,4 +120,26 @@ TEST_CASE(dequantizelinear)
     EXPECT(none_of(*p2.get_main_module(), &is_dequantizelinear));
 }
 
+TEST_CASE(skip_types)
+{
+    migraphx::shape xs{migraphx::shape::float_type, {1, 3, 3}};
+    migraphx::shape ss{migraphx::shape::float_type, {1, 3, 3}};
+    migraphx::shape zs{migraphx::shape::uint8_type, {1, 3, 3}};
+    migraphx::shape z8s{migraphx::shape::int8_type, {1, 3, 3}};
+    migraphx::module m;
+    auto x  = m.add_parameter("x", xs);
+    auto s  = m.add_literal(migraphx::generate_literal(ss));
+    auto z  = m.add_literal(migraphx::literal{zs, std::vector<uint8_t>(9, 1)});
+    auto z8 = m.add_literal(migraphx::literal{z8s, std::vector<int8_t>(9, 1)});
+    auto q  = m.add_instruction(migraphx::make_op("quantizelinear"), x, s, z);
+    auto dq = m.add_instruction(migraphx::make_op("dequantizelinear"), q, s, z);
+    auto q8 = m.add_instruction(migraphx::make_op("quantizelinear"), dq, s, z8);
+    m.add_return({q8});
+
+    migraphx::run_passes(m, {migraphx::rewrite_quantization{{migraphx::shape::uint8_type}}});
+    EXPECT(std::count_if(m.begin(), m.end(), &is_quantizelinear) == 1);
+    EXPECT(std::count_if(m.begin(), m.end(), &is_dequantizelinear) == 1);
+    EXPECT(m.get_output_shapes().front().type() == migraphx::shape::int8_type);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,125 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/rewrite_resize.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/verify.hpp>
+#include <test.hpp>
+
+static void opt_resize(migraphx::module& m)
+{
+    migraphx::rewrite_resize rr;
+    migraphx::dead_code_elimination dce;
+    rr.apply(m);
+    dce.apply(m);
+}
+
+static std::vector<float> run(const migraphx::program& prog, const migraphx::argument& x)
+{
+    auto p = prog;
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({{"x", x}}).back();
+    std::vector<float> data;
+    result.visit([&](auto output) { data.assign(output.begin(), output.end()); });
+    return data;
+}
+
+static void test_rewrite(const migraphx::shape& s, const migraphx::value& attrs)
+{
+    migraphx::program p1;
+    auto* mm = p1.get_main_module();
+    auto x   = mm->add_parameter("x", s);
+    mm->add_return({mm->add_instruction(migraphx::make_op("resize", attrs), x)});
+
+    migraphx::program p2 = p1;
+    opt_resize(*p2.get_main_module());
+    EXPECT(none_of(*p2.get_main_module(), [](const auto& ins) { return ins.name() == "resize"; }));
+
+    auto arg = migraphx::generate_argument(s);
+    EXPECT(migraphx::verify::verify_rms_range(run(p2, arg), run(p1, arg)));
+}
+
+TEST_CASE(rewrite_resize_linear)
+{
+    test_rewrite({migraphx::shape::float_type, {1, 2, 3, 4}},
+                 {{"mode", "linear"},
+                  {"coordinate_transformation_mode", "half_pixel"},
+                  {"scales", {1.0, 1.0, 2.0, 0.5}}});
+}
+
+TEST_CASE(rewrite_resize_cubic)
+{
+    test_rewrite({migraphx::shape::float_type, {1, 1, 4, 5}},
+                 {{"mode", "cubic"},
+                  {"coordinate_transformation_mode", "asymmetric"},
+                  {"exclude_outside", true},
+                  {"sizes", {1, 1, 6, 3}}});
+}
+
+TEST_CASE(rewrite_resize_linear_int8)
+{
+    migraphx::shape s{migraphx::shape::int8_type, {1, 1, 3, 4}};
+    migraphx::program p1;
+    auto* mm = p1.get_main_module();
+    auto x   = mm->add_parameter("x", s);
+    mm->add_return({mm->add_instruction(
+        migraphx::make_op("resize",
+                          {{"mode", "linear"},
+                           {"coordinate_transformation_mode", "half_pixel"},
+                           {"scales", {1.0, 1.0, 2.0, 1.5}}}),
+        x)});
+
+    migraphx::program p2 = p1;
+    opt_resize(*p2.get_main_module());
+    EXPECT(none_of(*p2.get_main_module(), [](const auto& ins) { return ins.name() == "resize"; }));
+
+    // The weights are fractions, so they would all truncate to 0 in int8
+    std::vector<int8_t> data = {10, 20, 30, 40, -10, -20, -30, -40, 5, 15, 25, 35};
+    migraphx::argument arg{s, data.data()};
+    auto result = run(p2, arg);
+    EXPECT(result == run(p1, arg));
+    EXPECT(std::any_of(result.begin(), result.end(), [](auto v) { return v != 0; }));
+}
+
+TEST_CASE(rewrite_resize_nearest)
+{
+    migraphx::module m1;
+    auto x = m1.add_parameter("x", {migraphx::shape::float_type, {1, 1, 2, 2}});
+    m1.add_return({m1.add_instruction(
+        migraphx::make_op("resize",
+                          {{"nearest_mode", "floor"},
+                           {"coordinate_transformation_mode", "asymmetric"},
+                           {"scales", {1.0, 1.0, 2.0, 2.0}}}),
+        x)});
+    migraphx::module m2 = m1;
+    opt_resize(m1);
+    EXPECT(m1 == m2);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -415,6 +415,20 @@ TEST_CASE(conv_relu_test)
     EXPECT(p == prog);
 }
 
+TEST_CASE(conv_relu_layout_test)
+{
+    // The activations stay in NCHW between the ops, so no transposes are added even without
+    // simplify_reshapes
+    migraphx::program p = create_conv();
+    auto* mm            = p.get_main_module();
+    auto l0             = std::prev(mm->end());
+    auto relu           = mm->add_instruction(migraphx::make_op("relu"), l0);
+    mm->add_return({relu});
+    auto prog = parse_tf("conv_relu_test.pb", true);
+
+    EXPECT(p == prog);
+}
+
 TEST_CASE(conv_relu6_test)
 {
     migraphx::program p = create_conv();
@@ -0,0 +1,105 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/tuning_db.hpp>
+#include <migraphx/tmp_dir.hpp>
+
+#include <test.hpp>
+
+TEST_CASE(missing)
+{
+    migraphx::tmp_dir td{"tuning_db"};
+    auto db = migraphx::tuning_db::open(td.path / "tuning.db");
+    EXPECT(not db.get("dnnl::convolution", {{"lens", {1, 2}}}).has_value());
+}
+
+TEST_CASE(insert_get)
+{
+    migraphx::tmp_dir td{"tuning_db"};
+    auto db = migraphx::tuning_db::open(td.path / "tuning.db");
+    migraphx::value problem  = {{"lens", {1, 2}}};
+    migraphx::value solution = {{"algo", "convolution_direct"}};
+    db.insert("dnnl::convolution", problem, solution);
+    auto s = db.get("dnnl::convolution", problem);
+    EXPECT(s.has_value());
+    EXPECT(*s == solution);
+    EXPECT(not db.get("dnnl::dot", problem).has_value());
+    EXPECT(not db.get("dnnl::convolution", {{"lens", {2, 1}}}).has_value());
+}
+
+TEST_CASE(replace)
+{
+    migraphx::tmp_dir td{"tuning_db"};
+    auto db = migraphx::tuning_db::open(td.path / "tuning.db");
+    migraphx::value problem = {{"lens", {4}}};
+    db.insert("cpu::add", problem, {{"min_grain", 256}});
+    db.insert("cpu::add", problem, {{"min_grain", 4096}});
+    auto s = db.get("cpu::add", problem);
+    EXPECT(s.has_value());
+    EXPECT(s->at("min_grain").to<std::size_t>() == 4096);
+}
+
+TEST_CASE(quotes)
+{
+    migraphx::tmp_dir td{"tuning_db"};
+    auto db = migraphx::tuning_db::open(td.path / "tuning.db");
+    migraphx::value problem  = {{"name", "it's"}};
+    migraphx::value solution = {{"value", "'); DROP TABLE tuning; --"}};
+    db.insert("op'", problem, solution);
+    auto s = db.get("op'", problem);
+    EXPECT(s.has_value());
+    EXPECT(*s == solution);
+}
+
+TEST_CASE(reopen)
+{
+    migraphx::tmp_dir td{"tuning_db"};
+    migraphx::value problem  = {{"lens", {3, 3}}};
+    migraphx::value solution = {{"algo", "convolution_winograd"}, {"packed_weights", true}};
+    {
+        auto db = migraphx::tuning_db::open(td.path / "tuning.db");
+        db.insert("dnnl::convolution", problem, solution);
+    }
+    auto db = migraphx::tuning_db::open(td.path / "tuning.db");
+    auto s  = db.get("dnnl::convolution", problem);
+    EXPECT(s.has_value());
+    EXPECT(*s == solution);
+}
+
+TEST_CASE(read_only)
+{
+    migraphx::tmp_dir td{"tuning_db"};
+    migraphx::value problem  = {{"lens", {8}}};
+    {
+        auto db = migraphx::tuning_db::open(td.path / "tuning.db");
+        db.insert("cpu::add", problem, {{"min_grain", 1024}});
+    }
+    auto db = migraphx::tuning_db::read(td.path / "tuning.db");
+    auto s  = db.get("cpu::add", problem);
+    EXPECT(s.has_value());
+    EXPECT(s->at("min_grain").to<std::size_t>() == 1024);
+    EXPECT(test::throws([&] { db.insert("cpu::add", problem, {{"min_grain", 64}}); }));
+    EXPECT(test::throws([&] { migraphx::tuning_db::read(td.path / "missing.db"); }));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,323 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "../verify_program.hpp"
+#include <migraphx/file_buffer.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/json.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/time.hpp>
+#include <test.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+
+using milliseconds = std::chrono::duration<double, std::milli>;
+
+struct bench_options
+{
+    std::vector<std::string> targets = {"ref", "cpu"};
+    std::size_t scale                = 1;
+    std::size_t warmup               = 2;
+    std::size_t iterations           = 10;
+    bool compile                     = false;
+    std::string output               = "";
+    std::string baseline             = "";
+    double threshold                 = 0.1;
+};
+
+static void show_help(const std::string& exe)
+{
+    std::cout << "USAGE:" << std::endl;
+    std::cout << "    " << exe << " <test-case>... <options>" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Times the verify programs and prints the results as JSON. A test case can be a "
+                 "section, an exact name or a glob, and all the programs are run when none are "
+                 "given."
+              << std::endl;
+    std::cout << std::endl;
+    std::cout << "OPTIONS:" << std::endl;
+    std::cout << "    --targets <name>...   Targets to time (default: ref cpu)" << std::endl;
+    std::cout << "    --scale <n>           Multiply the first dimension of the parameters by n"
+              << std::endl;
+    std::cout << "    --warmup <n>          Untimed runs before timing (default: 2)" << std::endl;
+    std::cout << "    --iterations <n>      Timed runs (default: 10)" << std::endl;
+    std::cout << "    --compile             Time the compilation instead of the evaluation"
+              << std::endl;
+    std::cout << "    --output <file>       Write the JSON to a file instead of stdout"
+              << std::endl;
+    std::cout << "    --baseline <file>     Report the cases that are slower than in this JSON"
+              << std::endl;
+    std::cout << "    --threshold <x>       Relative slowdown reported as a regression "
+                 "(default: 0.1)"
+              << std::endl;
+}
+
+// Multiply the first dimension of the parameters by scale and recompute the shapes of the
+// instructions. This throws when an op doesn't accept the scaled shapes, such as a reshape to
+// fixed dimensions or a binary op with a literal.
+static void scale_program(migraphx::program& p, std::size_t scale)
+{
+    if(scale == 1)
+        return;
+    auto* mm = p.get_main_module();
+    std::vector<migraphx::instruction_ref> params;
+    for(auto ins : iterator_for(*mm))
+    {
+        if(ins->name() == "@param")
+            params.push_back(ins);
+    }
+    for(auto ins : params)
+    {
+        auto s = ins->get_shape();
+        if(s.dynamic() or s.scalar() or s.lens().empty())
+            continue;
+        auto lens = s.lens();
+        lens.front() *= scale;
+        auto name = ins->get_operator().to_value()["parameter"].to<std::string>();
+        auto x    = mm->insert_parameter(ins, name + ":scaled", migraphx::shape{s.type(), lens});
+        mm->replace_instruction(ins, x);
+        mm->remove_instruction(ins);
+        mm->rename_parameter(x, name);
+    }
+}
+
+static migraphx::parameter_map create_parameters(const migraphx::program& p,
+                                                 const migraphx::target& t)
+{
+    migraphx::parameter_map m;
+    for(auto&& x : p.get_parameter_shapes())
+    {
+        auto s = x.second;
+        if(s.dynamic())
+            s = migraphx::shape{s.type(), s.max_lens()};
+        m[x.first] = t.copy_to(migraphx::generate_argument(s, std::hash<std::string>{}(x.first)));
+    }
+    return m;
+}
+
+template <class F>
+static std::vector<double> time_runs(const bench_options& opts, F f)
+{
+    for(auto i : migraphx::range(opts.warmup))
+    {
+        (void)i;
+        f();
+    }
+    std::vector<double> times;
+    for(auto i : migraphx::range(opts.iterations))
+    {
+        (void)i;
+        times.push_back(migraphx::time<milliseconds>(f));
+    }
+    return times;
+}
+
+static migraphx::value
+bench_program(const program_info& pi, const std::string& tname, const bench_options& opts)
+{
+    migraphx::value result = {{"name", pi.name},
+                              {"section", pi.section},
+                              {"target", tname},
+                              {"mode", opts.compile ? "compile" : "eval"},
+                              {"scale", opts.scale}};
+    try
+    {
+        auto t = migraphx::make_target(tname);
+        std::vector<double> times;
+        if(opts.compile)
+        {
+            auto p = pi.get_program();
+            scale_program(p, opts.scale);
+            times = time_runs(opts, [&] {
+                auto cp = p;
+                cp.compile(t, pi.compile_options);
+            });
+        }
+        else
+        {
+            auto p = pi.get_program();
+            scale_program(p, opts.scale);
+            result["compile_ms"] =
+                migraphx::time<milliseconds>([&] { p.compile(t, pi.compile_options); });
+            auto m = create_parameters(p, t);
+            times  = time_runs(opts, [&] {
+                p.eval(m);
+                p.finish();
+            });
+        }
+        if(times.empty())
+            return result;
+        std::sort(times.begin(), times.end());
+        result["min_ms"]    = times.front();
+        result["median_ms"] = times[times.size() / 2];
+        result["mean_ms"]   = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+    }
+    catch(const std::exception& e)
+    {
+        result["error"] = std::string{e.what()};
+    }
+    return result;
+}
+
+static std::vector<program_info> select_programs(const std::vector<std::string>& cases)
+{
+    const auto& programs = get_programs();
+    if(cases.empty())
+        return programs;
+    std::vector<program_info> result;
+    std::copy_if(programs.begin(),
+                 programs.end(),
+                 std::back_inserter(result),
+                 [&](const program_info& pi) {
+                     return std::any_of(cases.begin(), cases.end(), [&](const std::string& c) {
+                         return pi.section == c or test::glob_match(pi.name.begin(),
+                                                                    pi.name.end(),
+                                                                    c.begin(),
+                                                                    c.end());
+                     });
+                 });
+    return result;
+}
+
+static std::string get_key(const migraphx::value& r)
+{
+    return r.at("name").to<std::string>() + "@" + r.at("target").to<std::string>() + ":" +
+           r.at("mode").to<std::string>() + ":" + std::to_string(r.at("scale").to<std::size_t>());
+}
+
+// Print the cases whose median time increased by more than the threshold over the baseline,
+// and return how many there are
+static std::size_t report_regressions(const migraphx::value& results, const bench_options& opts)
+{
+    auto baseline = migraphx::from_json_string(migraphx::read_string(opts.baseline));
+    std::unordered_map<std::string, double> base_times;
+    for(const auto& r : baseline)
+    {
+        if(r.contains("median_ms"))
+            base_times[get_key(r)] = r.at("median_ms").to<double>();
+    }
+    std::size_t regressions = 0;
+    for(const auto& r : results)
+    {
+        if(not r.contains("median_ms"))
+            continue;
+        auto it = base_times.find(get_key(r));
+        if(it == base_times.end() or it->second <= 0)
+            continue;
+        auto t     = r.at("median_ms").to<double>();
+        auto ratio = t / it->second - 1.0;
+        if(ratio <= opts.threshold)
+            continue;
+        regressions++;
+        std::cerr << "REGRESSION: " << r.at("name").to<std::string>() << " on "
+                  << r.at("target").to<std::string>() << ": " << it->second << "ms -> " << t
+                  << "ms (+" << ratio * 100 << "%)" << std::endl;
+    }
+    return regressions;
+}
+
+int main(int argc, const char* argv[])
+{
+    std::vector<std::string> args(argv + 1, argv + argc);
+    std::vector<std::string> flags = {"--targets",
+                                      "--scale",
+                                      "--warmup",
+                                      "--iterations",
+                                      "--compile",
+                                      "--output",
+                                      "--baseline",
+                                      "--threshold",
+                                      "--help"};
+    auto parsed = test::generic_parse(args, [&](const std::string& s) -> std::vector<std::string> {
+        if(migraphx::contains(flags, s))
+            return {s};
+        return {};
+    });
+    if(parsed.count("--help") > 0)
+    {
+        show_help(argv[0]);
+        return 0;
+    }
+    auto get_arg = [&](const std::string& flag, const std::string& x) {
+        if(parsed.count(flag) == 0 or parsed.at(flag).empty())
+            return x;
+        return parsed.at(flag).back();
+    };
+    bench_options opts;
+    if(parsed.count("--targets") > 0)
+        opts.targets = parsed.at("--targets");
+    opts.scale      = std::stoul(get_arg("--scale", std::to_string(opts.scale)));
+    opts.warmup     = std::stoul(get_arg("--warmup", std::to_string(opts.warmup)));
+    opts.iterations = std::stoul(get_arg("--iterations", std::to_string(opts.iterations)));
+    opts.compile    = parsed.count("--compile") > 0;
+    opts.output     = get_arg("--output", opts.output);
+    opts.baseline   = get_arg("--baseline", opts.baseline);
+    opts.threshold  = std::stod(get_arg("--threshold", std::to_string(opts.threshold)));
+
+    auto registered = migraphx::get_targets();
+    std::vector<std::string> targets;
+    std::copy_if(opts.targets.begin(),
+                 opts.targets.end(),
+                 std::back_inserter(targets),
+                 [&](const std::string& name) {
+                     if(migraphx::contains(registered, name))
+                         return true;
+                     std::cerr << "Skipping target " << name << ": not available" << std::endl;
+                     return false;
+                 });
+
+    auto programs = select_programs(parsed[""]);
+    std::sort(programs.begin(), programs.end(), [](const auto& x, const auto& y) {
+        return x.name < y.name;
+    });
+    migraphx::value results = migraphx::value::array{};
+    for(const auto& pi : programs)
+    {
+        for(const auto& tname : targets)
+        {
+            std::cerr << "[ BENCH ] " << pi.name << " on " << tname << std::endl;
+            results.push_back(bench_program(pi, tname, opts));
+        }
+    }
+
+    auto json = migraphx::to_pretty_json_string(results, 2);
+    if(opts.output.empty())
+    {
+        std::cout << json << std::endl;
+    }
+    else
+    {
+        std::ofstream os(opts.output);
+        os << json << std::endl;
+    }
+
+    if(not opts.baseline.empty() and report_regressions(results, opts) > 0)
+        return 1;
+    return 0;
+}
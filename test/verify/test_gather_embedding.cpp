@@ -0,0 +1,52 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/make_op.hpp>
+
+// Embedding lookup of a batch of tokens, for several table sizes. Time with
+// `bench_verify 'test_gather_embedding*'`.
+template <std::size_t Vocab, std::size_t Hidden, std::size_t Tokens>
+struct test_gather_embedding : verify_program<test_gather_embedding<Vocab, Hidden, Tokens>>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape s{migraphx::shape::float_type, {Vocab, Hidden}};
+        migraphx::shape s_indices{migraphx::shape::int64_type, {1, Tokens}};
+        std::vector<int64_t> indices(Tokens);
+        for(std::size_t i = 0; i < Tokens; ++i)
+            indices[i] = (i * 7919) % Vocab;
+        auto table = mm->add_parameter("table", s);
+        auto ids   = mm->add_literal(migraphx::literal{s_indices, indices});
+        mm->add_instruction(migraphx::make_op("gather", {{"axis", 0}}), table, ids);
+        return p;
+    }
+};
+
+template struct test_gather_embedding<1024, 64, 32>;
+template struct test_gather_embedding<8192, 256, 128>;
+template struct test_gather_embedding<32000, 256, 512>;
@@ -0,0 +1,52 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+// Q/K/V style projections with separate inputs and weights, which can be batched into one dot
+struct test_gemm_independent : verify_program<test_gemm_independent>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape xs{migraphx::shape::float_type, {1, 16, 32}};
+        migraphx::shape ws{migraphx::shape::float_type, {32, 32}};
+        std::vector<migraphx::instruction_ref> outputs;
+        for(std::size_t i = 0; i < 3; i++)
+        {
+            auto x  = mm->add_parameter("x" + std::to_string(i), xs);
+            auto w  = mm->add_literal(migraphx::generate_literal(ws, i));
+            auto wb = mm->add_instruction(
+                migraphx::make_op("multibroadcast", {{"out_lens", {1, 32, 32}}}), w);
+            outputs.push_back(mm->add_instruction(migraphx::make_op("dot"), x, wb));
+        }
+        mm->add_return(outputs);
+        return p;
+    }
+    std::string section() const { return "gemm"; }
+};
@@ -32,6 +32,7 @@
 #include <migraphx/instruction_ref.hpp>
 #include <migraphx/register_target.hpp>
 #include <migraphx/generate.hpp>
+#include <migraphx/host_allocator.hpp>
 #include <migraphx/quantization.hpp>
 #include <migraphx/load_save.hpp>
 #include <migraphx/make_op.hpp>
@@ -255,6 +256,22 @@ void quantize_int8_wrap(program& prog, const target& t, quantize_int8_options& o
     migraphx::quantize_int8(prog, t, options.calibration, options.op_names);
 }
 
+program compile_onnx_wrap(const char* name,
+                          const target& t,
+                          const compile_options& coptions,
+                          const onnx_options& options,
+                          const char* cache_dir,
+                          size_t cache_max_size)
+{
+    auto cache = program_cache::from_env();
+    if(cache_dir != nullptr)
+    {
+        cache.dir      = cache_dir;
+        cache.max_size = cache_max_size;
+    }
+    return migraphx::compile_onnx(name, t, coptions, options, cache);
+}
+
 #ifdef __clang__
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wformat-nonliteral"
@@ -364,4 +381,43 @@ migraphx::context get_context(const program& p) { return p.get_context(); }
 
 } // namespace migraphx
 
+extern "C" migraphx_status migraphx_set_host_allocator(void* ctx,
+                                                       migraphx_host_allocate allocate,
+                                                       migraphx_host_deallocate deallocate)
+{
+    return migraphx::try_([&] {
+        if(allocate == nullptr and deallocate == nullptr)
+        {
+            migraphx::reset_host_allocator();
+            return;
+        }
+        if(allocate == nullptr or deallocate == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter allocate or deallocate");
+        migraphx::set_host_allocator(
+            {[=](std::size_t bytes) { return static_cast<char*>(allocate(ctx, bytes)); },
+             [=](char* p, std::size_t bytes) { deallocate(ctx, p, bytes); }});
+    });
+}
+
+extern "C" migraphx_status
+migraphx_get_host_allocation_stats(migraphx_host_allocation_stats* stats)
+{
+    return migraphx::try_([&] {
+        if(stats == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter stats: Null pointer");
+        auto s                    = migraphx::get_host_allocation_stats();
+        stats->allocations        = s.allocations;
+        stats->reused             = s.reused;
+        stats->system_allocations = s.system_allocations;
+        stats->bytes_in_use       = s.bytes_in_use;
+        stats->peak_bytes_in_use  = s.peak_bytes_in_use;
+        stats->bytes_cached       = s.bytes_cached;
+    });
+}
+
+extern "C" migraphx_status migraphx_release_host_buffers()
+{
+    return migraphx::try_([] { migraphx::release_host_buffers(); });
+}
+
 <% generate_c_api_body() %>
@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+
+#####################################################################################
+# The MIT License (MIT)
+#
+# Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#####################################################################################
+import argparse
+import threading
+import time
+import numpy as np
+import migraphx
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=
+        "Measure the throughput of program.run from several python threads")
+    parser.add_argument('model', type=str, help='onnx file to run')
+    parser.add_argument('--target',
+                        type=str,
+                        default='cpu',
+                        help='target to compile the model for')
+    parser.add_argument('--threads',
+                        type=int,
+                        default=4,
+                        help='number of python threads calling run')
+    parser.add_argument('--iterations',
+                        type=int,
+                        default=100,
+                        help='number of runs in each thread')
+    parser.add_argument('--batch',
+                        type=int,
+                        default=1,
+                        help='batch size of the model')
+    parser.add_argument('--preallocate',
+                        action='store_true',
+                        help='pass preallocated numpy arrays as the outputs')
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    # The contexts of the targets are not shared between threads, so each thread
+    # runs its own compiled copy of the model
+    programs = []
+    for i in range(args.threads):
+        p = migraphx.parse_onnx(args.model, default_dim_value=args.batch)
+        p.compile(migraphx.get_target(args.target))
+        programs.append(p)
+
+    def run(i, counts):
+        p = programs[i]
+        params = {
+            name: np.array(migraphx.generate_argument(s, i))
+            for name, s in p.get_parameter_shapes().items()
+        }
+        outputs = None
+        if args.preallocate:
+            outputs = [
+                np.array(migraphx.fill_argument(s, 0))
+                for s in p.get_output_shapes()
+            ]
+        for it in range(args.iterations):
+            p.run(params, outputs=outputs)
+            counts[i] += 1
+
+    counts = [0] * args.threads
+    threads = [
+        threading.Thread(target=run, args=(i, counts))
+        for i in range(args.threads)
+    ]
+    start = time.perf_counter()
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    elapsed = time.perf_counter() - start
+    runs = sum(counts)
+    print("Threads: {}".format(args.threads))
+    print("Runs: {}".format(runs))
+    print("Total time: {:.3f}s".format(elapsed))
+    print("Throughput: {:.2f} runs/s".format(runs / elapsed))
+    print("Latency: {:.3f}ms".format(1000 * elapsed * args.threads / runs))
+
+
+if __name__ == "__main__":
+    main()